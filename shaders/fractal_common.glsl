@@ -0,0 +1,331 @@
+/**
+ * @file fractal_common.glsl
+ * @brief Shared parameters, iteration and coloring code for fractal shaders
+ *
+ * Included by every fractal compute shader so the pixel mapping, escape-time
+ * iteration and color palette stay identical across passes. Requires
+ * GL_GOOGLE_include_directive; ShaderManager resolves includes against the
+ * shaders directory.
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#ifndef FRACTAL_COMMON_GLSL
+#define FRACTAL_COMMON_GLSL
+
+// Fractal parameters, pushed with every dispatch (52 of the guaranteed 128
+// push constant bytes)
+layout(push_constant) uniform FractalParameters {
+  float centerX;      // Center X coordinate in fractal space
+  float centerY;      // Center Y coordinate in fractal space
+  float zoom;         // Zoom level (higher = more zoomed in)
+  uint maxIterations; // Maximum iterations for convergence test
+  uint imageWidth;    // Output image width in pixels
+  uint imageHeight;   // Output image height in pixels
+  float colorScale;   // Scale factor for color mapping
+  uint fractalType;   // Fractal type (0=Mandelbrot, 1=Julia, 2=Burning Ship)
+  uint orbitMode;     // Orbit state handling (see ORBIT_MODE_*)
+  uint resumeIterations; // maxIterations the stored orbit state was built with
+  uint chunkIterations;  // Iterations per pass in chunked mode (0 = one pass)
+  uint aaMaxSamples;     // Adaptive anti-aliasing sample cap (0 = off)
+  float aaThreshold;     // Neighbour color contrast that triggers AA
+}
+params;
+
+/**
+ * Per-pixel orbit state from the previous dispatch.
+ *
+ * iterations < resumeIterations: the pixel escaped at that iteration
+ * iterations == resumeIterations: the pixel was still bounded; z holds the
+ *                                 orbit after that many iterations
+ */
+struct OrbitState {
+  vec2 z;          // Orbit value at 'iterations'
+  uint iterations; // Escape iteration, or the iteration budget it reached
+  uint reserved;   // Padding to 16 bytes
+};
+
+/**
+ * @brief Convert HSV color to RGB
+ *
+ * Converts HSV (Hue, Saturation, Value) color space to RGB.
+ * Used for creating smooth color gradients based on iteration count.
+ *
+ * @param h Hue (0.0 - 1.0)
+ * @param s Saturation (0.0 - 1.0)
+ * @param v Value/Brightness (0.0 - 1.0)
+ * @return RGB color as vec3
+ */
+vec3 hsv2rgb(float h, float s, float v) {
+  vec3 c = vec3(h, s, v);
+  vec4 K = vec4(1.0, 2.0 / 3.0, 1.0 / 3.0, 3.0);
+  vec3 p = abs(fract(c.xxx + K.xyz) * 6.0 - K.www);
+  return c.z * mix(K.xxx, clamp(p - K.xxx, 0.0, 1.0), c.y);
+}
+
+/**
+ * @brief Pack RGBA values into a single uint32
+ *
+ * Packs 4 8-bit color components (RGBA) into a single 32-bit unsigned integer.
+ * Format: 0xAABBGGRR (little-endian RGBA)
+ *
+ * @param r Red component (0.0 - 1.0)
+ * @param g Green component (0.0 - 1.0)
+ * @param b Blue component (0.0 - 1.0)
+ * @param a Alpha component (0.0 - 1.0)
+ * @return Packed RGBA value as uint32
+ */
+uint packRGBA(float r, float g, float b, float a) {
+  uint rInt = uint(clamp(r * 255.0, 0.0, 255.0));
+  uint gInt = uint(clamp(g * 255.0, 0.0, 255.0));
+  uint bInt = uint(clamp(b * 255.0, 0.0, 255.0));
+  uint aInt = uint(clamp(a * 255.0, 0.0, 255.0));
+
+  return (aInt << 24) | (bInt << 16) | (gInt << 8) | rInt;
+}
+
+/**
+ * @brief Unpack a 0xAABBGGRR color into RGB components
+ *
+ * @param color Packed RGBA value
+ * @return RGB color (0.0 - 1.0)
+ */
+vec3 unpackRGB(uint color) {
+  return vec3(float(color & 0xFFu), float((color >> 8) & 0xFFu),
+              float((color >> 16) & 0xFFu)) /
+         255.0;
+}
+
+/**
+ * @brief Calculate Mandelbrot set iteration count for a point
+ *
+ * Computes the number of iterations required for the orbit to escape the
+ * Mandelbrot set. Uses the standard escape radius of 2.0.
+ *
+ * The Mandelbrot set is defined as the set of complex numbers c for which
+ * the sequence z_{n+1} = z_n^2 + c (starting with z_0 = 0) remains bounded.
+ *
+ * @param z Orbit value at startIteration; holds the final orbit value on return
+ * @param c The complex number c
+ * @param startIteration Iterations already applied to z
+ * @param endIteration Iteration to stop at if the orbit hasn't escaped
+ * @return Number of iterations before escape (endIteration if none)
+ */
+uint mandelbrotIterations(inout vec2 z, vec2 c, uint startIteration,
+                          uint endIteration) {
+  for (uint i = startIteration; i < endIteration; i++) {
+    // Check if point has escaped (|z| > 2)
+    float zx2 = z.x * z.x;
+    float zy2 = z.y * z.y;
+
+    if (zx2 + zy2 > 4.0) { // 4.0 = 2.0^2 (escape radius squared)
+      return i;
+    }
+
+    // z = z^2 + c
+    float temp = zx2 - zy2 + c.x;
+    z.y = 2.0 * z.x * z.y + c.y;
+    z.x = temp;
+  }
+
+  return endIteration; // Point is still bounded (in the set at maxIterations)
+}
+
+/**
+ * @brief Calculate Julia set iterations for a point
+ *
+ * Julia sets use the same iteration formula as Mandelbrot but with a fixed c
+ * value and z_0 at the pixel, so this simply reuses the Mandelbrot loop.
+ *
+ * @param z Orbit value at startIteration; holds the final orbit value on return
+ * @param c The fixed Julia constant
+ * @param startIteration Iterations already applied to z
+ * @param endIteration Iteration to stop at if the orbit hasn't escaped
+ * @return Number of iterations before escape
+ */
+uint juliaIterations(inout vec2 z, vec2 c, uint startIteration,
+                     uint endIteration) {
+  return mandelbrotIterations(z, c, startIteration, endIteration);
+}
+
+/**
+ * @brief Calculate Burning Ship fractal iterations for a point
+ *
+ * The Burning Ship fractal uses: z = (|Re(z)| + i|Im(z)|)^2 + c
+ *
+ * @param z Orbit value at startIteration; holds the final orbit value on return
+ * @param c The complex number c
+ * @param startIteration Iterations already applied to z
+ * @param endIteration Iteration to stop at if the orbit hasn't escaped
+ * @return Number of iterations before escape
+ */
+uint burningShipIterations(inout vec2 z, vec2 c, uint startIteration,
+                           uint endIteration) {
+  for (uint i = startIteration; i < endIteration; i++) {
+    float zx2 = z.x * z.x;
+    float zy2 = z.y * z.y;
+
+    if (zx2 + zy2 > 4.0) {
+      return i;
+    }
+
+    // Burning Ship: z = (|Re(z)| + i|Im(z)|)^2 + c
+    float temp = zx2 - zy2 + c.x;
+    z.y = 2.0 * abs(z.x) * abs(z.y) + c.y;
+    z.x = temp;
+  }
+
+  return endIteration;
+}
+
+/**
+ * @brief Get the constant c for a pixel
+ *
+ * @param p Pixel position in fractal space
+ * @return c (the pixel itself, or the Julia constant c = -0.7 + 0.27015i)
+ */
+vec2 orbitConstant(vec2 p) {
+  return params.fractalType == 1u ? vec2(-0.7, 0.27015) : p;
+}
+
+/**
+ * @brief Get the starting orbit value z_0 for a pixel
+ *
+ * @param p Pixel position in fractal space
+ * @return z_0 (zero, or the pixel itself for Julia sets)
+ */
+vec2 orbitStart(vec2 p) { return params.fractalType == 1u ? p : vec2(0.0); }
+
+/**
+ * @brief Run escape-time iterations for the selected fractal type
+ *
+ * @param z Orbit value at startIteration; holds the final orbit value on return
+ * @param c Orbit constant from orbitConstant()
+ * @param startIteration Iterations already applied to z
+ * @param endIteration Iteration to stop at if the orbit hasn't escaped
+ * @return Number of iterations before escape (endIteration if none)
+ */
+uint fractalIterations(inout vec2 z, vec2 c, uint startIteration,
+                       uint endIteration) {
+  switch (params.fractalType) {
+  case 0: // Mandelbrot
+    return mandelbrotIterations(z, c, startIteration, endIteration);
+  case 1: // Julia Set
+    return juliaIterations(z, c, startIteration, endIteration);
+  case 2: // Burning Ship
+    return burningShipIterations(z, c, startIteration, endIteration);
+  default:
+    return mandelbrotIterations(z, c, startIteration, endIteration);
+  }
+}
+
+/**
+ * @brief Convert a (possibly fractional) pixel position to fractal space
+ *
+ * Maps [0, width] x [0, height] onto the view centered at (centerX, centerY)
+ * with a base width of 4.0 units, keeping the image aspect ratio.
+ *
+ * @param pixel Pixel position; integer positions are the pixel corners
+ * @return Position in fractal space
+ */
+vec2 pixelToFractal(vec2 pixel) {
+  float aspectRatio = float(params.imageWidth) / float(params.imageHeight);
+
+  // Calculate the size of the visible fractal area
+  float fractalWidth = 4.0 / params.zoom; // Base width of 4.0 units
+  float fractalHeight = fractalWidth / aspectRatio;
+
+  return vec2(params.centerX, params.centerY) +
+         (pixel / vec2(params.imageWidth, params.imageHeight) - 0.5) *
+             vec2(fractalWidth, fractalHeight);
+}
+
+/**
+ * @brief Map iteration count to color
+ *
+ * Creates a smooth color gradient based on the iteration count.
+ * Points in the set (max iterations) are colored black.
+ * Points outside the set get colors based on escape time.
+ *
+ * @param iterations Number of iterations before escape
+ * @return RGB color (0.0 - 1.0)
+ */
+vec3 iterationsToRGB(uint iterations) {
+  if (iterations >= params.maxIterations) {
+    // Point is in the Mandelbrot set - color it black
+    return vec3(0.0);
+  }
+
+  // Create smooth color gradient based on iteration count
+  float t = float(iterations) / float(params.maxIterations);
+  t = t * params.colorScale; // Apply color scaling
+
+  // Use HSV color space for smooth gradients
+  float hue = fract(t * 3.0);    // Cycle through hues
+  float sat = 1.0;               // Full saturation for vibrant colors
+  float val = t < 1.0 ? t : 1.0; // Brightness based on iteration count
+
+  return hsv2rgb(hue, sat, val);
+}
+
+/**
+ * @brief Map iteration count to a packed color
+ *
+ * @param iterations Number of iterations before escape
+ * @return RGBA color as packed uint32
+ */
+uint iterationsToColor(uint iterations) {
+  vec3 rgb = iterationsToRGB(iterations);
+  return packRGBA(rgb.r, rgb.g, rgb.b, 1.0);
+}
+
+/**
+ * @brief Integer hash used to decorrelate the sample pattern between pixels
+ *
+ * @param x Value to hash
+ * @return Well-mixed 32-bit hash
+ */
+uint hashPixel(uint x) {
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return x;
+}
+
+/**
+ * @brief Sub-pixel offset of an extra sample
+ *
+ * R2 low-discrepancy sequence, randomly rotated per pixel so neighbouring
+ * pixels don't share the same sample pattern. The 1 spp sample sits on the
+ * pixel corner; offsets cover [0, 1)^2 from it.
+ *
+ * @param pixelIndex Linear pixel index
+ * @param sampleIndex Position in the sequence (1 = first extra sample)
+ * @return Offset in pixels
+ */
+vec2 sampleOffset(uint pixelIndex, uint sampleIndex) {
+  uint hash = hashPixel(pixelIndex);
+  vec2 rotation = vec2(hash & 0xFFFFu, hash >> 16) / 65536.0;
+  return fract(rotation +
+               float(sampleIndex) * vec2(0.7548776662, 0.5698402910));
+}
+
+/**
+ * @brief Iterate one full sample from scratch and color it
+ *
+ * @param pixel Sample position in pixel coordinates
+ * @return RGB color (0.0 - 1.0)
+ */
+vec3 sampleColor(vec2 pixel) {
+  vec2 fractalCoord = pixelToFractal(pixel);
+  vec2 z = orbitStart(fractalCoord);
+  uint iterations = fractalIterations(z, orbitConstant(fractalCoord), 0u,
+                                      params.maxIterations);
+  return iterationsToRGB(iterations);
+}
+
+#endif // FRACTAL_COMMON_GLSL
@@ -14,9 +14,16 @@ layout(location = 0) out vec4 outColor;
 
 layout(binding = 0) uniform sampler2D fractalTexture;
 
+// Rendered region of the texture; below full size with dynamic resolution
+layout(push_constant) uniform DisplayRegion {
+  vec2 uvScale;
+  vec2 uvMax;
+} region;
+
 void main() {
-  // Sample the fractal texture
-  vec4 fractalColor = texture(fractalTexture, fragTexCoord);
+  // Sample the fractal texture, clamped to the last rendered texel centre
+  vec2 uv = min(fragTexCoord * region.uvScale, region.uvMax);
+  vec4 fractalColor = texture(fractalTexture, uv);
 
   // The compute shader outputs RGBA fractal data
   outColor = fractalColor;
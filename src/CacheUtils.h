@@ -0,0 +1,81 @@
+/**
+ * @file CacheUtils.h
+ * @brief Shared helpers for the on-disk caches
+ *
+ * Hashing and directory lookup used by the pipeline cache and the SPIR-V
+ * cache, so both agree on where cache files live and how keys are formed.
+ *
+ * Phase 5 Focus:
+ * - Fast warm starts for interactive and batch runs
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace CacheUtils {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+/**
+ * @brief 64-bit FNV-1a hash, chainable through the seed
+ *
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @param seed Previous hash to continue from
+ * @return Hash value
+ */
+inline uint64_t fnv1a(const void *data, size_t size,
+                      uint64_t seed = FNV_OFFSET_BASIS) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  uint64_t hash = seed;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/**
+ * @brief Format a value as fixed-width lowercase hex
+ *
+ * @param value Value to format
+ * @return 16 hex digits
+ */
+inline std::string toHex(uint64_t value) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (int i = 15; i >= 0; i--) {
+    hex[i] = digits[value & 0xF];
+    value >>= 4;
+  }
+  return hex;
+}
+
+/**
+ * @brief Get the root directory for cache files
+ *
+ * $XDG_CACHE_HOME/fractal-generator, else ~/.cache/fractal-generator,
+ * else the working directory.
+ *
+ * @return Directory path
+ */
+inline std::string defaultDirectory() {
+  if (const char *xdgCache = std::getenv("XDG_CACHE_HOME");
+      xdgCache && *xdgCache) {
+    return std::string(xdgCache) + "/fractal-generator";
+  }
+  if (const char *home = std::getenv("HOME"); home && *home) {
+    return std::string(home) + "/.cache/fractal-generator";
+  }
+  return ".";
+}
+
+} // namespace CacheUtils
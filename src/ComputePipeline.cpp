@@ -8,47 +8,130 @@
  */
 
 #include "ComputePipeline.h"
+#include "LayoutCache.h"
 #include "MemoryManager.h"
+#include "PipelineCache.h"
+#include "PipelineCompiler.h"
 #include "ShaderManager.h"
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
 
+namespace {
+
+// Chunked iteration tuning: short chunks waste passes on barriers, long ones
+// let divergence creep back in
+constexpr uint32_t MIN_CHUNK_ITERATIONS = 64;
+constexpr uint32_t MAX_CHUNK_PASSES = 32;
+
+// Header of an active pixel list: VkDispatchIndirectCommand plus a count
+constexpr VkDeviceSize ACTIVE_LIST_HEADER_SIZE = 4 * sizeof(uint32_t);
+
+// Adaptive anti-aliasing: sample cap range and the neighbour color contrast
+// (largest channel difference) above which a pixel counts as an edge
+constexpr uint32_t MIN_AA_SAMPLES = 4;
+constexpr uint32_t MAX_AA_SAMPLES = 64;
+constexpr float AA_EDGE_THRESHOLD = 0.08f;
+
+// OrbitState in fractal_common.glsl: vec2 z, uint iterations, uint reserved
+constexpr VkDeviceSize ORBIT_STATE_SIZE = 16;
+
+// Accumulation buffer element: vec4 (color sum, sample count)
+constexpr VkDeviceSize ACCUMULATION_ELEMENT_SIZE = 4 * sizeof(float);
+
+// Temporal accumulation stops once a still image has this many frames
+constexpr uint32_t MAX_ACCUMULATION_FRAMES = 256;
+
+// Storage buffers written by allocateAndUpdateDescriptorSet() at bindings
+// 1-5: output, orbit state, two active pixel lists, accumulation
+constexpr uint32_t FRACTAL_BINDING_COUNT = 5;
+
+/**
+ * @brief Make compute shader writes visible to later commands
+ */
+void recordShaderWriteBarrier(VkCommandBuffer commandBuffer,
+                              VkPipelineStageFlags dstStageMask,
+                              VkAccessFlags dstAccessMask) {
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  barrier.dstAccessMask = dstAccessMask;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                       dstStageMask, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+/**
+ * @brief Make fill and update writes visible to compute shaders
+ */
+void recordTransferWriteBarrier(VkCommandBuffer commandBuffer) {
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask =
+      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0,
+                       nullptr, 0, nullptr);
+}
+
+} // namespace
+
 ComputePipeline::ComputePipeline(VkDevice device,
                                  std::shared_ptr<ShaderManager> shaderManager,
-                                 std::shared_ptr<MemoryManager> memoryManager)
+                                 std::shared_ptr<MemoryManager> memoryManager,
+                                 std::shared_ptr<PipelineCache> pipelineCache)
     : m_device(device), m_shaderManager(shaderManager),
-      m_memoryManager(memoryManager), m_fractalPipeline(VK_NULL_HANDLE),
+      m_memoryManager(memoryManager), m_pipelineCache(pipelineCache),
+      m_fractalPipeline(VK_NULL_HANDLE),
       m_fractalPipelineLayout(VK_NULL_HANDLE),
       m_fractalDescriptorSetLayout(VK_NULL_HANDLE),
       m_descriptorPool(VK_NULL_HANDLE), m_fractalDescriptorSet(VK_NULL_HANDLE),
-      m_fractalImageWidth(0), m_fractalImageHeight(0),
-      m_fractalPipelineReady(false) {
+      m_chunkDescriptorSet(VK_NULL_HANDLE), m_hotReloadEnabled(false),
+      m_fractalImageWidth(0),
+      m_fractalImageHeight(0), m_renderWidth(0), m_renderHeight(0),
+      m_fractalPipelineReady(false), m_pushParameters{},
+      m_recordingVersion(0),
+      m_orbitResumeEnabled(true), m_orbitStateValid(false),
+      m_resumingOrbits(false), m_orbitStateParams{},
+      m_chunkedIterationEnabled(true), m_chunkPassCount(0),
+      m_antiAliasingAvailable(false), m_antiAliasingPending(false),
+      m_temporalAccumulationEnabled(true), m_accumulationFrame(0),
+      m_imageRendered(false) {
   std::cout << "[ComputePipeline] Initialized compute pipeline system"
             << std::endl;
 
-  // Create descriptor pool for all pipelines
-  m_descriptorPool = createDescriptorPool();
+  m_pipelineCompiler = std::make_unique<PipelineCompiler>(
+      m_device, m_shaderManager, m_pipelineCache);
 }
 
 ComputePipeline::~ComputePipeline() {
   std::cout << "[ComputePipeline] Cleaning up compute pipeline resources..."
             << std::endl;
 
-  // Clean up fractal pipeline resources
-  if (m_fractalPipeline != VK_NULL_HANDLE) {
-    vkDestroyPipeline(m_device, m_fractalPipeline, nullptr);
+  // The watcher callback submits to the compiler, which may be compiling
+  // against the pipeline layout
+  if (m_hotReloadEnabled) {
+    m_shaderManager->setChangeCallback(nullptr);
   }
+  m_pipelineCompiler.reset();
 
-  if (m_fractalPipelineLayout != VK_NULL_HANDLE) {
-    vkDestroyPipelineLayout(m_device, m_fractalPipelineLayout, nullptr);
+  // Deferred descriptor set frees need the pool, which is destroyed below
+  m_memoryManager->getDeletionQueue().flush();
+
+  // Clean up generic pipelines
+  for (auto &entry : m_pipelines) {
+    vkDestroyPipeline(m_device, entry.second, nullptr);
   }
+  m_pipelines.clear();
 
-  if (m_fractalDescriptorSetLayout != VK_NULL_HANDLE) {
-    vkDestroyDescriptorSetLayout(m_device, m_fractalDescriptorSetLayout,
-                                 nullptr);
+  // Clean up fractal pipeline resources
+  if (m_fractalPipeline != VK_NULL_HANDLE) {
+    vkDestroyPipeline(m_device, m_fractalPipeline, nullptr);
   }
 
+  // The layouts belong to the shader manager's layout cache
   if (m_descriptorPool != VK_NULL_HANDLE) {
     vkDestroyDescriptorPool(m_device, m_descriptorPool, nullptr);
   }
@@ -75,12 +158,183 @@ bool ComputePipeline::createPipeline(const std::string &pipelineName,
     return false;
   }
 
-  // TODO(Future): Implement generic pipeline creation for multiple compute
-  // operations Currently specialized for fractal computation; future expansion
-  // for other algorithms
-  std::cerr << "[ComputePipeline] Generic pipeline creation not yet implemented"
-            << std::endl;
-  return false;
+  if (m_fractalPipelineLayout == VK_NULL_HANDLE) {
+    std::cerr << "[ComputePipeline] Fractal pipeline layout must exist before "
+              << "creating " << pipelineName << std::endl;
+    return false;
+  }
+
+  if (m_pipelines.count(pipelineName) > 0) {
+    std::cerr << "[ComputePipeline] Pipeline already exists: " << pipelineName
+              << std::endl;
+    return false;
+  }
+
+  if (!m_fractalReflection.covers(shader->reflection)) {
+    std::cerr << "[ComputePipeline] Shader " << shaderName
+              << " uses resources missing from the fractal pipeline layout"
+              << std::endl;
+    return false;
+  }
+
+  VkComputePipelineCreateInfo pipelineInfo{};
+  pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipelineInfo.layout = m_fractalPipelineLayout;
+  pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  pipelineInfo.stage.module = shader->module;
+  pipelineInfo.stage.pName = shader->entryPoint.c_str();
+
+  VkPipelineCache cache =
+      m_pipelineCache ? m_pipelineCache->getHandle() : VK_NULL_HANDLE;
+  VkPipeline pipeline;
+  VkResult result = vkCreateComputePipelines(m_device, cache, 1, &pipelineInfo,
+                                             nullptr, &pipeline);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to create compute pipeline! Vulkan error: " +
+        std::to_string(result));
+  }
+
+  m_pipelines[pipelineName] = pipeline;
+  m_localSizes[pipelineName] = {shader->reflection.localSize[0],
+                                shader->reflection.localSize[1],
+                                shader->reflection.localSize[2]};
+  m_recordingVersion++;
+  return true;
+}
+
+bool ComputePipeline::destroyPipeline(const std::string &pipelineName) {
+  auto it = m_pipelines.find(pipelineName);
+  if (it == m_pipelines.end()) {
+    return false;
+  }
+
+  // In-flight frames may still dispatch it
+  VkPipeline pipeline = it->second;
+  m_pipelines.erase(it);
+  m_memoryManager->getDeletionQueue().enqueue(
+      [device = m_device, pipeline]() {
+        vkDestroyPipeline(device, pipeline, nullptr);
+      });
+  return true;
+}
+
+bool ComputePipeline::requestPipelineRebuild(const std::string &pipelineName,
+                                             const std::string &filePath,
+                                             const ShaderDefines &defines,
+                                             bool useEmbedded) {
+  if (m_fractalPipelineLayout == VK_NULL_HANDLE) {
+    std::cerr << "[ComputePipeline] Fractal pipeline layout must exist before "
+              << "rebuilding " << pipelineName << std::endl;
+    return false;
+  }
+
+  PipelineCompileRequest request;
+  request.pipelineName = pipelineName;
+  request.filePath = filePath;
+  request.defines = defines;
+  request.layout = m_fractalPipelineLayout;
+  request.layoutInterface = m_fractalReflection;
+  request.useEmbedded = useEmbedded;
+  m_pipelineCompiler->submit(std::move(request));
+  return true;
+}
+
+std::vector<std::string> ComputePipeline::collectCompiledPipelines() {
+  std::vector<std::string> swapped;
+
+  for (auto &result : m_pipelineCompiler->collectReady()) {
+    if (result.pipeline == VK_NULL_HANDLE) {
+      std::cerr << "[ComputePipeline] Keeping previous " << result.pipelineName
+                << " pipeline: " << result.error << std::endl;
+      continue;
+    }
+
+    VkPipeline *slot = result.pipelineName == FRACTAL_PIPELINE
+                           ? &m_fractalPipeline
+                           : &m_pipelines[result.pipelineName];
+    VkPipeline previous = *slot;
+    *slot = result.pipeline;
+    m_localSizes[result.pipelineName] = {result.reflection.localSize[0],
+                                         result.reflection.localSize[1],
+                                         result.reflection.localSize[2]};
+    m_recordingVersion++;
+
+    // In-flight frames may still dispatch the old one
+    if (previous != VK_NULL_HANDLE) {
+      m_memoryManager->getDeletionQueue().enqueue(
+          [device = m_device, previous]() {
+            vkDestroyPipeline(device, previous, nullptr);
+          });
+    }
+
+    std::cout << "[ComputePipeline] Swapped in new " << result.pipelineName
+              << " pipeline" << std::endl;
+    swapped.push_back(result.pipelineName);
+  }
+
+  return swapped;
+}
+
+void ComputePipeline::setShaderHotReloadEnabled(bool enabled) {
+  if (!enabled) {
+    m_shaderManager->setChangeCallback(nullptr);
+    m_hotReloadEnabled = false;
+  }
+
+  for (const auto &[pipelineName, source] : m_pipelineSources) {
+    if (enabled) {
+      m_shaderManager->enableHotReload(source.shaderName, source.filePath);
+    } else {
+      m_shaderManager->disableHotReload(source.shaderName);
+    }
+  }
+
+  if (enabled && m_fractalPipelineLayout != VK_NULL_HANDLE) {
+    // Watcher events go straight to the compile queue; the callback gets
+    // its own copy of which pipelines each shader feeds
+    std::unordered_map<std::string, std::vector<std::string>>
+        pipelinesByShader;
+    for (const auto &[pipelineName, source] : m_pipelineSources) {
+      pipelinesByShader[source.shaderName].push_back(pipelineName);
+    }
+    m_shaderManager->setChangeCallback(
+        [compiler = m_pipelineCompiler.get(),
+         layout = m_fractalPipelineLayout,
+         layoutInterface = m_fractalReflection,
+         pipelinesByShader](const std::vector<ShaderFileChange> &changes) {
+          for (const auto &change : changes) {
+            auto it = pipelinesByShader.find(change.name);
+            if (it == pipelinesByShader.end()) {
+              continue;
+            }
+            for (const auto &pipelineName : it->second) {
+              PipelineCompileRequest request;
+              request.pipelineName = pipelineName;
+              request.filePath = change.filePath;
+              request.entryPoint = change.entryPoint;
+              request.layout = layout;
+              request.layoutInterface = layoutInterface;
+              request.useEmbedded = false; // Predates the edit
+              compiler->submit(std::move(request));
+            }
+          }
+        });
+    m_hotReloadEnabled = true;
+  }
+}
+
+void ComputePipeline::reloadChangedShaders() {
+  // Watched files already went to the compiler; this only sees polled ones
+  for (const auto &change : m_shaderManager->collectChangedShaders()) {
+    for (const auto &[pipelineName, source] : m_pipelineSources) {
+      if (source.shaderName == change.name) {
+        // The embedded SPIR-V predates the edit
+        requestPipelineRebuild(pipelineName, change.filePath, {}, false);
+      }
+    }
+  }
 }
 
 bool ComputePipeline::createFractalPipeline(uint32_t imageWidth,
@@ -92,31 +346,60 @@ bool ComputePipeline::createFractalPipeline(uint32_t imageWidth,
     // Store image dimensions
     m_fractalImageWidth = imageWidth;
     m_fractalImageHeight = imageHeight;
-
-    // Create or load the Mandelbrot compute shader
+    m_renderWidth = imageWidth;
+    m_renderHeight = imageHeight;
+
+    // Load every kernel first; they share one layout covering the union
+    // of their reflected bindings
+    const char *kernels[5][2] = {
+        {"mandelbrot", "shaders/mandelbrot.comp"},
+        {"mandelbrot_chunk", "shaders/mandelbrot_chunk.comp"},
+        {"fractal_aa", "shaders/fractal_aa.comp"},
+        {"fractal_resolve", "shaders/fractal_resolve.comp"},
+        {"fractal_accumulate", "shaders/fractal_accumulate.comp"}};
+    m_fractalReflection = ShaderReflection{};
+    for (const auto &kernel : kernels) {
+      auto kernelShader = m_shaderManager->getShader(kernel[0]);
+      if (!kernelShader) {
+        kernelShader = m_shaderManager->loadShaderFromFile(
+            kernel[0], kernel[1], ShaderType::COMPUTE, "main");
+      }
+      m_fractalReflection.merge(kernelShader->reflection);
+    }
     auto shader = m_shaderManager->getShader("mandelbrot");
-    if (!shader) {
-      // Load and compile the shader
-      shader = m_shaderManager->loadShaderFromFile(
-          "mandelbrot", "shaders/mandelbrot.comp", ShaderType::COMPUTE, "main");
+    m_pipelineSources[FRACTAL_PIPELINE] = {"mandelbrot",
+                                           "shaders/mandelbrot.comp"};
+
+    // allocateAndUpdateDescriptorSet() provides storage buffers at bindings
+    // 1-5; parameters are pushed with every dispatch
+    for (const auto &binding : m_fractalReflection.bindings) {
+      if (binding.set != 0 || binding.binding < 1 ||
+          binding.binding > FRACTAL_BINDING_COUNT ||
+          binding.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+        throw std::runtime_error(
+            "Fractal shaders declare set " + std::to_string(binding.set) +
+            " binding " + std::to_string(binding.binding) +
+            " with a type the host does not provide");
+      }
     }
-
-    // Create descriptor set layout
-    m_fractalDescriptorSetLayout = createFractalDescriptorSetLayout();
-
-    // Create pipeline layout
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &m_fractalDescriptorSetLayout;
-    pipelineLayoutInfo.pushConstantRangeCount = 0;
-
-    VkResult result = vkCreatePipelineLayout(m_device, &pipelineLayoutInfo,
-                                             nullptr, &m_fractalPipelineLayout);
-    if (result != VK_SUCCESS) {
+    if (m_fractalReflection.pushConstantSize != sizeof(FractalParameters)) {
       throw std::runtime_error(
-          "Failed to create pipeline layout! Vulkan error: " +
-          std::to_string(result));
+          "Fractal shader push constants are " +
+          std::to_string(m_fractalReflection.pushConstantSize) +
+          " bytes, expected " + std::to_string(sizeof(FractalParameters)));
+    }
+
+    // Descriptor set and pipeline layouts from reflection
+    LayoutCache &layoutCache = m_shaderManager->getLayoutCache();
+    m_fractalDescriptorSetLayout = layoutCache.getDescriptorSetLayout(
+        m_fractalReflection.getSetBindings(0));
+    m_fractalPipelineLayout = layoutCache.getPipelineLayout(
+        {m_fractalDescriptorSetLayout},
+        m_fractalReflection.getPushConstantRanges());
+
+    // Create descriptor pool for all pipelines
+    if (m_descriptorPool == VK_NULL_HANDLE) {
+      m_descriptorPool = createDescriptorPool();
     }
 
     // Create compute pipeline
@@ -129,42 +412,90 @@ bool ComputePipeline::createFractalPipeline(uint32_t imageWidth,
     pipelineInfo.stage.module = shader->module;
     pipelineInfo.stage.pName = shader->entryPoint.c_str();
 
-    result =
-        vkCreateComputePipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo,
-                                 nullptr, &m_fractalPipeline);
+    VkPipelineCache cache =
+        m_pipelineCache ? m_pipelineCache->getHandle() : VK_NULL_HANDLE;
+    VkResult result = vkCreateComputePipelines(m_device, cache, 1,
+                                               &pipelineInfo, nullptr,
+                                               &m_fractalPipeline);
     if (result != VK_SUCCESS) {
       throw std::runtime_error(
           "Failed to create compute pipeline! Vulkan error: " +
           std::to_string(result));
     }
-
-    // Create parameter buffer
-    size_t paramBufferSize = sizeof(FractalParameters);
-    m_fractalParameterBuffer = m_memoryManager->createBuffer(
-        "fractal_parameters", paramBufferSize,
-        BufferUsage::FRACTAL_PARAMS_BUFFER, MemoryLocation::CPU_TO_GPU,
-        true // Persistently mapped for frequent updates
-    );
-
-    // Create output buffer
-    size_t outputBufferSize =
-        imageWidth * imageHeight * sizeof(uint32_t); // RGBA32 format
+    m_localSizes[FRACTAL_PIPELINE] = {shader->reflection.localSize[0],
+                                      shader->reflection.localSize[1],
+                                      shader->reflection.localSize[2]};
+
+    // Create output buffer, rounded up to a size class so that later
+    // resizes by a few pixels can keep it
+    VkDeviceSize outputBufferSize = MemoryManager::sizeClassFor(
+        static_cast<VkDeviceSize>(imageWidth) * imageHeight *
+        sizeof(uint32_t)); // RGBA32 format
+    // On unified memory the output stays mapped so readers skip the copy
+    MemoryLocation outputLocation = m_memoryManager->hasUnifiedMemory()
+                                        ? MemoryLocation::GPU_HOST_VISIBLE
+                                        : MemoryLocation::GPU_ONLY;
     m_fractalOutputBuffer = m_memoryManager->createBuffer(
         "fractal_output", outputBufferSize, BufferUsage::FRACTAL_OUTPUT_BUFFER,
-        MemoryLocation::GPU_ONLY, false);
+        outputLocation, outputLocation == MemoryLocation::GPU_HOST_VISIBLE);
+
+    // Create the ping-pong active pixel lists for chunked iteration
+    VkDeviceSize activeListSize = MemoryManager::sizeClassFor(
+        ACTIVE_LIST_HEADER_SIZE + static_cast<VkDeviceSize>(imageWidth) *
+                                      imageHeight * sizeof(uint32_t));
+    for (uint32_t i = 0; i < 2; i++) {
+      m_activeListBuffers[i] = m_memoryManager->createBuffer(
+          "fractal_active_pixels_" + std::to_string(i), activeListSize,
+          BufferUsage::INDIRECT_BUFFER, MemoryLocation::GPU_ONLY, false);
+    }
+
+    // Chunk continuation pipeline; without it we fall back to single pass
+    if (!createPipeline("fractal_chunk", "mandelbrot_chunk")) {
+      std::cerr << "[ComputePipeline] Chunked iteration unavailable, using "
+                << "single-pass dispatch" << std::endl;
+      m_chunkedIterationEnabled = false;
+    } else {
+      m_pipelineSources["fractal_chunk"] = {"mandelbrot_chunk",
+                                            "shaders/mandelbrot_chunk.comp"};
+    }
+
+    // Adaptive anti-aliasing pipelines; the accumulation buffer starts as a
+    // placeholder and is sized on first use
+    m_antiAliasingAvailable = true;
+    const char *aaShaders[2][2] = {{"fractal_aa", "shaders/fractal_aa.comp"},
+                                   {"fractal_resolve",
+                                    "shaders/fractal_resolve.comp"}};
+    for (const auto &aaShader : aaShaders) {
+      m_antiAliasingAvailable =
+          createPipeline(aaShader[0], aaShader[0]) && m_antiAliasingAvailable;
+      m_pipelineSources[aaShader[0]] = {aaShader[0], aaShader[1]};
+    }
+    if (!m_antiAliasingAvailable) {
+      std::cerr << "[ComputePipeline] Anti-aliasing unavailable" << std::endl;
+    }
+
+    // Temporal accumulation pipeline for still frames
+    if (!createPipeline("fractal_accumulate", "fractal_accumulate")) {
+      std::cerr << "[ComputePipeline] Temporal accumulation unavailable"
+                << std::endl;
+      m_temporalAccumulationEnabled = false;
+    } else {
+      m_pipelineSources["fractal_accumulate"] = {
+          "fractal_accumulate", "shaders/fractal_accumulate.comp"};
+    }
+    m_accumulationBuffer = m_memoryManager->createBuffer(
+        "fractal_accumulation", ACCUMULATION_ELEMENT_SIZE,
+        BufferUsage::STORAGE_BUFFER, MemoryLocation::GPU_ONLY, false);
 
-    // Allocate and update descriptor set
-    m_fractalDescriptorSet = allocateAndUpdateDescriptorSet(
-        m_fractalDescriptorSetLayout, m_fractalParameterBuffer,
-        m_fractalOutputBuffer);
+    // Allocate and update descriptor sets (done by createOrbitStateBuffer
+    // once the orbit state buffer exists)
+    createOrbitStateBuffer();
 
     m_fractalPipelineReady = true;
 
     std::cout
         << "[ComputePipeline] Fractal compute pipeline created successfully"
         << std::endl;
-    std::cout << "[ComputePipeline] Parameter buffer: "
-              << (paramBufferSize / 1024.0f) << " KB" << std::endl;
     std::cout << "[ComputePipeline] Output buffer: "
               << (outputBufferSize / (1024.0f * 1024.0f)) << " MB" << std::endl;
 
@@ -178,21 +509,142 @@ bool ComputePipeline::createFractalPipeline(uint32_t imageWidth,
   }
 }
 
+bool ComputePipeline::resizeFractalImage(uint32_t imageWidth,
+                                         uint32_t imageHeight) {
+  if (!m_fractalPipelineReady) {
+    return false;
+  }
+  if (imageWidth == m_fractalImageWidth &&
+      imageHeight == m_fractalImageHeight) {
+    return true;
+  }
+
+  VkDeviceSize pixelCount = static_cast<VkDeviceSize>(imageWidth) * imageHeight;
+
+  // Buffers that outgrew (or are far too big for) their size class
+  struct Replacement {
+    std::shared_ptr<BufferInfo> *slot;
+    std::shared_ptr<BufferInfo> buffer;
+  };
+  std::vector<Replacement> replacements;
+
+  try {
+    auto fit = [&](std::shared_ptr<BufferInfo> &slot, VkDeviceSize size) {
+      if (MemoryManager::fitsSizeClass(slot->size, size)) {
+        return;
+      }
+      replacements.push_back(
+          {&slot, m_memoryManager->createBuffer(
+                      slot->name, MemoryManager::sizeClassFor(size),
+                      slot->usage, slot->location, slot->persistentlyMapped)});
+    };
+
+    fit(m_fractalOutputBuffer, pixelCount * sizeof(uint32_t));
+    for (auto &listBuffer : m_activeListBuffers) {
+      fit(listBuffer, ACTIVE_LIST_HEADER_SIZE + pixelCount * sizeof(uint32_t));
+    }
+    // Placeholders stay placeholders
+    if (m_orbitResumeEnabled) {
+      fit(m_orbitStateBuffer, ORBIT_STATE_SIZE * pixelCount);
+    }
+    if (m_accumulationBuffer->size > ACCUMULATION_ELEMENT_SIZE) {
+      fit(m_accumulationBuffer, ACCUMULATION_ELEMENT_SIZE * pixelCount);
+    }
+  } catch (const std::exception &e) {
+    // Nothing has referenced the new buffers yet
+    for (const Replacement &replacement : replacements) {
+      m_memoryManager->removeBuffer(replacement.buffer->handle);
+    }
+    std::cerr << "[ComputePipeline] Failed to resize to " << imageWidth << "x"
+              << imageHeight << ": " << e.what() << std::endl;
+    return false;
+  }
+
+  // Frames in flight may still use the old buffers and descriptor sets
+  for (Replacement &replacement : replacements) {
+    m_memoryManager->removeBufferDeferred((*replacement.slot)->handle);
+    *replacement.slot = std::move(replacement.buffer);
+  }
+  if (!replacements.empty()) {
+    updateFractalDescriptorSets();
+  }
+
+  m_fractalImageWidth = imageWidth;
+  m_fractalImageHeight = imageHeight;
+  m_renderWidth = imageWidth;
+  m_renderHeight = imageHeight;
+  m_recordingVersion++;
+
+  // Stored orbits and samples describe the old pixel grid
+  m_orbitStateValid = false;
+  m_imageRendered = false;
+  m_accumulationFrame = 0;
+
+  std::cout << "[ComputePipeline] Resized to " << imageWidth << "x"
+            << imageHeight << " (" << replacements.size()
+            << " buffers reallocated)" << std::endl;
+  return true;
+}
+
 void ComputePipeline::updateFractalParameters(const FractalParameters &params) {
-  if (!m_fractalPipelineReady || !m_fractalParameterBuffer) {
+  if (!m_fractalPipelineReady) {
     std::cerr
         << "[ComputePipeline] Fractal pipeline not ready for parameter updates"
         << std::endl;
     return;
   }
 
-  // Copy parameters to the mapped buffer
-  if (m_fractalParameterBuffer->mappedData) {
-    std::memcpy(m_fractalParameterBuffer->mappedData, &params,
-                sizeof(FractalParameters));
+  // Pick the orbit mode: continue the stored orbits when that gives the same
+  // image as starting over, otherwise restart (and record if enabled)
+  FractalParameters gpuParams = params;
+  m_resumingOrbits = m_orbitResumeEnabled && m_orbitStateValid &&
+                     canResumeOrbits(m_orbitStateParams, params);
+  if (m_resumingOrbits) {
+    gpuParams.orbitMode = static_cast<uint32_t>(OrbitMode::RESUME);
+    gpuParams.resumeIterations = m_orbitStateParams.maxIterations;
   } else {
-    std::cerr << "[ComputePipeline] Parameter buffer not mapped!" << std::endl;
+    gpuParams.orbitMode = static_cast<uint32_t>(
+        m_orbitResumeEnabled ? OrbitMode::RECORD : OrbitMode::NONE);
+    gpuParams.resumeIterations = 0;
+  }
+
+  // Adaptive anti-aliasing runs after the fractal passes when requested
+  gpuParams.aaMaxSamples = 0;
+  gpuParams.aaThreshold = AA_EDGE_THRESHOLD;
+  if (params.aaMaxSamples > 0 && m_antiAliasingAvailable) {
+    gpuParams.aaMaxSamples =
+        std::clamp(params.aaMaxSamples, MIN_AA_SAMPLES, MAX_AA_SAMPLES);
+    ensureAccumulationBuffer();
+  }
+  m_antiAliasingPending = gpuParams.aaMaxSamples > 0;
+
+  // New parameters restart temporal accumulation from this full render
+  m_accumulationFrame = 0;
+  m_imageRendered = true;
+  if (m_temporalAccumulationEnabled) {
+    ensureAccumulationBuffer();
+  }
+
+  // Split the remaining iterations into passes over the surviving pixels
+  // (bounded pixels being resumed all start at resumeIterations)
+  gpuParams.chunkIterations =
+      selectChunkIterations(gpuParams.resumeIterations, params.maxIterations);
+  m_chunkPassCount = 0;
+  if (gpuParams.chunkIterations > 0) {
+    uint32_t remaining = params.maxIterations - gpuParams.resumeIterations;
+    m_chunkPassCount =
+        (remaining + gpuParams.chunkIterations - 1) / gpuParams.chunkIterations -
+        1;
   }
+
+  // The upcoming dispatch leaves the buffer describing these parameters
+  m_orbitStateParams = params;
+  m_orbitStateValid = m_orbitResumeEnabled;
+
+  // Recorded into the command buffer by the next dispatch; kept
+  // accumulation recordings push the old values
+  m_pushParameters = gpuParams;
+  m_recordingVersion++;
 }
 
 void ComputePipeline::dispatchFractalCompute(VkCommandBuffer commandBuffer,
@@ -204,10 +656,30 @@ void ComputePipeline::dispatchFractalCompute(VkCommandBuffer commandBuffer,
     return;
   }
 
-  // Calculate dispatch info
+  // Every kernel shares the layout, so one push serves all passes below
+  vkCmdPushConstants(commandBuffer, m_fractalPipelineLayout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FractalParameters),
+                     &m_pushParameters);
+
+  // Without AA nothing rewrites the sums; zero counts make the first
+  // accumulation pass seed them from the new image
+  if (m_temporalAccumulationEnabled && !m_antiAliasingPending) {
+    vkCmdFillBuffer(commandBuffer, m_accumulationBuffer->buffer, 0,
+                    VK_WHOLE_SIZE, 0);
+    recordTransferWriteBarrier(commandBuffer);
+  }
+
+  // The first pass appends survivors to list 0, which must start empty
+  if (m_chunkPassCount > 0) {
+    recordActiveListReset(commandBuffer, *m_activeListBuffers[0]);
+  }
+
+  // Calculate dispatch info; 0 means the shader's declared local size
   ComputeDispatchInfo dispatchInfo =
-      calculateDispatchInfo(m_fractalImageWidth, m_fractalImageHeight,
-                            workGroupSizeX, workGroupSizeY);
+      workGroupSizeX == 0 || workGroupSizeY == 0
+          ? calculateDispatchInfo(FRACTAL_PIPELINE)
+          : calculateDispatchInfo(m_renderWidth, m_renderHeight,
+                                  workGroupSizeX, workGroupSizeY);
 
   // Bind compute pipeline
   vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
@@ -222,31 +694,161 @@ void ComputePipeline::dispatchFractalCompute(VkCommandBuffer commandBuffer,
   vkCmdDispatch(commandBuffer, dispatchInfo.groupCountX,
                 dispatchInfo.groupCountY, dispatchInfo.groupCountZ);
 
+  if (m_chunkPassCount > 0) {
+    recordChunkPasses(commandBuffer);
+  }
+
+  if (m_antiAliasingPending) {
+    recordAntiAliasingPasses(commandBuffer);
+  }
+
   // std::cout << "[ComputePipeline] Dispatched fractal compute: "
   //           << dispatchInfo.groupCountX << "x" << dispatchInfo.groupCountY
-  //           << " work groups (" << workGroupSizeX << "x" << workGroupSizeY <<
-  //           " local size)" << std::endl;
+  //           << " work groups" << std::endl;
+}
+
+void ComputePipeline::recordAccumulationPass(VkCommandBuffer commandBuffer) {
+  if (!m_fractalPipelineReady) {
+    std::cerr << "[ComputePipeline] Fractal pipeline not ready for dispatch"
+              << std::endl;
+    return;
+  }
+
+  // Still frame: one more sample into the running average, nothing else
+  vkCmdPushConstants(commandBuffer, m_fractalPipelineLayout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(FractalParameters),
+                     &m_pushParameters);
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    m_pipelines.at("fractal_accumulate"));
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                          m_fractalPipelineLayout, 0, 1,
+                          &m_fractalDescriptorSet, 0, nullptr);
+  ComputeDispatchInfo dispatchInfo =
+      calculateDispatchInfo("fractal_accumulate");
+  vkCmdDispatch(commandBuffer, dispatchInfo.groupCountX,
+                dispatchInfo.groupCountY, dispatchInfo.groupCountZ);
+}
+
+void ComputePipeline::recordChunkPasses(VkCommandBuffer commandBuffer) {
+  // Continuation passes: read list (pass % 2), append to the other one
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    m_pipelines.at("fractal_chunk"));
+
+  for (uint32_t pass = 0; pass < m_chunkPassCount; pass++) {
+    const BufferInfo &inputList = *m_activeListBuffers[pass % 2];
+    const BufferInfo &outputList = *m_activeListBuffers[(pass + 1) % 2];
+    VkDescriptorSet descriptorSet =
+        pass % 2 == 0 ? m_chunkDescriptorSet : m_fractalDescriptorSet;
+
+    // Previous pass's appends become this pass's indirect args and input
+    recordShaderWriteBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                                 VK_ACCESS_SHADER_READ_BIT |
+                                 VK_ACCESS_SHADER_WRITE_BIT |
+                                 VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    recordActiveListReset(commandBuffer, outputList);
+
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            m_fractalPipelineLayout, 0, 1, &descriptorSet, 0,
+                            nullptr);
+    vkCmdDispatchIndirect(commandBuffer, inputList.buffer, 0);
+  }
+}
+
+void ComputePipeline::recordAntiAliasingPasses(VkCommandBuffer commandBuffer) {
+  // Edge detection reads neighbours of the finished 1 spp image
+  recordShaderWriteBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_ACCESS_SHADER_READ_BIT |
+                               VK_ACCESS_SHADER_WRITE_BIT);
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    m_pipelines.at("fractal_aa"));
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                          m_fractalPipelineLayout, 0, 1,
+                          &m_fractalDescriptorSet, 0, nullptr);
+  ComputeDispatchInfo dispatchInfo = calculateDispatchInfo("fractal_aa");
+  vkCmdDispatch(commandBuffer, dispatchInfo.groupCountX,
+                dispatchInfo.groupCountY, dispatchInfo.groupCountZ);
+
+  // Resolve overwrites the output the AA pass was reading
+  recordShaderWriteBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_ACCESS_SHADER_READ_BIT |
+                               VK_ACCESS_SHADER_WRITE_BIT);
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    m_pipelines.at("fractal_resolve"));
+  dispatchInfo = calculateDispatchInfo("fractal_resolve");
+  vkCmdDispatch(commandBuffer, dispatchInfo.groupCountX,
+                dispatchInfo.groupCountY, dispatchInfo.groupCountZ);
 }
 
 std::shared_ptr<BufferInfo> ComputePipeline::getFractalOutputBuffer() const {
   return m_fractalOutputBuffer;
 }
 
-bool ComputePipeline::getFractalData(std::vector<uint32_t> &outputData) {
+const uint32_t *ComputePipeline::getMappedFractalData() const {
   if (!m_fractalPipelineReady || !m_fractalOutputBuffer) {
-    return false;
+    return nullptr;
+  }
+  return static_cast<const uint32_t *>(m_fractalOutputBuffer->mappedData);
+}
+
+std::future<std::vector<uint32_t>>
+ComputePipeline::readFractalDataAsync(VkCommandPool commandPool,
+                                      VkQueue queue) {
+  // Shared with the chunk callbacks, which outlive this call
+  struct Readback {
+    std::vector<uint32_t> pixels;
+    std::promise<std::vector<uint32_t>> promise;
+  };
+  auto readback = std::make_shared<Readback>();
+  std::future<std::vector<uint32_t>> future = readback->promise.get_future();
+
+  if (!m_fractalPipelineReady || !m_fractalOutputBuffer) {
+    readback->promise.set_exception(std::make_exception_ptr(
+        std::runtime_error("Fractal output buffer not ready")));
+    return future;
+  }
+
+  size_t pixelCount =
+      static_cast<size_t>(m_renderWidth) * m_renderHeight;
+  VkDeviceSize byteCount = pixelCount * sizeof(uint32_t);
+  readback->pixels.resize(pixelCount);
+
+  try {
+    // The output buffer is GPU_ONLY; chunks arrive in order through the
+    // host-cached readback ring
+    m_memoryManager->readBufferDataAsync(
+        m_fractalOutputBuffer, byteCount, 0, commandPool, queue,
+        [readback, byteCount](const void *data, VkDeviceSize offset,
+                              VkDeviceSize size) {
+          std::memcpy(reinterpret_cast<uint8_t *>(readback->pixels.data()) +
+                          offset,
+                      data, size);
+          if (offset + size == byteCount) {
+            readback->promise.set_value(std::move(readback->pixels));
+          }
+        });
+  } catch (...) {
+    // Chunks already submitted still complete, but never fulfil the promise
+    readback->promise.set_exception(std::current_exception());
   }
 
-  size_t pixelCount = m_fractalImageWidth * m_fractalImageHeight;
-  outputData.resize(pixelCount);
+  return future;
+}
 
+bool ComputePipeline::getFractalData(std::vector<uint32_t> &outputData,
+                                     VkCommandPool commandPool,
+                                     VkQueue queue) {
   try {
-    // Note: This requires the output buffer to be host-visible for direct
-    // download In a real implementation, we might need a staging buffer for
-    // GPU-only memory
-    m_memoryManager->downloadBufferData(m_fractalOutputBuffer,
-                                        outputData.data(),
-                                        pixelCount * sizeof(uint32_t));
+    std::future<std::vector<uint32_t>> future =
+        readFractalDataAsync(commandPool, queue);
+    m_memoryManager->waitForTransfers();
+    outputData = future.get();
     return true;
 
   } catch (const std::exception &e) {
@@ -256,6 +858,101 @@ bool ComputePipeline::getFractalData(std::vector<uint32_t> &outputData) {
   }
 }
 
+void ComputePipeline::setOrbitResumeEnabled(bool enabled) {
+  if (enabled == m_orbitResumeEnabled) {
+    return;
+  }
+
+  m_orbitResumeEnabled = enabled;
+  m_orbitStateValid = false;
+
+  if (m_fractalPipelineReady) {
+    createOrbitStateBuffer();
+  }
+
+  std::cout << "[ComputePipeline] Orbit resume "
+            << (enabled ? "enabled" : "disabled") << std::endl;
+}
+
+void ComputePipeline::setChunkedIterationEnabled(bool enabled) {
+  if (enabled && m_fractalPipelineReady &&
+      m_pipelines.count("fractal_chunk") == 0) {
+    std::cerr << "[ComputePipeline] Chunk pipeline unavailable, chunked "
+              << "iteration stays disabled" << std::endl;
+    return;
+  }
+
+  m_chunkedIterationEnabled = enabled;
+  std::cout << "[ComputePipeline] Chunked iteration "
+            << (enabled ? "enabled" : "disabled") << std::endl;
+}
+
+void ComputePipeline::setTemporalAccumulationEnabled(bool enabled) {
+  if (enabled && m_fractalPipelineReady &&
+      m_pipelines.count("fractal_accumulate") == 0) {
+    std::cerr << "[ComputePipeline] Accumulation pipeline unavailable, "
+              << "temporal accumulation stays disabled" << std::endl;
+    return;
+  }
+
+  m_temporalAccumulationEnabled = enabled;
+  std::cout << "[ComputePipeline] Temporal accumulation "
+            << (enabled ? "enabled" : "disabled") << std::endl;
+}
+
+VkDeviceSize ComputePipeline::estimateMemoryUsage(uint32_t width,
+                                                  uint32_t height) const {
+  // Output buffer and both active pixel lists are always per pixel
+  VkDeviceSize bytesPerPixel = 3 * sizeof(uint32_t);
+  if (m_orbitResumeEnabled) {
+    bytesPerPixel += ORBIT_STATE_SIZE;
+  }
+  if (m_temporalAccumulationEnabled || m_antiAliasingPending) {
+    bytesPerPixel += ACCUMULATION_ELEMENT_SIZE;
+  }
+  return static_cast<VkDeviceSize>(width) * height * bytesPerPixel +
+         2 * ACTIVE_LIST_HEADER_SIZE;
+}
+
+bool ComputePipeline::reduceMemoryFootprint() {
+  bool released = false;
+
+  if (m_orbitResumeEnabled) {
+    setOrbitResumeEnabled(false);
+    released = true;
+  }
+
+  if (m_temporalAccumulationEnabled) {
+    setTemporalAccumulationEnabled(false);
+  }
+
+  // Back to the placeholder the pipeline starts with
+  if (!m_antiAliasingPending && m_accumulationBuffer &&
+      m_accumulationBuffer->size > ACCUMULATION_ELEMENT_SIZE) {
+    m_memoryManager->removeBufferDeferred(m_accumulationBuffer->handle);
+    m_accumulationBuffer = m_memoryManager->createBuffer(
+        "fractal_accumulation", ACCUMULATION_ELEMENT_SIZE,
+        BufferUsage::STORAGE_BUFFER, MemoryLocation::GPU_ONLY, false);
+    updateFractalDescriptorSets();
+    released = true;
+  }
+
+  return released;
+}
+
+bool ComputePipeline::prepareAccumulationFrame() {
+  // Needs a full render first (updateFractalParameters sizes the buffer)
+  if (!m_temporalAccumulationEnabled || !m_fractalPipelineReady ||
+      !m_imageRendered ||
+      m_accumulationFrame + 1 >= MAX_ACCUMULATION_FRAMES) {
+    return false;
+  }
+
+  // The GPU tracks samples per pixel; this only bounds the frame count
+  m_accumulationFrame++;
+  return true;
+}
+
 bool ComputePipeline::isFractalPipelineReady() const {
   return m_fractalPipelineReady;
 }
@@ -266,57 +963,40 @@ void ComputePipeline::getFractalDimensions(uint32_t &width,
   height = m_fractalImageHeight;
 }
 
-VkDescriptorSetLayout ComputePipeline::createFractalDescriptorSetLayout() {
-  // Descriptor bindings for fractal computation
-  VkDescriptorSetLayoutBinding bindings[2] = {};
-
-  // Binding 0: Uniform buffer for fractal parameters
-  bindings[0].binding = 0;
-  bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-  bindings[0].descriptorCount = 1;
-  bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-  bindings[0].pImmutableSamplers = nullptr;
-
-  // Binding 1: Storage buffer for output data
-  bindings[1].binding = 1;
-  bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  bindings[1].descriptorCount = 1;
-  bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-  bindings[1].pImmutableSamplers = nullptr;
-
-  VkDescriptorSetLayoutCreateInfo layoutInfo{};
-  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-  layoutInfo.bindingCount = 2;
-  layoutInfo.pBindings = bindings;
+bool ComputePipeline::setRenderExtent(uint32_t width, uint32_t height) {
+  width = std::clamp(width, 1u, std::max(m_fractalImageWidth, 1u));
+  height = std::clamp(height, 1u, std::max(m_fractalImageHeight, 1u));
+  if (width == m_renderWidth && height == m_renderHeight) {
+    return false;
+  }
 
-  VkDescriptorSetLayout descriptorSetLayout;
-  VkResult result = vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr,
-                                                &descriptorSetLayout);
+  m_renderWidth = width;
+  m_renderHeight = height;
+  m_recordingVersion++;
 
-  if (result != VK_SUCCESS) {
-    throw std::runtime_error(
-        "Failed to create descriptor set layout! Vulkan error: " +
-        std::to_string(result));
-  }
+  // Stored orbits and samples describe the old pixel grid
+  m_orbitStateValid = false;
+  m_imageRendered = false;
+  m_accumulationFrame = 0;
+  return true;
+}
 
-  return descriptorSetLayout;
+void ComputePipeline::getRenderExtent(uint32_t &width,
+                                      uint32_t &height) const {
+  width = m_renderWidth;
+  height = m_renderHeight;
 }
 
 VkDescriptorPool ComputePipeline::createDescriptorPool(uint32_t maxSets) {
-  VkDescriptorPoolSize poolSizes[2] = {};
-
-  // Uniform buffers
-  poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-  poolSizes[0].descriptorCount = maxSets;
-
-  // Storage buffers
-  poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  poolSizes[1].descriptorCount = maxSets;
+  // Every set uses the shared layout, so the pool holds maxSets of each of
+  // its bindings
+  std::vector<VkDescriptorPoolSize> poolSizes =
+      m_fractalReflection.getPoolSizes(maxSets);
 
   VkDescriptorPoolCreateInfo poolInfo{};
   poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  poolInfo.poolSizeCount = 2;
-  poolInfo.pPoolSizes = poolSizes;
+  poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+  poolInfo.pPoolSizes = poolSizes.data();
   poolInfo.maxSets = maxSets;
   poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
@@ -334,8 +1014,8 @@ VkDescriptorPool ComputePipeline::createDescriptorPool(uint32_t maxSets) {
 }
 
 VkDescriptorSet ComputePipeline::allocateAndUpdateDescriptorSet(
-    VkDescriptorSetLayout layout, std::shared_ptr<BufferInfo> parameterBuffer,
-    std::shared_ptr<BufferInfo> outputBuffer) {
+    VkDescriptorSetLayout layout, std::shared_ptr<BufferInfo> activeInBuffer,
+    std::shared_ptr<BufferInfo> activeOutBuffer) {
   // Allocate descriptor set
   VkDescriptorSetAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -352,40 +1032,149 @@ VkDescriptorSet ComputePipeline::allocateAndUpdateDescriptorSet(
         std::to_string(result));
   }
 
-  // Update descriptor set
-  VkWriteDescriptorSet descriptorWrites[2] = {};
+  // Update descriptor set: storage buffers at bindings 1-5 (the parameters
+  // are push constants)
+  const std::shared_ptr<BufferInfo> buffers[FRACTAL_BINDING_COUNT] = {
+      m_fractalOutputBuffer, m_orbitStateBuffer, activeInBuffer,
+      activeOutBuffer, m_accumulationBuffer};
+  VkDescriptorBufferInfo bufferInfos[FRACTAL_BINDING_COUNT] = {};
+  VkWriteDescriptorSet descriptorWrites[FRACTAL_BINDING_COUNT] = {};
+
+  for (uint32_t i = 0; i < FRACTAL_BINDING_COUNT; i++) {
+    bufferInfos[i].buffer = buffers[i]->buffer;
+    bufferInfos[i].offset = 0;
+    bufferInfos[i].range = buffers[i]->size;
+
+    descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[i].dstSet = descriptorSet;
+    descriptorWrites[i].dstBinding = 1 + i;
+    descriptorWrites[i].dstArrayElement = 0;
+    descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[i].descriptorCount = 1;
+    descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+  }
 
-  // Parameter buffer descriptor
-  VkDescriptorBufferInfo paramBufferInfo{};
-  paramBufferInfo.buffer = parameterBuffer->buffer;
-  paramBufferInfo.offset = 0;
-  paramBufferInfo.range = parameterBuffer->size;
+  // Skip bindings that no kernel declares; they are absent from the layout
+  uint32_t writeCount = 0;
+  for (const auto &write : descriptorWrites) {
+    bool declared = std::any_of(
+        m_fractalReflection.bindings.begin(),
+        m_fractalReflection.bindings.end(),
+        [&write](const ReflectedBinding &binding) {
+          return binding.binding == write.dstBinding;
+        });
+    if (declared) {
+      descriptorWrites[writeCount++] = write;
+    }
+  }
+
+  vkUpdateDescriptorSets(m_device, writeCount, descriptorWrites, 0, nullptr);
+
+  return descriptorSet;
+}
 
-  descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  descriptorWrites[0].dstSet = descriptorSet;
-  descriptorWrites[0].dstBinding = 0;
-  descriptorWrites[0].dstArrayElement = 0;
-  descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-  descriptorWrites[0].descriptorCount = 1;
-  descriptorWrites[0].pBufferInfo = &paramBufferInfo;
+void ComputePipeline::createOrbitStateBuffer() {
+  VkDeviceSize bufferSize =
+      m_orbitResumeEnabled
+          ? MemoryManager::sizeClassFor(ORBIT_STATE_SIZE * m_fractalImageWidth *
+                                        m_fractalImageHeight)
+          : ORBIT_STATE_SIZE;
 
-  // Output buffer descriptor
-  VkDescriptorBufferInfo outputBufferInfo{};
-  outputBufferInfo.buffer = outputBuffer->buffer;
-  outputBufferInfo.offset = 0;
-  outputBufferInfo.range = outputBuffer->size;
+  if (m_orbitStateBuffer) {
+    m_memoryManager->removeBufferDeferred(m_orbitStateBuffer->handle);
+  }
+  m_orbitStateBuffer = m_memoryManager->createBuffer(
+      "fractal_orbit_state", bufferSize, BufferUsage::STORAGE_BUFFER,
+      MemoryLocation::GPU_ONLY, false);
 
-  descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-  descriptorWrites[1].dstSet = descriptorSet;
-  descriptorWrites[1].dstBinding = 1;
-  descriptorWrites[1].dstArrayElement = 0;
-  descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-  descriptorWrites[1].descriptorCount = 1;
-  descriptorWrites[1].pBufferInfo = &outputBufferInfo;
+  updateFractalDescriptorSets();
 
-  vkUpdateDescriptorSets(m_device, 2, descriptorWrites, 0, nullptr);
+  std::cout << "[ComputePipeline] Orbit state buffer: "
+            << (bufferSize / (1024.0f * 1024.0f)) << " MB" << std::endl;
+}
 
-  return descriptorSet;
+void ComputePipeline::ensureAccumulationBuffer() {
+  VkDeviceSize bufferSize = ACCUMULATION_ELEMENT_SIZE * m_fractalImageWidth *
+                            m_fractalImageHeight;
+  if (m_accumulationBuffer && m_accumulationBuffer->size >= bufferSize) {
+    return;
+  }
+
+  // Grows once, the first time anti-aliasing is enabled
+  if (m_accumulationBuffer) {
+    m_memoryManager->removeBufferDeferred(m_accumulationBuffer->handle);
+  }
+  m_accumulationBuffer = m_memoryManager->createBuffer(
+      "fractal_accumulation", MemoryManager::sizeClassFor(bufferSize),
+      BufferUsage::STORAGE_BUFFER, MemoryLocation::GPU_ONLY, false);
+
+  updateFractalDescriptorSets();
+
+  std::cout << "[ComputePipeline] Accumulation buffer: "
+            << (bufferSize / (1024.0f * 1024.0f)) << " MB" << std::endl;
+}
+
+void ComputePipeline::updateFractalDescriptorSets() {
+  // Descriptor sets are immutable once bound to a submitted command buffer,
+  // so hand out fresh ones rather than rewriting bindings in place. The old
+  // sets are freed once the frames that bound them have retired.
+  VkDescriptorSet *sets[2] = {&m_fractalDescriptorSet, &m_chunkDescriptorSet};
+  for (VkDescriptorSet *set : sets) {
+    if (*set != VK_NULL_HANDLE) {
+      m_memoryManager->getDeletionQueue().enqueue(
+          [device = m_device, pool = m_descriptorPool, retired = *set]() {
+            vkFreeDescriptorSets(device, pool, 1, &retired);
+          });
+      *set = VK_NULL_HANDLE;
+    }
+  }
+
+  // The main set appends to list 0; the chunk set reads list 0 and appends
+  // to list 1, and passes alternate between the two
+  m_fractalDescriptorSet = allocateAndUpdateDescriptorSet(
+      m_fractalDescriptorSetLayout, m_activeListBuffers[1],
+      m_activeListBuffers[0]);
+  m_chunkDescriptorSet = allocateAndUpdateDescriptorSet(
+      m_fractalDescriptorSetLayout, m_activeListBuffers[0],
+      m_activeListBuffers[1]);
+  m_recordingVersion++;
+}
+
+uint32_t ComputePipeline::selectChunkIterations(uint32_t startIteration,
+                                                uint32_t maxIterations) const {
+  // Chunk passes carry z in the orbit state buffer, so it must be full size
+  if (!m_chunkedIterationEnabled || !m_orbitResumeEnabled ||
+      maxIterations <= startIteration) {
+    return 0;
+  }
+
+  uint32_t remaining = maxIterations - startIteration;
+  uint32_t chunk = (remaining + MAX_CHUNK_PASSES - 1) / MAX_CHUNK_PASSES;
+  if (chunk < MIN_CHUNK_ITERATIONS) {
+    chunk = MIN_CHUNK_ITERATIONS;
+  }
+
+  // Not worth a second pass
+  return chunk < remaining ? chunk : 0;
+}
+
+void ComputePipeline::recordActiveListReset(VkCommandBuffer commandBuffer,
+                                            const BufferInfo &listBuffer) {
+  // Empty list whose header is a valid zero-sized indirect dispatch
+  const uint32_t emptyHeader[4] = {0, 1, 1, 0};
+  vkCmdUpdateBuffer(commandBuffer, listBuffer.buffer, 0,
+                    ACTIVE_LIST_HEADER_SIZE, emptyHeader);
+  recordTransferWriteBarrier(commandBuffer);
+}
+
+bool ComputePipeline::canResumeOrbits(const FractalParameters &previous,
+                                      const FractalParameters &next) {
+  return previous.centerX == next.centerX &&
+         previous.centerY == next.centerY && previous.zoom == next.zoom &&
+         previous.imageWidth == next.imageWidth &&
+         previous.imageHeight == next.imageHeight &&
+         previous.fractalType == next.fractalType &&
+         next.maxIterations >= previous.maxIterations;
 }
 
 ComputeDispatchInfo ComputePipeline::calculateDispatchInfo(
@@ -401,3 +1190,10 @@ ComputeDispatchInfo ComputePipeline::calculateDispatchInfo(
 
   return info;
 }
+
+ComputeDispatchInfo
+ComputePipeline::calculateDispatchInfo(const std::string &pipelineName) {
+  const std::array<uint32_t, 3> &localSize = m_localSizes.at(pipelineName);
+  return calculateDispatchInfo(m_renderWidth, m_renderHeight, localSize[0],
+                               localSize[1]);
+}
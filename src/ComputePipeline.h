@@ -19,15 +19,19 @@
 
 #pragma once
 
+#include "ShaderManager.h"
+#include <array>
+#include <future>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan.h>
 
 // Forward declarations
-class ShaderManager;
 class MemoryManager;
-struct ShaderInfo;
+class PipelineCache;
+class PipelineCompiler;
 struct BufferInfo;
 
 /**
@@ -45,7 +49,8 @@ struct ComputeDispatchInfo {
  * @brief Parameters for fractal computation
  *
  * This structure contains all the parameters needed to compute fractals.
- * It will be uploaded to a uniform buffer for use by compute shaders.
+ * It is recorded into the command buffer as push constants with every
+ * dispatch, matching the push_constant block in fractal_common.glsl.
  */
 struct FractalParameters {
   float centerX;          ///< Center X coordinate in fractal space
@@ -56,6 +61,26 @@ struct FractalParameters {
   uint32_t imageHeight;   ///< Output image height in pixels
   float colorScale;       ///< Scale factor for color mapping
   uint32_t fractalType;   ///< Fractal type (0=Mandelbrot, 1=Julia, etc.)
+  uint32_t orbitMode;     ///< OrbitMode, filled in by updateFractalParameters
+  uint32_t resumeIterations; ///< Iteration budget of the stored orbit state
+  uint32_t chunkIterations;  ///< Iterations per pass, 0 = single pass
+  uint32_t aaMaxSamples;     ///< Adaptive AA sample cap (0 = off, 4-64)
+  float aaThreshold;         ///< Edge contrast, filled in by the pipeline
+};
+
+// maxPushConstantsSize is only guaranteed to be 128 bytes
+static_assert(sizeof(FractalParameters) <= 128,
+              "FractalParameters must fit in the guaranteed push constant "
+              "space");
+
+/**
+ * @enum OrbitMode
+ * @brief How the compute shader uses the per-pixel orbit state buffer
+ */
+enum class OrbitMode : uint32_t {
+  NONE = 0,   ///< Orbit state disabled
+  RECORD = 1, ///< Iterate from z0 and store (z, iterations) per pixel
+  RESUME = 2  ///< Continue still-bounded orbits from the stored state
 };
 
 /**
@@ -87,9 +112,11 @@ public:
    * @param device Vulkan logical device
    * @param shaderManager Shader manager for loading compute shaders
    * @param memoryManager Memory manager for buffer allocation
+   * @param pipelineCache Cache shared by all pipelines (may be null)
    */
   ComputePipeline(VkDevice device, std::shared_ptr<ShaderManager> shaderManager,
-                  std::shared_ptr<MemoryManager> memoryManager);
+                  std::shared_ptr<MemoryManager> memoryManager,
+                  std::shared_ptr<PipelineCache> pipelineCache = nullptr);
 
   /**
    * @brief Destructor - Clean up all compute resources
@@ -105,6 +132,10 @@ public:
   /**
    * @brief Create compute pipeline from shader
    *
+   * The pipeline shares the fractal descriptor set layout, so it must be
+   * created after createFractalPipeline() and its shader must declare a
+   * subset of the fractal bindings.
+   *
    * @param pipelineName Unique name for the pipeline
    * @param shaderName Name of the compute shader to use
    * @return true if pipeline created successfully, false otherwise
@@ -114,11 +145,74 @@ public:
   bool createPipeline(const std::string &pipelineName,
                       const std::string &shaderName);
 
+  /**
+   * @brief Release a pipeline from createPipeline()
+   *
+   * The name is free for a new pipeline immediately; the Vulkan object is
+   * destroyed through the deletion queue once in-flight frames retire.
+   *
+   * @param pipelineName Name given to createPipeline()
+   * @return true if the pipeline existed
+   */
+  bool destroyPipeline(const std::string &pipelineName);
+
+  /**
+   * @brief Rebuild a pipeline on the background compiler
+   *
+   * The current pipeline keeps being used until the new one is swapped in
+   * by collectCompiledPipelines(); a failed compile leaves it in place. A
+   * name without a pipeline yet adds a new variant.
+   *
+   * @param pipelineName FRACTAL_PIPELINE or a createPipeline() name
+   * @param filePath Compute shader file to build from
+   * @param defines Preprocessor macros for the variant
+   * @param useEmbedded Use build-time SPIR-V if available
+   * @return false if the fractal pipeline does not exist yet
+   */
+  bool requestPipelineRebuild(const std::string &pipelineName,
+                              const std::string &filePath,
+                              const ShaderDefines &defines = {},
+                              bool useEmbedded = true);
+
+  /**
+   * @brief Swap in pipelines finished by the background compiler
+   *
+   * Call once per frame before recording. Replaced pipelines go to the
+   * deletion queue.
+   *
+   * @return Names of the pipelines that changed; the next dispatch should
+   *         be a full render
+   */
+  std::vector<std::string> collectCompiledPipelines();
+
+  /**
+   * @brief Watch the compute shader files for edits
+   *
+   * Where inotify is available, edits are handed to the background
+   * compiler from the watcher thread; otherwise reloadChangedShaders()
+   * polls for them. Call after createFractalPipeline().
+   *
+   * @param enabled Whether edited shaders are rebuilt
+   */
+  void setShaderHotReloadEnabled(bool enabled);
+
+  /**
+   * @brief Queue background rebuilds for edited compute shaders
+   *
+   * Never compiles on the calling thread; results arrive through
+   * collectCompiledPipelines(). Only needed where inotify is unavailable,
+   * and free otherwise.
+   */
+  void reloadChangedShaders();
+
+  /// Pipeline name of the main fractal pipeline
+  static constexpr const char *FRACTAL_PIPELINE = "fractal";
+
   /**
    * @brief Create fractal computation pipeline
    *
    * Creates a specialized pipeline for Mandelbrot set computation with
-   * appropriate descriptor set layout and parameter buffers.
+   * appropriate descriptor set layout and buffers.
    *
    * @param imageWidth Width of the output fractal image
    * @param imageHeight Height of the output fractal image
@@ -126,28 +220,178 @@ public:
    */
   bool createFractalPipeline(uint32_t imageWidth, uint32_t imageHeight);
 
+  /**
+   * @brief Change the fractal image size without rebuilding pipelines
+   *
+   * Per-pixel buffers are kept while their size class still fits and are
+   * otherwise replaced from the memory pool; replaced buffers go to the
+   * deletion queue and descriptor sets are rewritten. Either every buffer
+   * is resized or, on failure, the old size stays in effect.
+   *
+   * @param imageWidth New width of the output fractal image
+   * @param imageHeight New height of the output fractal image
+   * @return true if the pipeline now renders at the new size
+   */
+  bool resizeFractalImage(uint32_t imageWidth, uint32_t imageHeight);
+
   /**
    * @brief Update fractal parameters
    *
-   * Updates the uniform buffer with new fractal computation parameters.
+   * Stores new fractal computation parameters; the next dispatch records
+   * them as push constants, so frames in flight keep their own values.
+   * When orbit resume is enabled and only maxIterations grew (or only the
+   * coloring changed), the next dispatch continues the stored orbits instead
+   * of restarting every pixel from z0. The orbit, chunk and AA threshold
+   * fields of params are ignored and chosen here; the call must be followed
+   * by dispatchFractalCompute().
    *
    * @param params New fractal parameters
    */
   void updateFractalParameters(const FractalParameters &params);
 
+  /**
+   * @brief Enable or disable per-pixel orbit state
+   *
+   * Orbit state costs 16 bytes per pixel of device memory. When disabled the
+   * buffer is shrunk to a placeholder and every dispatch starts from z0.
+   * Must not be called while a fractal dispatch is in flight.
+   *
+   * @param enabled Whether to keep orbit state between dispatches
+   */
+  void setOrbitResumeEnabled(bool enabled);
+
+  /**
+   * @brief Check whether orbit state is kept between dispatches
+   *
+   * @return true if orbit resume is enabled
+   */
+  bool isOrbitResumeEnabled() const { return m_orbitResumeEnabled; }
+
+  /**
+   * @brief Check whether the pending dispatch resumes stored orbits
+   *
+   * @return true if the last updateFractalParameters() selected resume mode
+   */
+  bool isResumingOrbits() const { return m_resumingOrbits; }
+
+  /**
+   * @brief Enable or disable chunked iteration
+   *
+   * In chunked mode the first dispatch runs a fixed number of iterations per
+   * pixel and compacts the still-bounded pixels into a list; follow-up passes
+   * are indirect dispatches over that list only. Requires orbit resume,
+   * which provides the per-pixel state carried between passes.
+   *
+   * @param enabled Whether to split high iteration counts into passes
+   */
+  void setChunkedIterationEnabled(bool enabled);
+
+  /**
+   * @brief Check whether chunked iteration is enabled
+   *
+   * @return true if high iteration counts are split into passes
+   */
+  bool isChunkedIterationEnabled() const { return m_chunkedIterationEnabled; }
+
+  /**
+   * @brief Enable or disable temporal accumulation of still frames
+   *
+   * @param enabled Whether static views keep accumulating jittered samples
+   */
+  void setTemporalAccumulationEnabled(bool enabled);
+
+  /**
+   * @brief Check whether temporal accumulation is enabled
+   *
+   * @return true if static views keep accumulating jittered samples
+   */
+  bool isTemporalAccumulationEnabled() const {
+    return m_temporalAccumulationEnabled;
+  }
+
+  /**
+   * @brief Prepare a still-frame accumulation dispatch
+   *
+   * Instead of recomputing an unchanged image, the commands recorded by
+   * recordAccumulationPass() add one jittered sample per pixel to the
+   * running average. Any updateFractalParameters() call restarts the
+   * average.
+   *
+   * @return true if an accumulation pass should be submitted; false if
+   *         accumulation is disabled, no image has been rendered yet, or the
+   *         image converged
+   */
+  bool prepareAccumulationFrame();
+
+  /**
+   * @brief Record one still-frame accumulation pass
+   *
+   * The pass reads no per-frame state (each pixel's sample count lives in
+   * the accumulation buffer), so the same recording can be submitted for
+   * every still frame until getRecordingVersion() changes.
+   *
+   * @param commandBuffer Command buffer to record into
+   */
+  void recordAccumulationPass(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Get a counter that changes whenever recorded commands go stale
+   *
+   * Bumped by parameter updates, pipeline swaps, new descriptor sets and
+   * render extent changes. Command buffers kept across frames are
+   * re-recorded when it differs from the value they were recorded at.
+   *
+   * @return Current recording version
+   */
+  uint64_t getRecordingVersion() const { return m_recordingVersion; }
+
+  /**
+   * @brief Get the number of samples accumulated into the current image
+   *
+   * @return 1 after a full render, +1 for every accumulation frame
+   */
+  uint32_t getAccumulatedFrameCount() const { return m_accumulationFrame + 1; }
+
+  /**
+   * @brief Estimate the device memory the fractal buffers need
+   *
+   * Counts every per-pixel buffer of the current feature set, so a
+   * resolution can be checked against the memory budget before it is used.
+   *
+   * @param width Image width in pixels
+   * @param height Image height in pixels
+   * @return Estimated bytes of device memory
+   */
+  VkDeviceSize estimateMemoryUsage(uint32_t width, uint32_t height) const;
+
+  /**
+   * @brief Drop optional per-pixel buffers to save memory
+   *
+   * Disables orbit resume and temporal accumulation and shrinks their
+   * buffers; anti-aliasing keeps the accumulation buffer while it is on.
+   * Must not be called while a fractal dispatch is in flight.
+   *
+   * @return true if any buffer was released
+   */
+  bool reduceMemoryFootprint();
+
   /**
    * @brief Dispatch fractal computation
    *
    * Records and submits commands to compute a fractal using the current
-   * parameters.
+   * parameters. In chunked mode this records the first full-image dispatch
+   * followed by the indirect continuation passes and their barriers; with
+   * anti-aliasing it appends the adaptive sampling and resolve passes.
    *
    * @param commandBuffer Command buffer to record into
-   * @param workGroupSizeX Local work group size in X dimension (default: 16)
-   * @param workGroupSizeY Local work group size in Y dimension (default: 16)
+   * @param workGroupSizeX Local work group size in X dimension (default: 0,
+   *                       the size declared by the shader)
+   * @param workGroupSizeY Local work group size in Y dimension (default: 0,
+   *                       the size declared by the shader)
    */
   void dispatchFractalCompute(VkCommandBuffer commandBuffer,
-                              uint32_t workGroupSizeX = 16,
-                              uint32_t workGroupSizeY = 16);
+                              uint32_t workGroupSizeX = 0,
+                              uint32_t workGroupSizeY = 0);
 
   /**
    * @brief Get the fractal output buffer
@@ -159,16 +403,46 @@ public:
    */
   std::shared_ptr<BufferInfo> getFractalOutputBuffer() const;
 
+  /**
+   * @brief Get the output pixels in place, without any copy
+   *
+   * Only available on unified memory, where the output buffer is
+   * device-local and mapped. The data is complete once the dispatch that
+   * wrote it has finished.
+   *
+   * @return Packed RGBA pixels, or nullptr if the output is not mapped
+   */
+  const uint32_t *getMappedFractalData() const;
+
+  /**
+   * @brief Start reading the computed fractal back to the host
+   *
+   * Copies the output buffer through MemoryManager's readback ring. The
+   * future becomes ready from MemoryManager::processCompletedTransfers()
+   * once the last copy's fence has signalled, so callers poll it once per
+   * frame instead of blocking. Several readbacks may be in flight.
+   *
+   * @param commandPool Command pool for the copy commands
+   * @param queue Queue that wrote the output buffer
+   * @return Future holding width * height packed RGBA values
+   */
+  std::future<std::vector<uint32_t>>
+  readFractalDataAsync(VkCommandPool commandPool, VkQueue queue);
+
   /**
    * @brief Get computed fractal data
    *
-   * Downloads the computed fractal data from GPU memory to host memory.
-   * The data is returned as an array of 32-bit RGBA values.
+   * Synchronous wrapper around readFractalDataAsync(): waits for the
+   * readback to complete. The data is returned as an array of 32-bit RGBA
+   * values.
    *
    * @param outputData Vector to store the fractal data
+   * @param commandPool Command pool for the copy commands
+   * @param queue Queue that wrote the output buffer
    * @return true if data retrieved successfully, false otherwise
    */
-  bool getFractalData(std::vector<uint32_t> &outputData);
+  bool getFractalData(std::vector<uint32_t> &outputData,
+                      VkCommandPool commandPool, VkQueue queue);
 
   /**
    * @brief Check if fractal pipeline is ready
@@ -185,26 +459,38 @@ public:
    */
   void getFractalDimensions(uint32_t &width, uint32_t &height) const;
 
+  /**
+   * @brief Render only part of the fractal image
+   *
+   * Dispatches, readbacks and the shaders' pixel grid use the render extent;
+   * buffers stay sized for the full image, so changing the extent costs no
+   * allocation. The output is tightly packed at the render width.
+   *
+   * @param width Rendered width, clamped to the image width
+   * @param height Rendered height, clamped to the image height
+   * @return true if the extent changed (the next render must be a full one)
+   */
+  bool setRenderExtent(uint32_t width, uint32_t height);
+
+  /**
+   * @brief Get the extent the next dispatch renders
+   *
+   * @param width Output parameter for rendered width
+   * @param height Output parameter for rendered height
+   */
+  void getRenderExtent(uint32_t &width, uint32_t &height) const;
+
   // Multiple fractal type support implemented (Mandelbrot, Julia Set, Burning
   // Ship) Real-time parameter animation implemented via GUI controls
   // TODO(Phase 4): Add multi-pipeline support for complex fractals
   // TODO(Phase 5): Add GPU profiling and optimization
 
 private:
-  /**
-   * @brief Create descriptor set layout for fractal computation
-   *
-   * Creates a descriptor set layout that includes:
-   * - Uniform buffer for fractal parameters
-   * - Storage buffer for output data
-   *
-   * @return VkDescriptorSetLayout handle
-   */
-  VkDescriptorSetLayout createFractalDescriptorSetLayout();
-
   /**
    * @brief Create descriptor pool for allocating descriptor sets
    *
+   * Pool sizes follow the descriptor types in m_fractalReflection.
+   *
    * @param maxSets Maximum number of descriptor sets to allocate
    * @return VkDescriptorPool handle
    */
@@ -213,15 +499,85 @@ private:
   /**
    * @brief Allocate and update descriptor set
    *
+   * Binds the parameter, output, orbit state and accumulation buffers plus
+   * the given pair of active pixel lists.
+   *
    * @param layout Descriptor set layout to use
-   * @param parameterBuffer Buffer containing fractal parameters
-   * @param outputBuffer Buffer for fractal output data
+   * @param activeInBuffer Active pixel list read by chunk passes
+   * @param activeOutBuffer Active pixel list appended to by every pass
    * @return VkDescriptorSet handle
    */
   VkDescriptorSet
   allocateAndUpdateDescriptorSet(VkDescriptorSetLayout layout,
-                                 std::shared_ptr<BufferInfo> parameterBuffer,
-                                 std::shared_ptr<BufferInfo> outputBuffer);
+                                 std::shared_ptr<BufferInfo> activeInBuffer,
+                                 std::shared_ptr<BufferInfo> activeOutBuffer);
+
+  /**
+   * @brief (Re)allocate the fractal descriptor sets
+   *
+   * Two sets differ only in which active pixel list is read and which is
+   * appended to, so consecutive chunk passes ping-pong between them.
+   */
+  void updateFractalDescriptorSets();
+
+  /**
+   * @brief (Re)create the orbit state buffer
+   *
+   * Allocates one OrbitState per pixel when orbit resume is enabled, or a
+   * single-element placeholder otherwise, and rebinds the descriptor sets.
+   */
+  void createOrbitStateBuffer();
+
+  /**
+   * @brief Grow the accumulation buffer to one vec4 per pixel if needed
+   */
+  void ensureAccumulationBuffer();
+
+  /**
+   * @brief Record the indirect chunk continuation passes
+   *
+   * @param commandBuffer Command buffer to record into
+   */
+  void recordChunkPasses(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Record the adaptive sampling and resolve passes
+   *
+   * @param commandBuffer Command buffer to record into
+   */
+  void recordAntiAliasingPasses(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Pick the per-pass iteration count for a dispatch
+   *
+   * @param startIteration Iteration the pending dispatch starts from
+   * @param maxIterations Iteration budget of the pending dispatch
+   * @return Iterations per pass, or 0 to compute in a single pass
+   */
+  uint32_t selectChunkIterations(uint32_t startIteration,
+                                 uint32_t maxIterations) const;
+
+  /**
+   * @brief Record a reset of an active pixel list header
+   *
+   * @param commandBuffer Command buffer to record into
+   * @param listBuffer Active pixel list to empty
+   */
+  void recordActiveListReset(VkCommandBuffer commandBuffer,
+                             const BufferInfo &listBuffer);
+
+  /**
+   * @brief Check whether stored orbits can be continued for new parameters
+   *
+   * Orbits depend on the view, resolution and fractal type; the iteration
+   * budget may only grow. Color scale is free to change.
+   *
+   * @param previous Parameters the orbit state was built with
+   * @param next Parameters of the upcoming dispatch
+   * @return true if RESUME mode produces the same image as a full recompute
+   */
+  static bool canResumeOrbits(const FractalParameters &previous,
+                              const FractalParameters &next);
 
   /**
    * @brief Calculate optimal work group count for given dimensions
@@ -237,26 +593,78 @@ private:
                                             uint32_t workGroupSizeX,
                                             uint32_t workGroupSizeY);
 
+  /**
+   * @brief Calculate work group counts covering the render extent
+   *
+   * @param pipelineName Pipeline whose reflected local size is used
+   * @return ComputeDispatchInfo with calculated group counts
+   */
+  ComputeDispatchInfo calculateDispatchInfo(const std::string &pipelineName);
+
   // Member variables
   VkDevice m_device;                              ///< Vulkan logical device
   std::shared_ptr<ShaderManager> m_shaderManager; ///< Shader management
   std::shared_ptr<MemoryManager> m_memoryManager; ///< Memory management
+  std::shared_ptr<PipelineCache> m_pipelineCache; ///< Driver pipeline cache
 
   // Pipeline resources
   VkPipeline m_fractalPipeline;             ///< Fractal compute pipeline
-  VkPipelineLayout m_fractalPipelineLayout; ///< Fractal pipeline layout
+  VkPipelineLayout m_fractalPipelineLayout; ///< Shared, from LayoutCache
   VkDescriptorSetLayout
-      m_fractalDescriptorSetLayout;       ///< Fractal descriptor layout
+      m_fractalDescriptorSetLayout;       ///< Shared, from LayoutCache
+  ShaderReflection m_fractalReflection;   ///< Merged interface of all kernels
   VkDescriptorPool m_descriptorPool;      ///< Descriptor pool
   VkDescriptorSet m_fractalDescriptorSet; ///< Fractal descriptor set
+  VkDescriptorSet m_chunkDescriptorSet;   ///< Set with active lists swapped
+  std::unordered_map<std::string, VkPipeline>
+      m_pipelines; ///< Pipelines from createPipeline()
+  std::unordered_map<std::string, std::array<uint32_t, 3>>
+      m_localSizes; ///< Reflected workgroup size, by pipeline name
+
+  // Background compilation
+  struct PipelineSource {
+    std::string shaderName; ///< ShaderManager name, for hot-reload
+    std::string filePath;   ///< GLSL file the pipeline is built from
+  };
+  std::unordered_map<std::string, PipelineSource>
+      m_pipelineSources; ///< Source of each pipeline, by pipeline name
+  std::unique_ptr<PipelineCompiler>
+      m_pipelineCompiler; ///< Worker for rebuilds and variants
+  bool m_hotReloadEnabled; ///< Change callback registered with shaders
 
   // Fractal-specific resources
-  std::shared_ptr<BufferInfo>
-      m_fractalParameterBuffer; ///< Fractal parameters buffer
   std::shared_ptr<BufferInfo> m_fractalOutputBuffer; ///< Fractal output buffer
+  std::shared_ptr<BufferInfo> m_orbitStateBuffer;    ///< Per-pixel orbit state
   uint32_t m_fractalImageWidth;  ///< Current fractal image width
   uint32_t m_fractalImageHeight; ///< Current fractal image height
+  uint32_t m_renderWidth;        ///< Rendered part of the image (width)
+  uint32_t m_renderHeight;       ///< Rendered part of the image (height)
   bool m_fractalPipelineReady;   ///< Whether fractal pipeline is ready
+  FractalParameters m_pushParameters; ///< Pushed by the next dispatch
+  uint64_t m_recordingVersion; ///< Bumped when recorded commands go stale
+
+  // Orbit resume state
+  bool m_orbitResumeEnabled; ///< Whether orbit state is kept
+  bool m_orbitStateValid;    ///< Whether the buffer matches m_orbitStateParams
+  bool m_resumingOrbits;     ///< Mode chosen for the pending dispatch
+  FractalParameters m_orbitStateParams; ///< Parameters of the stored orbits
+
+  // Chunked iteration state
+  std::shared_ptr<BufferInfo>
+      m_activeListBuffers[2];     ///< Ping-pong active pixel lists
+  bool m_chunkedIterationEnabled; ///< Whether chunked iteration is enabled
+  uint32_t m_chunkPassCount; ///< Indirect passes after the first dispatch
+
+  // Adaptive anti-aliasing state
+  std::shared_ptr<BufferInfo>
+      m_accumulationBuffer;     ///< Per-pixel color sum and sample count
+  bool m_antiAliasingAvailable; ///< Whether the AA pipelines were created
+  bool m_antiAliasingPending;   ///< AA passes requested for the next dispatch
+
+  // Temporal accumulation state
+  bool m_temporalAccumulationEnabled; ///< Whether still frames accumulate
+  uint32_t m_accumulationFrame;       ///< Frames added since the full render
+  bool m_imageRendered; ///< Parameters have been set for a full render
 };
 
 /**
@@ -270,7 +678,9 @@ private:
  *
  * 2. Fractal Computation:
  *    - Uses 32-bit RGBA output format for compatibility
- *    - Parameters stored in uniform buffer for efficiency
+ *    - Parameters pushed as push constants with every dispatch, so
+ *      updates never race frames in flight and need no buffer or
+ *      descriptor writes
  *    - Output buffer sized for full image resolution
  *    - Supports real-time parameter updates
  *
@@ -284,10 +694,70 @@ private:
  *    - RAII pattern for automatic cleanup
  *    - Integration with existing memory manager
  *    - Proper Vulkan object lifecycle management
+ *    - Replaced buffers, pipelines and descriptor sets are released through
+ *      the memory manager's deletion queue, never while frames use them
+ *
+ * 5. Orbit Resume:
+ *    - Each dispatch records (z, iterations) per pixel next to the color
+ *    - Raising maxIterations resumes only the still-bounded pixels, so deep
+ *      interior views pay for the extra iterations instead of all of them
+ *
+ * 6. Chunked Iteration:
+ *    - Near the set boundary most lanes of a 16x16 group escape early and
+ *      idle while their neighbours iterate; chunking compacts the survivors
+ *      so later passes run on dense 64-wide groups
+ *    - Pass count is fixed when recording; empty lists dispatch zero groups
+ *    - Costs 8 bytes per pixel for the two active pixel lists
+ *
+ * 7. Adaptive Anti-Aliasing:
+ *    - A 1 spp image is rendered first; fractal_aa.comp adds 4-64 jittered
+ *      samples only where neighbour contrast marks an edge, and
+ *      fractal_resolve.comp averages the accumulated samples into the output
+ *    - Costs 16 bytes per pixel for the accumulation buffer, allocated the
+ *      first time AA is enabled
+ *
+ * 8. Temporal Accumulation:
+ *    - Render-on-change leaves the GPU idle on still frames; instead each
+ *      such frame runs fractal_accumulate.comp, adding one jittered sample
+ *      per pixel to the accumulation buffer shared with adaptive AA
+ *    - Stops after a fixed number of frames once the image has converged
+ *    - The pass is identical on every still frame: the sequence index comes
+ *      from the per-pixel sample count, so the application records it once
+ *      and resubmits it
+ *
+ * 9. Live Resize:
+ *    - Pipelines and layouts do not depend on the image size; a resize
+ *      only swaps the per-pixel buffers whose size class no longer fits and
+ *      allocates fresh descriptor sets
+ *
+ * 10. Render Extent:
+ *    - Dynamic resolution renders a smaller pixel grid into the full-size
+ *      buffers; the display shader samples only the rendered part
+ *
+ * 11. Background Compilation:
+ *    - Hot-reloads and variant switches compile on PipelineCompiler's
+ *      worker; the render thread keeps dispatching the old pipeline until
+ *      collectCompiledPipelines() swaps the new one in
+ *    - There is no generic fallback shader; a pipeline that was never
+ *      built stays unavailable until its first compile finishes
+ *
+ * 12. Reflection:
+ *    - All kernels share one descriptor set layout and pipeline layout,
+ *      built from the union of their reflected bindings, so one descriptor
+ *      set serves every pass; the layouts belong to ShaderManager's
+ *      LayoutCache
+ *    - Dispatch sizes use each kernel's declared local size, so changing
+ *      local_size in GLSL needs no host change (except mandelbrot_chunk's,
+ *      which the first pass bakes into the indirect arguments)
  *
- * 5. Future Extensions:
+ * 13. Future Extensions:
  *    - Multiple fractal algorithms (Julia, Newton, etc.)
  *    - Multi-precision arithmetic for deep zooms
+ *    - Tiled or progressive dispatch; once a frame has enough tile
+ *      dispatches for recording to show up, record them into secondary
+ *      command buffers from per-thread command pools and execute those
+ *      from the primary (a full render is at most 1 + MAX_CHUNK_PASSES
+ *      dispatches today, cheaper to record than to hand out to threads)
  *    - GPU profiling and optimization features
  *    - Real-time parameter animation system
  */
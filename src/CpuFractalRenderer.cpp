@@ -0,0 +1,109 @@
+/**
+ * @file CpuFractalRenderer.cpp
+ * @brief Implementation of the headless CPU fractal renderer
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#include "CpuFractalRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Pack RGBA components into 0xAABBGGRR (matches packRGBA in GLSL)
+ */
+uint32_t packRGBA(float r, float g, float b, float a) {
+  auto toByte = [](float v) {
+    return static_cast<uint32_t>(std::clamp(v * 255.0f, 0.0f, 255.0f));
+  };
+  return (toByte(a) << 24) | (toByte(b) << 16) | (toByte(g) << 8) | toByte(r);
+}
+
+/**
+ * @brief GLSL fract() equivalent
+ */
+float fract(float x) { return x - std::floor(x); }
+
+} // namespace
+
+CpuFractalRenderer::CpuFractalRenderer(uint32_t maxIterations,
+                                       float colorScale, uint32_t fractalType)
+    : m_maxIterations(maxIterations), m_colorScale(colorScale),
+      m_fractalType(fractalType) {}
+
+void CpuFractalRenderer::renderRegion(double minX, double minY, double spanX,
+                                      double spanY, uint32_t width,
+                                      uint32_t height,
+                                      uint32_t *pixels) const {
+  for (uint32_t y = 0; y < height; y++) {
+    double fy = minY + (static_cast<double>(y) / height) * spanY;
+    for (uint32_t x = 0; x < width; x++) {
+      double fx = minX + (static_cast<double>(x) / width) * spanX;
+      pixels[y * width + x] = iterationsToColor(calculateIterations(fx, fy));
+    }
+  }
+}
+
+uint32_t CpuFractalRenderer::calculateIterations(double fx, double fy) const {
+  double zx = 0.0;
+  double zy = 0.0;
+  double cx = fx;
+  double cy = fy;
+
+  // Julia set iterates from the pixel with a fixed c (same constant as GLSL)
+  if (m_fractalType == 1) {
+    zx = fx;
+    zy = fy;
+    cx = -0.7;
+    cy = 0.27015;
+  }
+
+  for (uint32_t i = 0; i < m_maxIterations; i++) {
+    double zx2 = zx * zx;
+    double zy2 = zy * zy;
+
+    if (zx2 + zy2 > 4.0) {
+      return i;
+    }
+
+    double temp = zx2 - zy2 + cx;
+    if (m_fractalType == 2) {
+      // Burning Ship: z = (|Re(z)| + i|Im(z)|)^2 + c
+      zy = 2.0 * std::abs(zx) * std::abs(zy) + cy;
+    } else {
+      zy = 2.0 * zx * zy + cy;
+    }
+    zx = temp;
+  }
+
+  return m_maxIterations;
+}
+
+uint32_t CpuFractalRenderer::iterationsToColor(uint32_t iterations) const {
+  if (iterations >= m_maxIterations) {
+    return packRGBA(0.0f, 0.0f, 0.0f, 1.0f);
+  }
+
+  float t = static_cast<float>(iterations) / static_cast<float>(m_maxIterations);
+  t = t * m_colorScale;
+
+  float hue = fract(t * 3.0f);
+  float sat = 1.0f;
+  float val = t < 1.0f ? t : 1.0f;
+
+  // hsv2rgb from mandelbrot.comp, expanded per channel
+  const float k[3] = {1.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float rgb[3];
+  for (int c = 0; c < 3; c++) {
+    float p = std::abs(fract(hue + k[c]) * 6.0f - 3.0f);
+    float q = std::clamp(p - 1.0f, 0.0f, 1.0f);
+    rgb[c] = val * (1.0f + (q - 1.0f) * sat);
+  }
+
+  return packRGBA(rgb[0], rgb[1], rgb[2], 1.0f);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file CpuFractalRenderer.h
+ * @brief Headless CPU reference renderer for fractal tiles
+ *
+ * This class renders fractal images on the CPU without a Vulkan device or a
+ * window. It mirrors the math and coloring of shaders/mandelbrot.comp so that
+ * tiles produced offline match what the interactive viewer displays, but it
+ * evaluates in double precision so deep pyramid levels stay sharp.
+ *
+ * Phase 5 Focus:
+ * - Headless rendering for the tile pyramid store
+ * - Pixel-exact coloring parity with the compute shader
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @class CpuFractalRenderer
+ * @brief Renders fractal regions into packed RGBA buffers on the CPU
+ *
+ * The renderer is stateless apart from its coloring parameters, so a single
+ * instance can be shared between threads and called concurrently.
+ */
+class CpuFractalRenderer {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param maxIterations Maximum iterations for the escape-time test
+   * @param colorScale Scale factor for color mapping
+   * @param fractalType Fractal type (0=Mandelbrot, 1=Julia, 2=Burning Ship)
+   */
+  CpuFractalRenderer(uint32_t maxIterations, float colorScale,
+                     uint32_t fractalType);
+
+  /**
+   * @brief Render a rectangular region of the complex plane
+   *
+   * Pixel (0, 0) maps to (minX, minY); rows advance along +Y exactly like the
+   * compute shader's pixel mapping.
+   *
+   * @param minX Real coordinate of the left edge
+   * @param minY Imaginary coordinate of the top edge
+   * @param spanX Width of the region in fractal units
+   * @param spanY Height of the region in fractal units
+   * @param width Output width in pixels
+   * @param height Output height in pixels
+   * @param pixels Destination buffer of width * height packed RGBA values
+   */
+  void renderRegion(double minX, double minY, double spanX, double spanY,
+                    uint32_t width, uint32_t height, uint32_t *pixels) const;
+
+  /**
+   * @brief Get the maximum iteration count
+   * @return Maximum iterations used by the escape-time test
+   */
+  uint32_t getMaxIterations() const { return m_maxIterations; }
+
+  /**
+   * @brief Get the color scale factor
+   * @return Color scale used for the HSV gradient
+   */
+  float getColorScale() const { return m_colorScale; }
+
+  /**
+   * @brief Get the fractal type
+   * @return Fractal type index
+   */
+  uint32_t getFractalType() const { return m_fractalType; }
+
+private:
+  /**
+   * @brief Calculate escape iterations for a point
+   *
+   * @param fx X coordinate in fractal space
+   * @param fy Y coordinate in fractal space
+   * @return Number of iterations before escape (0 to maxIterations)
+   */
+  uint32_t calculateIterations(double fx, double fy) const;
+
+  /**
+   * @brief Map an iteration count to a packed RGBA color
+   *
+   * @param iterations Number of iterations before escape
+   * @return Color packed as 0xAABBGGRR
+   */
+  uint32_t iterationsToColor(uint32_t iterations) const;
+
+  uint32_t m_maxIterations;
+  float m_colorScale;
+  uint32_t m_fractalType;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Shader Parity:
+ *    - Same escape radius, Julia constant and HSV gradient as mandelbrot.comp
+ *    - Same 0xAABBGGRR packing so tiles can be uploaded as R8G8B8A8 textures
+ *
+ * 2. Precision:
+ *    - Doubles instead of floats; the shader's float path loses detail long
+ *      before the deepest pyramid levels are reached
+ */
@@ -0,0 +1,72 @@
+/**
+ * @file DeletionQueue.cpp
+ * @brief Implementation of the frame-tagged deletion queue
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "DeletionQueue.h"
+
+#include <vector>
+
+DeletionQueue::~DeletionQueue() { flush(); }
+
+void DeletionQueue::beginFrame(uint64_t frame) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (frame > m_currentFrame) {
+    m_currentFrame = frame;
+  }
+}
+
+void DeletionQueue::enqueue(Deleter deleter) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.push_back({m_currentFrame, std::move(deleter)});
+}
+
+size_t DeletionQueue::retire(uint64_t completedFrame) {
+  // Deleters may enqueue further work or take other locks, so run them
+  // after releasing ours
+  std::vector<Deleter> ready;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_entries.empty() && m_entries.front().frame <= completedFrame) {
+      ready.push_back(std::move(m_entries.front().deleter));
+      m_entries.pop_front();
+    }
+  }
+
+  for (Deleter &deleter : ready) {
+    deleter();
+  }
+  return ready.size();
+}
+
+void DeletionQueue::flush() {
+  // Deleters can retire more resources (a view retiring its image), so loop
+  // until nothing is left
+  for (;;) {
+    std::deque<Entry> entries;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      entries.swap(m_entries);
+    }
+    if (entries.empty()) {
+      return;
+    }
+    for (Entry &entry : entries) {
+      entry.deleter();
+    }
+  }
+}
+
+uint64_t DeletionQueue::getCurrentFrame() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_currentFrame;
+}
+
+size_t DeletionQueue::getPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
@@ -0,0 +1,128 @@
+/**
+ * @file DeletionQueue.h
+ * @brief Deferred destruction of GPU resources tied to frame completion
+ *
+ * Resources replaced while earlier frames may still be executing (resized
+ * buffers, rebuilt pipelines, stale descriptor sets) are handed to this
+ * queue instead of being destroyed on the spot. Each entry is tagged with
+ * the frame that was being recorded when it was retired, and runs once the
+ * application reports that frame as completed by the GPU.
+ *
+ * Phase 5 Focus:
+ * - Resize and pipeline rebuilds without vkDeviceWaitIdle
+ * - One place that knows when the GPU is done with a frame
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/**
+ * @class DeletionQueue
+ * @brief FIFO of destruction callbacks keyed by frame number
+ *
+ * Frame numbers increase monotonically. beginFrame() marks the frame being
+ * recorded; enqueue() tags a deleter with it; retire() runs every deleter
+ * whose frame is at or below the last completed frame. Since tags never
+ * decrease, retiring only ever pops from the front.
+ *
+ * Thread-safe: deleters may be enqueued from any thread. They always run on
+ * the thread that calls retire() or flush(), outside the queue's lock.
+ */
+class DeletionQueue {
+public:
+  /**
+   * @brief Function that destroys one or more resources
+   */
+  using Deleter = std::function<void()>;
+
+  DeletionQueue() = default;
+
+  /**
+   * @brief Destructor - run every pending deleter
+   *
+   * Owners must make sure the device is idle first.
+   */
+  ~DeletionQueue();
+
+  // Disable copy and move for simplicity
+  DeletionQueue(const DeletionQueue &) = delete;
+  DeletionQueue &operator=(const DeletionQueue &) = delete;
+  DeletionQueue(DeletionQueue &&) = delete;
+  DeletionQueue &operator=(DeletionQueue &&) = delete;
+
+  /**
+   * @brief Set the frame whose commands are being recorded
+   *
+   * @param frame Frame number; must not be lower than the previous one
+   */
+  void beginFrame(uint64_t frame);
+
+  /**
+   * @brief Defer a deleter until the current frame has completed
+   *
+   * @param deleter Function destroying resources the current or an earlier
+   *        frame may still use
+   */
+  void enqueue(Deleter deleter);
+
+  /**
+   * @brief Run the deleters of every completed frame
+   *
+   * @param completedFrame Highest frame known to have finished on the GPU
+   * @return Number of deleters run
+   */
+  size_t retire(uint64_t completedFrame);
+
+  /**
+   * @brief Run every pending deleter regardless of its frame
+   *
+   * Only valid once the device is idle (shutdown, device loss).
+   */
+  void flush();
+
+  /**
+   * @brief Get the frame deleters are currently tagged with
+   * @return Current frame number
+   */
+  uint64_t getCurrentFrame() const;
+
+  /**
+   * @brief Get the number of deleters waiting for their frame
+   * @return Pending deleter count
+   */
+  size_t getPendingCount() const;
+
+private:
+  struct Entry {
+    uint64_t frame;
+    Deleter deleter;
+  };
+
+  mutable std::mutex m_mutex;
+  std::deque<Entry> m_entries;
+  uint64_t m_currentFrame = 0;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Frame Tags:
+ *    - A resource may be referenced by anything recorded up to and including
+ *      the frame during which it was retired, so that frame's completion is
+ *      the earliest safe point to destroy it
+ *    - Work submitted outside the frame loop (one-shot uploads) completes
+ *      before the next frame fence signals, as both use the same queues
+ *
+ * 2. Ordering:
+ *    - Deleters of one frame run in enqueue order, so a deleter may rely on
+ *      resources retired before it still existing (e.g. a view before its
+ *      image)
+ */
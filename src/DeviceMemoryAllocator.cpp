@@ -0,0 +1,429 @@
+/**
+ * @file DeviceMemoryAllocator.cpp
+ * @brief Implementation of the pooled device memory sub-allocator
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "DeviceMemoryAllocator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Smallest buddy region; also the smallest reservation for any resource
+constexpr VkDeviceSize MIN_REGION_SIZE = 256;
+
+// Block size for large heaps; small heaps get an eighth of their size
+constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+constexpr VkDeviceSize MIN_BLOCK_SIZE = 1ull * 1024 * 1024;
+
+VkDeviceSize nextPowerOfTwo(VkDeviceSize value) {
+  VkDeviceSize result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+VkDeviceSize previousPowerOfTwo(VkDeviceSize value) {
+  VkDeviceSize result = 1;
+  while (result <= value / 2) {
+    result <<= 1;
+  }
+  return result;
+}
+
+uint32_t orderForSize(VkDeviceSize regionSize) {
+  uint32_t order = 0;
+  while ((MIN_REGION_SIZE << order) < regionSize) {
+    order++;
+  }
+  return order;
+}
+
+} // namespace
+
+DeviceMemoryAllocator::DeviceMemoryAllocator(VkDevice device,
+                                             VkPhysicalDevice physicalDevice)
+    : m_device(device), m_nonCoherentAtomSize(1), m_dedicatedBytes(0),
+      m_allocationCount(0) {
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+  m_heapUsage.resize(m_memoryProperties.memoryHeapCount, 0);
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+  m_nonCoherentAtomSize =
+      std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+
+  std::cout << "[DeviceMemoryAllocator] Initialized (max allocations: "
+            << properties.limits.maxMemoryAllocationCount
+            << ", buffer/image granularity: "
+            << properties.limits.bufferImageGranularity << " bytes)"
+            << std::endl;
+}
+
+DeviceMemoryAllocator::~DeviceMemoryAllocator() {
+  if (m_allocationCount > 0) {
+    std::cerr << "[DeviceMemoryAllocator] " << m_allocationCount
+              << " allocations still live at shutdown" << std::endl;
+  }
+
+  for (uint32_t i = 0; i < m_blocks.size(); i++) {
+    if (m_blocks[i]) {
+      destroyBlock(i);
+    }
+  }
+  for (const auto &[memory, mappedData] : m_dedicatedAllocations) {
+    vkFreeMemory(m_device, memory, nullptr);
+  }
+}
+
+DeviceAllocation
+DeviceMemoryAllocator::allocate(const VkMemoryRequirements &requirements,
+                                uint32_t memoryTypeIndex, ResourceKind kind) {
+  VkMemoryPropertyFlags flags =
+      m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
+
+  // Non-coherent ranges are flushed in whole atoms; keep atoms private
+  VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+  if ((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) &&
+      !(flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+    alignment = std::max(alignment, m_nonCoherentAtomSize);
+  }
+
+  // Buddy offsets are multiples of the region size, so rounding the size up
+  // to a power of two no smaller than the alignment aligns the region too
+  VkDeviceSize regionSize = nextPowerOfTwo(
+      std::max({requirements.size, alignment, MIN_REGION_SIZE}));
+  VkDeviceSize blockSize = blockSizeForType(memoryTypeIndex);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  DeviceAllocation allocation;
+  allocation.memoryTypeIndex = memoryTypeIndex;
+
+  // Oversized resources get their own memory object
+  if (regionSize > blockSize / 2) {
+    void *mappedData = nullptr;
+    allocation.memory =
+        allocateDeviceMemory(memoryTypeIndex, requirements.size, &mappedData);
+    allocation.size = requirements.size;
+    m_dedicatedAllocations[allocation.memory] = mappedData;
+    m_dedicatedBytes += requirements.size;
+    m_allocationCount++;
+    return allocation;
+  }
+
+  uint32_t order = orderForSize(regionSize);
+  for (uint32_t i = 0; i < m_blocks.size(); i++) {
+    MemoryBlock *block = m_blocks[i].get();
+    if (!block || block->memoryTypeIndex != memoryTypeIndex ||
+        block->kind != kind) {
+      continue;
+    }
+    int64_t offset = allocateFromBlock(*block, order);
+    if (offset >= 0) {
+      allocation.memory = block->memory;
+      allocation.offset = static_cast<VkDeviceSize>(offset);
+      allocation.size = regionSize;
+      allocation.blockIndex = static_cast<int32_t>(i);
+      m_allocationCount++;
+      return allocation;
+    }
+  }
+
+  // No room anywhere: open a new block, which always fits the request
+  uint32_t blockIndex = createBlock(memoryTypeIndex, kind, blockSize);
+  int64_t offset = allocateFromBlock(*m_blocks[blockIndex], order);
+  allocation.memory = m_blocks[blockIndex]->memory;
+  allocation.offset = static_cast<VkDeviceSize>(offset);
+  allocation.size = regionSize;
+  allocation.blockIndex = static_cast<int32_t>(blockIndex);
+  m_allocationCount++;
+  return allocation;
+}
+
+void DeviceMemoryAllocator::free(const DeviceAllocation &allocation) {
+  if (allocation.memory == VK_NULL_HANDLE) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (allocation.blockIndex < 0) {
+    auto it = m_dedicatedAllocations.find(allocation.memory);
+    if (it != m_dedicatedAllocations.end()) {
+      vkFreeMemory(m_device, allocation.memory, nullptr);
+      m_dedicatedAllocations.erase(it);
+      m_dedicatedBytes -= allocation.size;
+      m_heapUsage[m_memoryProperties.memoryTypes[allocation.memoryTypeIndex]
+                      .heapIndex] -= allocation.size;
+      m_allocationCount--;
+    }
+    return;
+  }
+
+  MemoryBlock &block = *m_blocks[allocation.blockIndex];
+  auto it = block.allocatedOrders.find(allocation.offset);
+  if (it == block.allocatedOrders.end()) {
+    std::cerr << "[DeviceMemoryAllocator] Double free at offset "
+              << allocation.offset << std::endl;
+    return;
+  }
+
+  uint32_t order = it->second;
+  block.allocatedOrders.erase(it);
+  block.usedBytes -= MIN_REGION_SIZE << order;
+  m_allocationCount--;
+
+  // Merge with free buddies as far up as possible
+  VkDeviceSize offset = allocation.offset;
+  uint32_t maxOrder = static_cast<uint32_t>(block.freeLists.size()) - 1;
+  while (order < maxOrder) {
+    VkDeviceSize buddy = offset ^ (MIN_REGION_SIZE << order);
+    if (block.freeLists[order].erase(buddy) == 0) {
+      break;
+    }
+    offset = std::min(offset, buddy);
+    order++;
+  }
+  block.freeLists[order].insert(offset);
+
+  // Keep one empty block per type and kind around for the next resize
+  if (block.usedBytes == 0) {
+    for (uint32_t i = 0; i < m_blocks.size(); i++) {
+      const MemoryBlock *other = m_blocks[i].get();
+      if (other && other != &block && other->usedBytes == 0 &&
+          other->memoryTypeIndex == block.memoryTypeIndex &&
+          other->kind == block.kind) {
+        destroyBlock(static_cast<uint32_t>(allocation.blockIndex));
+        break;
+      }
+    }
+  }
+}
+
+void *DeviceMemoryAllocator::map(const DeviceAllocation &allocation) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  void *base = nullptr;
+  if (allocation.blockIndex < 0) {
+    auto it = m_dedicatedAllocations.find(allocation.memory);
+    base = it != m_dedicatedAllocations.end() ? it->second : nullptr;
+  } else {
+    base = m_blocks[allocation.blockIndex]->mappedData;
+  }
+
+  if (!base) {
+    throw std::runtime_error("Allocation is not in host-visible memory");
+  }
+  return static_cast<uint8_t *>(base) + allocation.offset;
+}
+
+void DeviceMemoryAllocator::flush(const DeviceAllocation &allocation,
+                                  VkDeviceSize offset, VkDeviceSize size) {
+  if (getMemoryProperties(allocation) & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+    return;
+  }
+  VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+  vkFlushMappedMemoryRanges(m_device, 1, &range);
+}
+
+void DeviceMemoryAllocator::invalidate(const DeviceAllocation &allocation,
+                                       VkDeviceSize offset,
+                                       VkDeviceSize size) {
+  if (getMemoryProperties(allocation) & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+    return;
+  }
+  VkMappedMemoryRange range = mappedRange(allocation, offset, size);
+  vkInvalidateMappedMemoryRanges(m_device, 1, &range);
+}
+
+VkMemoryPropertyFlags DeviceMemoryAllocator::getMemoryProperties(
+    const DeviceAllocation &allocation) const {
+  return m_memoryProperties.memoryTypes[allocation.memoryTypeIndex]
+      .propertyFlags;
+}
+
+DeviceMemoryStats DeviceMemoryAllocator::getStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  DeviceMemoryStats stats;
+  stats.dedicatedCount = static_cast<uint32_t>(m_dedicatedAllocations.size());
+  stats.allocationCount = m_allocationCount;
+  stats.reservedBytes = m_dedicatedBytes;
+  stats.usedBytes = m_dedicatedBytes;
+
+  for (const auto &block : m_blocks) {
+    if (!block) {
+      continue;
+    }
+    stats.blockCount++;
+    stats.reservedBytes += block->size;
+    stats.usedBytes += block->usedBytes;
+    for (uint32_t order = static_cast<uint32_t>(block->freeLists.size());
+         order-- > 0;) {
+      if (!block->freeLists[order].empty()) {
+        stats.largestFreeBytes =
+            std::max(stats.largestFreeBytes, MIN_REGION_SIZE << order);
+        break;
+      }
+    }
+  }
+  return stats;
+}
+
+VkDeviceSize DeviceMemoryAllocator::getHeapUsage(uint32_t heapIndex) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return heapIndex < m_heapUsage.size() ? m_heapUsage[heapIndex] : 0;
+}
+
+VkDeviceSize DeviceMemoryAllocator::releaseEmptyBlocks() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  VkDeviceSize released = 0;
+  for (uint32_t i = 0; i < m_blocks.size(); i++) {
+    if (m_blocks[i] && m_blocks[i]->usedBytes == 0) {
+      released += m_blocks[i]->size;
+      destroyBlock(i);
+    }
+  }
+  return released;
+}
+
+VkDeviceSize
+DeviceMemoryAllocator::blockSizeForType(uint32_t memoryTypeIndex) const {
+  uint32_t heapIndex = m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+  VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[heapIndex].size;
+  return std::clamp(previousPowerOfTwo(heapSize / 8), MIN_BLOCK_SIZE,
+                    DEFAULT_BLOCK_SIZE);
+}
+
+uint32_t DeviceMemoryAllocator::createBlock(uint32_t memoryTypeIndex,
+                                            ResourceKind kind,
+                                            VkDeviceSize size) {
+  auto block = std::make_unique<MemoryBlock>();
+  block->memory = allocateDeviceMemory(memoryTypeIndex, size,
+                                       &block->mappedData);
+  block->size = size;
+  block->memoryTypeIndex = memoryTypeIndex;
+  block->kind = kind;
+
+  uint32_t maxOrder = orderForSize(size);
+  block->freeLists.resize(maxOrder + 1);
+  block->freeLists[maxOrder].insert(0);
+
+  std::cout << "[DeviceMemoryAllocator] New " << (size / (1024 * 1024))
+            << " MB block for memory type " << memoryTypeIndex
+            << (kind == ResourceKind::OPTIMAL ? " (images)" : " (buffers)")
+            << std::endl;
+
+  // Reuse a slot freed earlier so live block indices stay stable
+  for (uint32_t i = 0; i < m_blocks.size(); i++) {
+    if (!m_blocks[i]) {
+      m_blocks[i] = std::move(block);
+      return i;
+    }
+  }
+  m_blocks.push_back(std::move(block));
+  return static_cast<uint32_t>(m_blocks.size() - 1);
+}
+
+void DeviceMemoryAllocator::destroyBlock(uint32_t blockIndex) {
+  const MemoryBlock &block = *m_blocks[blockIndex];
+  m_heapUsage[m_memoryProperties.memoryTypes[block.memoryTypeIndex]
+                  .heapIndex] -= block.size;
+
+  // Freeing the memory implicitly unmaps it
+  vkFreeMemory(m_device, block.memory, nullptr);
+  m_blocks[blockIndex].reset();
+}
+
+int64_t DeviceMemoryAllocator::allocateFromBlock(MemoryBlock &block,
+                                                 uint32_t order) {
+  // Smallest free region that fits
+  uint32_t available = order;
+  while (available < block.freeLists.size() &&
+         block.freeLists[available].empty()) {
+    available++;
+  }
+  if (available >= block.freeLists.size()) {
+    return -1;
+  }
+
+  auto first = block.freeLists[available].begin();
+  VkDeviceSize offset = *first;
+  block.freeLists[available].erase(first);
+
+  // Split down to the requested order, freeing the upper halves
+  while (available > order) {
+    available--;
+    block.freeLists[available].insert(offset +
+                                      (MIN_REGION_SIZE << available));
+  }
+
+  block.allocatedOrders[offset] = order;
+  block.usedBytes += MIN_REGION_SIZE << order;
+  return static_cast<int64_t>(offset);
+}
+
+VkDeviceMemory
+DeviceMemoryAllocator::allocateDeviceMemory(uint32_t memoryTypeIndex,
+                                            VkDeviceSize size,
+                                            void **mappedData) {
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = size;
+  allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+  VkDeviceMemory memory;
+  VkResult result = vkAllocateMemory(m_device, &allocInfo, nullptr, &memory);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to allocate device memory block! Vulkan error: " +
+        std::to_string(result));
+  }
+
+  *mappedData = nullptr;
+  if (m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+    result = vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, mappedData);
+    if (result != VK_SUCCESS) {
+      vkFreeMemory(m_device, memory, nullptr);
+      throw std::runtime_error(
+          "Failed to map device memory block! Vulkan error: " +
+          std::to_string(result));
+    }
+  }
+
+  m_heapUsage[m_memoryProperties.memoryTypes[memoryTypeIndex].heapIndex] +=
+      size;
+  return memory;
+}
+
+VkMappedMemoryRange
+DeviceMemoryAllocator::mappedRange(const DeviceAllocation &allocation,
+                                   VkDeviceSize offset,
+                                   VkDeviceSize size) const {
+  // Round out to whole atoms; the allocation itself is atom aligned
+  VkDeviceSize begin = allocation.offset + offset;
+  VkDeviceSize end = begin + size;
+  begin -= begin % m_nonCoherentAtomSize;
+  end = std::min(
+      (end + m_nonCoherentAtomSize - 1) / m_nonCoherentAtomSize *
+          m_nonCoherentAtomSize,
+      allocation.offset + allocation.size);
+
+  VkMappedMemoryRange range{};
+  range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+  range.memory = allocation.memory;
+  range.offset = begin;
+  range.size = end - begin;
+  return range;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file DeviceMemoryAllocator.h
+ * @brief Pooled device memory sub-allocator
+ *
+ * This class replaces one vkAllocateMemory call per resource with a few
+ * large memory blocks per memory type. Buffers and images are placed into
+ * those blocks by a buddy allocator, so the number of live Vulkan
+ * allocations stays small no matter how many resources are created.
+ *
+ * Phase 5 Focus:
+ * - Stay far below maxMemoryAllocationCount
+ * - Cheap resource creation when resizing or multi-buffering
+ * - Visible memory statistics for the metrics panel
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @enum ResourceKind
+ * @brief Tiling class of a resource, used to honour bufferImageGranularity
+ */
+enum class ResourceKind {
+  LINEAR, ///< Buffers and linear-tiling images
+  OPTIMAL ///< Optimal-tiling images
+};
+
+/**
+ * @struct DeviceAllocation
+ * @brief A region of device memory handed out by DeviceMemoryAllocator
+ */
+struct DeviceAllocation {
+  VkDeviceMemory memory = VK_NULL_HANDLE; ///< Backing memory object
+  VkDeviceSize offset = 0;                ///< Offset of the region in memory
+  VkDeviceSize size = 0;                  ///< Size reserved for the region
+  uint32_t memoryTypeIndex = 0;           ///< Memory type of the block
+  int32_t blockIndex = -1;                ///< Owning block, -1 for dedicated
+};
+
+/**
+ * @struct DeviceMemoryStats
+ * @brief Snapshot of the allocator's bookkeeping
+ */
+struct DeviceMemoryStats {
+  uint32_t blockCount = 0;           ///< Pooled blocks currently allocated
+  uint32_t dedicatedCount = 0;       ///< Oversized dedicated allocations
+  uint32_t allocationCount = 0;      ///< Live allocations (incl. dedicated)
+  VkDeviceSize reservedBytes = 0;    ///< Device memory held from the driver
+  VkDeviceSize usedBytes = 0;        ///< Bytes handed out to resources
+  VkDeviceSize largestFreeBytes = 0; ///< Largest free region in any block
+};
+
+/**
+ * @class DeviceMemoryAllocator
+ * @brief Buddy allocator over large per-memory-type blocks
+ *
+ * Each block is a power-of-two sized VkDeviceMemory. A request is rounded up
+ * to a power of two no smaller than its alignment, so the natural alignment
+ * of buddy offsets satisfies every VkMemoryRequirements::alignment. Linear
+ * and optimal resources never share a block, which makes
+ * bufferImageGranularity irrelevant. Requests larger than half a block get a
+ * dedicated allocation.
+ *
+ * Host-visible blocks are mapped once for their whole lifetime; individual
+ * resources receive a pointer into that mapping, since Vulkan forbids
+ * mapping the same memory object twice.
+ */
+class DeviceMemoryAllocator {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param device Vulkan logical device
+   * @param physicalDevice Physical device for memory properties and limits
+   */
+  DeviceMemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice);
+
+  /**
+   * @brief Destructor - free all blocks
+   */
+  ~DeviceMemoryAllocator();
+
+  // Disable copy and move for simplicity
+  DeviceMemoryAllocator(const DeviceMemoryAllocator &) = delete;
+  DeviceMemoryAllocator &operator=(const DeviceMemoryAllocator &) = delete;
+  DeviceMemoryAllocator(DeviceMemoryAllocator &&) = delete;
+  DeviceMemoryAllocator &operator=(DeviceMemoryAllocator &&) = delete;
+
+  /**
+   * @brief Allocate memory for a resource
+   *
+   * @param requirements Memory requirements of the resource
+   * @param memoryTypeIndex Memory type to allocate from
+   * @param kind Tiling class of the resource
+   * @return Allocation to bind the resource to
+   *
+   * @throws std::runtime_error If device memory is exhausted
+   */
+  DeviceAllocation allocate(const VkMemoryRequirements &requirements,
+                            uint32_t memoryTypeIndex, ResourceKind kind);
+
+  /**
+   * @brief Return an allocation to its block
+   *
+   * @param allocation Allocation previously returned by allocate()
+   */
+  void free(const DeviceAllocation &allocation);
+
+  /**
+   * @brief Get a host pointer to an allocation
+   *
+   * @param allocation Allocation in host-visible memory
+   * @return Pointer to the start of the allocation
+   *
+   * @throws std::runtime_error If the memory is not host-visible
+   */
+  void *map(const DeviceAllocation &allocation);
+
+  /**
+   * @brief Flush host writes if the memory type is not coherent
+   *
+   * @param allocation Written allocation
+   * @param offset Offset of the written range within the allocation
+   * @param size Size of the written range
+   */
+  void flush(const DeviceAllocation &allocation, VkDeviceSize offset,
+             VkDeviceSize size);
+
+  /**
+   * @brief Invalidate host caches if the memory type is not coherent
+   *
+   * @param allocation Allocation about to be read
+   * @param offset Offset of the range within the allocation
+   * @param size Size of the range
+   */
+  void invalidate(const DeviceAllocation &allocation, VkDeviceSize offset,
+                  VkDeviceSize size);
+
+  /**
+   * @brief Get the property flags of an allocation's memory type
+   *
+   * @param allocation Allocation to query
+   * @return Memory property flags
+   */
+  VkMemoryPropertyFlags
+  getMemoryProperties(const DeviceAllocation &allocation) const;
+
+  /**
+   * @brief Get current allocator statistics
+   *
+   * @return Statistics snapshot
+   */
+  DeviceMemoryStats getStats() const;
+
+  /**
+   * @brief Get the device memory held from one heap
+   *
+   * Counts whole blocks and dedicated allocations, i.e. what the driver
+   * sees, not what has been handed out to resources.
+   *
+   * @param heapIndex Memory heap to query
+   * @return Bytes allocated from the heap
+   */
+  VkDeviceSize getHeapUsage(uint32_t heapIndex) const;
+
+  /**
+   * @brief Free every block that holds no allocations
+   *
+   * Drops the spare blocks kept around for resizing; used under memory
+   * pressure.
+   *
+   * @return Bytes returned to the driver
+   */
+  VkDeviceSize releaseEmptyBlocks();
+
+private:
+  /**
+   * @struct MemoryBlock
+   * @brief One large VkDeviceMemory and its buddy free lists
+   */
+  struct MemoryBlock {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    uint32_t memoryTypeIndex = 0;
+    ResourceKind kind = ResourceKind::LINEAR;
+    void *mappedData = nullptr;
+    VkDeviceSize usedBytes = 0;
+
+    /// Free region offsets per order (region size = MIN_REGION_SIZE << order)
+    std::vector<std::set<VkDeviceSize>> freeLists;
+
+    /// Order of every allocated region, keyed by offset
+    std::unordered_map<VkDeviceSize, uint32_t> allocatedOrders;
+  };
+
+  /**
+   * @brief Pick the block size for a memory type
+   */
+  VkDeviceSize blockSizeForType(uint32_t memoryTypeIndex) const;
+
+  /**
+   * @brief Allocate a new block (reusing an empty slot if possible)
+   *
+   * @return Index of the new block
+   */
+  uint32_t createBlock(uint32_t memoryTypeIndex, ResourceKind kind,
+                       VkDeviceSize size);
+
+  /**
+   * @brief Release a block's memory and mark its slot empty
+   */
+  void destroyBlock(uint32_t blockIndex);
+
+  /**
+   * @brief Carve a region of the given order out of a block
+   *
+   * @return Offset of the region, or -1 if the block has no room
+   */
+  int64_t allocateFromBlock(MemoryBlock &block, uint32_t order);
+
+  /**
+   * @brief Allocate raw device memory and map it if host-visible
+   */
+  VkDeviceMemory allocateDeviceMemory(uint32_t memoryTypeIndex,
+                                      VkDeviceSize size, void **mappedData);
+
+  /**
+   * @brief Build an atom-aligned range for flush/invalidate
+   */
+  VkMappedMemoryRange mappedRange(const DeviceAllocation &allocation,
+                                  VkDeviceSize offset,
+                                  VkDeviceSize size) const;
+
+  VkDevice m_device;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties;
+  VkDeviceSize m_nonCoherentAtomSize;
+
+  std::vector<std::unique_ptr<MemoryBlock>> m_blocks; ///< nullptr = free slot
+  std::unordered_map<VkDeviceMemory, void *>
+      m_dedicatedAllocations; ///< Dedicated memory and its mapping
+  VkDeviceSize m_dedicatedBytes;
+  uint32_t m_allocationCount;
+  std::vector<VkDeviceSize> m_heapUsage; ///< Bytes allocated per heap
+
+  mutable std::mutex m_mutex; ///< Guards all bookkeeping
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Buddy Allocation:
+ *    - Regions are MIN_REGION_SIZE << order bytes; splitting and merging
+ *      are O(log block size) set operations
+ *    - Internal fragmentation is at most 2x per resource, which is fine for
+ *      the handful of large, power-of-two-ish buffers this app creates
+ *
+ * 2. Block Lifetime:
+ *    - One empty block per memory type and kind is kept to absorb
+ *      create/destroy cycles such as resizing; further empty blocks are freed
+ *    - releaseEmptyBlocks() drops the spares too when memory runs low
+ *
+ * 3. Coherency:
+ *    - Allocations in non-coherent memory are aligned to nonCoherentAtomSize
+ *      so flush and invalidate ranges never touch a neighbouring resource
+ */
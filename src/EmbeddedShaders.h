@@ -0,0 +1,53 @@
+/**
+ * @file EmbeddedShaders.h
+ * @brief SPIR-V compiled at build time and linked into the binary
+ *
+ * CMake compiles every shader variant listed with fractal_embed_shader()
+ * through glslc and generates EmbeddedShaders.cpp, which holds the code as
+ * constexpr arrays. ShaderManager uses these before it reads or compiles
+ * any source, so deployed binaries need neither shaderc nor the shaders
+ * directory at startup.
+ *
+ * Phase 5 Focus:
+ * - Fast startup without runtime shader compilation
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct EmbeddedShader
+ * @brief One build-time compiled shader variant
+ */
+struct EmbeddedShader {
+  const char *key;      ///< Source path, then "|NAME=VALUE" per define
+  const uint32_t *code; ///< SPIR-V words
+  size_t wordCount;     ///< Number of SPIR-V words
+};
+
+namespace EmbeddedShaders {
+
+/**
+ * @brief Find an embedded shader variant
+ *
+ * @param key Source path relative to the project root (e.g.
+ *            "shaders/mandelbrot.comp"), then "|NAME=VALUE" for each define
+ * @return Shader, or nullptr if it was not embedded
+ */
+const EmbeddedShader *find(const std::string &key);
+
+/**
+ * @brief Get the number of embedded shader variants
+ *
+ * @return 0 when the build had no glslc or disabled embedding
+ */
+size_t count();
+
+} // namespace EmbeddedShaders
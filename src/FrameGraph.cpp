@@ -0,0 +1,436 @@
+/**
+ * @file FrameGraph.cpp
+ * @brief Implementation of pass scheduling and barrier derivation
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "FrameGraph.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+FrameGraph::FrameGraph(VkDevice device, VkQueue computeQueue,
+                       VkQueue graphicsQueue, bool timelineSemaphores)
+    : m_device(device), m_timelineSemaphores(timelineSemaphores),
+      m_getSemaphoreCounterValue(nullptr), m_waitSemaphores(nullptr) {
+  queueState(QueueType::COMPUTE).queue = computeQueue;
+  queueState(QueueType::GRAPHICS).queue = graphicsQueue;
+
+  if (m_timelineSemaphores) {
+    m_getSemaphoreCounterValue =
+        reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+            vkGetDeviceProcAddr(m_device, "vkGetSemaphoreCounterValueKHR"));
+    m_waitSemaphores = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+        vkGetDeviceProcAddr(m_device, "vkWaitSemaphoresKHR"));
+    m_timelineSemaphores = m_getSemaphoreCounterValue && m_waitSemaphores;
+  }
+
+  if (m_timelineSemaphores) {
+    VkSemaphoreTypeCreateInfoKHR timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+    timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+    timelineInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &timelineInfo;
+
+    for (QueueState &state : m_queues) {
+      VkResult result = vkCreateSemaphore(m_device, &semaphoreInfo, nullptr,
+                                          &state.timeline);
+      if (result != VK_SUCCESS) {
+        throw std::runtime_error(
+            "Failed to create timeline semaphore! Vulkan error: " +
+            std::to_string(result));
+      }
+    }
+  }
+
+  std::cout << "[FrameGraph] Cross-queue dependencies use "
+            << (m_timelineSemaphores ? "timeline semaphores" : "queue waits")
+            << (computeQueue == graphicsQueue ? " (single queue)" : "")
+            << std::endl;
+}
+
+FrameGraph::~FrameGraph() {
+  for (QueueState &state : m_queues) {
+    if (state.timeline != VK_NULL_HANDLE) {
+      vkDestroySemaphore(m_device, state.timeline, nullptr);
+    }
+  }
+}
+
+uint32_t FrameGraph::addBuffer(const std::string &name) {
+  Resource resource;
+  resource.name = name;
+  m_resources.push_back(resource);
+  return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+uint32_t FrameGraph::addImage(const std::string &name) {
+  Resource resource;
+  resource.name = name;
+  resource.isImage = true;
+  m_resources.push_back(resource);
+  return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+void FrameGraph::setBuffer(uint32_t resource, VkBuffer buffer) {
+  Resource &tracked = m_resources.at(resource);
+  if (tracked.buffer == buffer) {
+    return;
+  }
+
+  Resource fresh;
+  fresh.name = tracked.name;
+  fresh.buffer = buffer;
+  tracked = fresh;
+}
+
+void FrameGraph::setImage(uint32_t resource, VkImage image) {
+  Resource &tracked = m_resources.at(resource);
+  if (tracked.image == image) {
+    return;
+  }
+
+  Resource fresh;
+  fresh.name = tracked.name;
+  fresh.isImage = true;
+  fresh.image = image;
+  tracked = fresh;
+}
+
+uint32_t FrameGraph::addPass(const std::string &name, QueueType queue,
+                             std::vector<ResourceUse> uses) {
+  for (const ResourceUse &use : uses) {
+    if (use.resource >= m_resources.size()) {
+      throw std::invalid_argument("Pass '" + name +
+                                  "' uses an undeclared resource");
+    }
+  }
+
+  m_passes.push_back({name, queue, std::move(uses)});
+  return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+const FrameGraph::PassBarriers &FrameGraph::beginPass(uint32_t pass) {
+  const Pass &declared = m_passes.at(pass);
+  QueueType queue = declared.queue;
+  size_t queueIndex = static_cast<size_t>(queue);
+
+  // Everything collected for this queue is signalled by its next submit
+  uint64_t value = queueState(queue).submittedValue + 1;
+
+  m_barriers = PassBarriers{};
+  for (const ResourceUse &use : declared.uses) {
+    Resource &resource = m_resources[use.resource];
+    AccessInfo info = accessInfo(use.access);
+    bool transition = resource.isImage && resource.layout != info.layout;
+    bool write = info.write || transition;
+
+    VkPipelineStageFlags srcStages = 0;
+    VkAccessFlags srcAccess = 0;
+    bool waited = false;
+
+    // Read after write (unless an earlier read here already waited for
+    // it) and write after write
+    bool readSynchronized =
+        !write && resource.readValues[queueIndex] != 0 &&
+        (resource.readStages[queueIndex] & info.stage) == info.stage;
+    if (!readSynchronized) {
+      dependOn(queue, info.stage, resource.writeQueue, resource.writeValue,
+               resource.writeStages, resource.writeAccess, srcStages,
+               srcAccess, waited);
+    }
+
+    // Write after read needs only execution order
+    if (write) {
+      for (size_t i = 0; i < QUEUE_COUNT; i++) {
+        dependOn(queue, info.stage, static_cast<QueueType>(i),
+                 resource.readValues[i], resource.readStages[i], 0, srcStages,
+                 srcAccess, waited);
+      }
+    }
+
+    if (transition) {
+      VkImageMemoryBarrier barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask = srcAccess;
+      barrier.dstAccessMask = info.access;
+      barrier.oldLayout =
+          use.discard ? VK_IMAGE_LAYOUT_UNDEFINED : resource.layout;
+      barrier.newLayout = info.layout;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = resource.image;
+      barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      barrier.subresourceRange.baseMipLevel = 0;
+      barrier.subresourceRange.levelCount = 1;
+      barrier.subresourceRange.baseArrayLayer = 0;
+      barrier.subresourceRange.layerCount = 1;
+      m_barriers.imageBarriers.push_back(barrier);
+
+      // After a semaphore wait the transition chains to the wait's stage
+      if (srcStages == 0) {
+        srcStages = waited ? info.stage : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      }
+      m_barriers.srcStageMask |= srcStages;
+      m_barriers.dstStageMask |= info.stage;
+    } else if (srcStages != 0) {
+      m_barriers.srcStageMask |= srcStages;
+      m_barriers.dstStageMask |= info.stage;
+      m_barriers.srcAccessMask |= srcAccess;
+      m_barriers.dstAccessMask |= info.access;
+    }
+
+    // The pass's own access is what later passes order against
+    if (write) {
+      resource.writeQueue = queue;
+      resource.writeValue = value;
+      resource.writeStages = info.stage;
+      resource.writeAccess = info.write ? info.access : 0;
+      resource.readValues.fill(0);
+      resource.readStages.fill(0);
+    }
+    if (!info.write) {
+      resource.readValues[queueIndex] = value;
+      resource.readStages[queueIndex] |= info.stage;
+    }
+    if (resource.isImage) {
+      resource.layout = info.layout;
+    }
+  }
+
+  return m_barriers;
+}
+
+void FrameGraph::endPass(uint32_t pass, VkCommandBuffer commandBuffer) {
+  queueState(m_passes.at(pass).queue).commandBuffers.push_back(commandBuffer);
+}
+
+bool FrameGraph::submit(QueueType queue, VkFence fence,
+                        VkSemaphore waitSemaphore,
+                        VkPipelineStageFlags waitStage,
+                        VkSemaphore signalSemaphore) {
+  QueueState &state = queueState(queue);
+  if (state.commandBuffers.empty() && fence == VK_NULL_HANDLE &&
+      waitSemaphore == VK_NULL_HANDLE && signalSemaphore == VK_NULL_HANDLE) {
+    return true;
+  }
+
+  std::vector<VkSemaphore> waitSemaphores;
+  std::vector<uint64_t> waitValues;
+  std::vector<VkPipelineStageFlags> waitStages;
+  for (size_t i = 0; i < QUEUE_COUNT; i++) {
+    if (state.waitValues[i] == 0) {
+      continue;
+    }
+
+    QueueState &earlier = m_queues[i];
+    if (m_timelineSemaphores) {
+      waitSemaphores.push_back(earlier.timeline);
+      waitValues.push_back(state.waitValues[i]);
+      waitStages.push_back(state.waitStages[i]);
+    } else if (earlier.completedValue < state.waitValues[i]) {
+      vkQueueWaitIdle(earlier.queue);
+      earlier.completedValue = earlier.submittedValue;
+    }
+  }
+
+  // Binary semaphores take a value slot that the driver ignores
+  if (waitSemaphore != VK_NULL_HANDLE) {
+    waitSemaphores.push_back(waitSemaphore);
+    waitValues.push_back(0);
+    waitStages.push_back(waitStage);
+  }
+
+  uint64_t signalValue = state.submittedValue + 1;
+  std::vector<VkSemaphore> signalSemaphores;
+  std::vector<uint64_t> signalValues;
+  if (m_timelineSemaphores) {
+    signalSemaphores.push_back(state.timeline);
+    signalValues.push_back(signalValue);
+  }
+  if (signalSemaphore != VK_NULL_HANDLE) {
+    signalSemaphores.push_back(signalSemaphore);
+    signalValues.push_back(0);
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+  submitInfo.pWaitSemaphores = waitSemaphores.data();
+  submitInfo.pWaitDstStageMask = waitStages.data();
+  submitInfo.commandBufferCount =
+      static_cast<uint32_t>(state.commandBuffers.size());
+  submitInfo.pCommandBuffers = state.commandBuffers.data();
+  submitInfo.signalSemaphoreCount =
+      static_cast<uint32_t>(signalSemaphores.size());
+  submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+  VkTimelineSemaphoreSubmitInfoKHR timelineInfo{};
+  if (m_timelineSemaphores) {
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+    timelineInfo.waitSemaphoreValueCount =
+        static_cast<uint32_t>(waitValues.size());
+    timelineInfo.pWaitSemaphoreValues = waitValues.data();
+    timelineInfo.signalSemaphoreValueCount =
+        static_cast<uint32_t>(signalValues.size());
+    timelineInfo.pSignalSemaphoreValues = signalValues.data();
+    submitInfo.pNext = &timelineInfo;
+  }
+
+  VkResult result = vkQueueSubmit(state.queue, 1, &submitInfo, fence);
+  state.commandBuffers.clear();
+  state.waitValues.fill(0);
+  state.waitStages.fill(0);
+  if (result != VK_SUCCESS) {
+    std::cerr << "[FrameGraph] Failed to submit "
+              << (queue == QueueType::COMPUTE ? "compute" : "graphics")
+              << " passes! Vulkan error: " << result << std::endl;
+    return false;
+  }
+
+  state.submittedValue = signalValue;
+  return true;
+}
+
+uint64_t FrameGraph::getSubmittedValue(QueueType queue) const {
+  return queueState(queue).submittedValue;
+}
+
+bool FrameGraph::isComplete(QueueType queue, uint64_t value) const {
+  const QueueState &state = queueState(queue);
+  if (value <= state.completedValue) {
+    return true;
+  }
+  if (!m_timelineSemaphores || value > state.submittedValue) {
+    return false;
+  }
+
+  uint64_t counter = 0;
+  return m_getSemaphoreCounterValue(m_device, state.timeline, &counter) ==
+             VK_SUCCESS &&
+         counter >= value;
+}
+
+void FrameGraph::wait(QueueType queue, uint64_t value) {
+  QueueState &state = queueState(queue);
+  if (value > state.submittedValue) {
+    submit(queue);
+  }
+  if (value <= state.completedValue) {
+    return;
+  }
+
+  if (m_timelineSemaphores) {
+    VkSemaphoreWaitInfoKHR waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &state.timeline;
+    waitInfo.pValues = &value;
+    m_waitSemaphores(m_device, &waitInfo, UINT64_MAX);
+    state.completedValue = std::max(state.completedValue, value);
+  } else {
+    vkQueueWaitIdle(state.queue);
+    state.completedValue = state.submittedValue;
+  }
+}
+
+void FrameGraph::PassBarriers::record(VkCommandBuffer commandBuffer) const {
+  if (empty()) {
+    return;
+  }
+
+  VkMemoryBarrier memoryBarrier{};
+  memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  memoryBarrier.srcAccessMask = srcAccessMask;
+  memoryBarrier.dstAccessMask = dstAccessMask;
+  uint32_t memoryBarrierCount =
+      (srcAccessMask != 0 || dstAccessMask != 0) ? 1 : 0;
+
+  vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0,
+                       memoryBarrierCount, &memoryBarrier, 0, nullptr,
+                       static_cast<uint32_t>(imageBarriers.size()),
+                       imageBarriers.data());
+}
+
+void FrameGraph::PassBarriers::appendKey(std::vector<uint64_t> &key) const {
+  key.push_back(srcStageMask);
+  key.push_back(dstStageMask);
+  key.push_back(srcAccessMask);
+  key.push_back(dstAccessMask);
+  for (const VkImageMemoryBarrier &barrier : imageBarriers) {
+    key.push_back(reinterpret_cast<uint64_t>(barrier.image));
+    key.push_back(barrier.oldLayout);
+    key.push_back(barrier.newLayout);
+    key.push_back(barrier.srcAccessMask);
+    key.push_back(barrier.dstAccessMask);
+  }
+}
+
+FrameGraph::AccessInfo FrameGraph::accessInfo(ResourceAccess access) {
+  switch (access) {
+  case ResourceAccess::COMPUTE_READ:
+    return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_GENERAL, false};
+  case ResourceAccess::COMPUTE_WRITE:
+    return {VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_GENERAL, true};
+  case ResourceAccess::TRANSFER_READ:
+    return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, false};
+  case ResourceAccess::TRANSFER_WRITE:
+    return {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true};
+  case ResourceAccess::FRAGMENT_SAMPLED:
+    return {VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false};
+  default:
+    throw std::runtime_error("Unsupported resource access");
+  }
+}
+
+FrameGraph::QueueState &FrameGraph::queueState(QueueType queue) {
+  return m_queues[static_cast<size_t>(queue)];
+}
+
+const FrameGraph::QueueState &FrameGraph::queueState(QueueType queue) const {
+  return m_queues[static_cast<size_t>(queue)];
+}
+
+void FrameGraph::dependOn(QueueType queue, VkPipelineStageFlags stage,
+                          QueueType earlierQueue, uint64_t earlierValue,
+                          VkPipelineStageFlags earlierStages,
+                          VkAccessFlags earlierAccess,
+                          VkPipelineStageFlags &srcStages,
+                          VkAccessFlags &srcAccess, bool &waited) {
+  if (earlierValue == 0) {
+    return;
+  }
+
+  // Barriers and waits only reach work submitted before this batch
+  QueueState &earlier = queueState(earlierQueue);
+  if (earlierQueue != queue && earlierValue > earlier.submittedValue) {
+    submit(earlierQueue);
+  }
+
+  QueueState &current = queueState(queue);
+  if (earlier.queue == current.queue) {
+    srcStages |= earlierStages;
+    srcAccess |= earlierAccess;
+    return;
+  }
+
+  size_t earlierIndex = static_cast<size_t>(earlierQueue);
+  current.waitValues[earlierIndex] =
+      std::max(current.waitValues[earlierIndex], earlierValue);
+  current.waitStages[earlierIndex] |= stage;
+  waited = true;
+}
@@ -0,0 +1,361 @@
+/**
+ * @file FrameGraph.h
+ * @brief Pass scheduling with derived barriers and cross-queue waits
+ *
+ * Passes declare once which resources they read and write. Each frame the
+ * passes that run are scheduled in order; the graph derives the barriers
+ * and image layout transitions between them from the tracked state of
+ * every resource, collects the passes of each queue into one submission,
+ * and links the queues with timeline semaphores. A pass that depends on
+ * passes still collected for another queue submits that batch early, so
+ * callers schedule a frame's passes queue by queue.
+ *
+ * Phase 5 Focus:
+ * - No hand-written layout transitions or queue stalls between passes
+ * - One submission per queue and frame when passes are scheduled in order
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @enum QueueType
+ * @brief Queue a pass is submitted to
+ */
+enum class QueueType {
+  COMPUTE, ///< Fractal dispatches
+  GRAPHICS ///< Texture copy, fractal draw and GUI
+};
+
+/**
+ * @enum ResourceAccess
+ * @brief How a pass uses a resource
+ *
+ * Each access maps to the pipeline stage, access mask and (for images)
+ * layout it needs.
+ */
+enum class ResourceAccess {
+  COMPUTE_READ,    ///< Storage read in a compute shader
+  COMPUTE_WRITE,   ///< Storage write (or read-write) in a compute shader
+  TRANSFER_READ,   ///< Copy source
+  TRANSFER_WRITE,  ///< Copy destination
+  FRAGMENT_SAMPLED ///< Sampled in a fragment shader
+};
+
+/**
+ * @struct ResourceUse
+ * @brief One resource access declared by a pass
+ */
+struct ResourceUse {
+  uint32_t resource;     ///< Handle from addBuffer() or addImage()
+  ResourceAccess access; ///< How the pass uses it
+  bool discard = false;  ///< Previous contents are not needed
+};
+
+/**
+ * @class FrameGraph
+ * @brief Orders passes across command buffers and queues
+ *
+ * Usage per pass: beginPass() derives the barriers the pass needs against
+ * everything scheduled before it and returns them; the pass records them
+ * at the start of its command buffer, then its own commands, and hands the
+ * command buffer to endPass(). submit() sends every pass collected for a
+ * queue in one vkQueueSubmit.
+ *
+ * The returned barriers are stable while the same passes run in the same
+ * order, so kept command buffers append them to their recording key instead
+ * of being recorded every frame.
+ */
+class FrameGraph {
+public:
+  /**
+   * @struct PassBarriers
+   * @brief Barriers a pass records before its own commands
+   */
+  struct PassBarriers {
+    VkPipelineStageFlags srcStageMask = 0;
+    VkPipelineStageFlags dstStageMask = 0;
+    VkAccessFlags srcAccessMask = 0; ///< Buffer hazards (global barrier)
+    VkAccessFlags dstAccessMask = 0;
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+
+    /**
+     * @brief Check whether there is anything to record
+     */
+    bool empty() const { return srcStageMask == 0 && imageBarriers.empty(); }
+
+    /**
+     * @brief Record the barriers (outside a render pass)
+     *
+     * @param commandBuffer Command buffer of the pass
+     */
+    void record(VkCommandBuffer commandBuffer) const;
+
+    /**
+     * @brief Append a description of the barriers to a recording key
+     *
+     * @param key Key of a kept command buffer
+     */
+    void appendKey(std::vector<uint64_t> &key) const;
+  };
+
+  /**
+   * @brief Constructor - create one timeline semaphore per queue
+   *
+   * @param device Vulkan logical device
+   * @param computeQueue Queue for QueueType::COMPUTE passes
+   * @param graphicsQueue Queue for QueueType::GRAPHICS passes (may be the
+   *                      same queue)
+   * @param timelineSemaphores Whether VK_KHR_timeline_semaphore is enabled;
+   *                           without it, cross-queue waits idle the queue
+   *                           that is waited for
+   *
+   * @throws std::runtime_error If a semaphore cannot be created
+   */
+  FrameGraph(VkDevice device, VkQueue computeQueue, VkQueue graphicsQueue,
+             bool timelineSemaphores);
+
+  /**
+   * @brief Destructor - destroy the timeline semaphores
+   *
+   * The caller waits for the device first.
+   */
+  ~FrameGraph();
+
+  // Disable copy and move for simplicity
+  FrameGraph(const FrameGraph &) = delete;
+  FrameGraph &operator=(const FrameGraph &) = delete;
+  FrameGraph(FrameGraph &&) = delete;
+  FrameGraph &operator=(FrameGraph &&) = delete;
+
+  /**
+   * @brief Declare a buffer
+   *
+   * A buffer used by passes on different queue families must be created
+   * with concurrent sharing; the graph does no ownership transfers.
+   *
+   * @param name Debug label for logs
+   * @return Resource handle for ResourceUse
+   */
+  uint32_t addBuffer(const std::string &name);
+
+  /**
+   * @brief Declare a single-mip, single-layer color image
+   *
+   * @param name Debug label for logs
+   * @return Resource handle for ResourceUse
+   */
+  uint32_t addImage(const std::string &name);
+
+  /**
+   * @brief Bind the Vulkan buffer behind a declared buffer
+   *
+   * A different handle than before starts with no tracked accesses; the
+   * replaced buffer is the deletion queue's concern.
+   */
+  void setBuffer(uint32_t resource, VkBuffer buffer);
+
+  /**
+   * @brief Bind the Vulkan image behind a declared image
+   *
+   * A different handle than before starts in VK_IMAGE_LAYOUT_UNDEFINED.
+   */
+  void setImage(uint32_t resource, VkImage image);
+
+  /**
+   * @brief Declare a pass
+   *
+   * @param name Debug label for logs
+   * @param queue Queue the pass is submitted to
+   * @param uses Resources the pass reads and writes
+   * @return Pass handle for beginPass() and endPass()
+   */
+  uint32_t addPass(const std::string &name, QueueType queue,
+                   std::vector<ResourceUse> uses);
+
+  /**
+   * @brief Derive the barriers of a pass about to be recorded
+   *
+   * Submits other queues first if the pass depends on work still waiting
+   * in their batch. Marks the pass's accesses as done, so every
+   * beginPass() must be followed by endPass().
+   *
+   * @param pass Handle from addPass()
+   * @return Barriers to record first; valid until the next beginPass()
+   */
+  const PassBarriers &beginPass(uint32_t pass);
+
+  /**
+   * @brief Add a recorded pass to its queue's next submission
+   *
+   * @param pass Handle passed to beginPass()
+   * @param commandBuffer Command buffer holding the barriers and the pass
+   */
+  void endPass(uint32_t pass, VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Submit every pass collected for a queue
+   *
+   * @param queue Queue to submit
+   * @param fence Optional fence, signalled even if no pass was collected
+   * @param waitSemaphore Optional binary semaphore to wait for (swapchain
+   *                      acquire)
+   * @param waitStage Stage that waits for waitSemaphore
+   * @param signalSemaphore Optional binary semaphore to signal (present)
+   * @return true on success (or if there was nothing to submit)
+   */
+  bool submit(QueueType queue, VkFence fence = VK_NULL_HANDLE,
+              VkSemaphore waitSemaphore = VK_NULL_HANDLE,
+              VkPipelineStageFlags waitStage = 0,
+              VkSemaphore signalSemaphore = VK_NULL_HANDLE);
+
+  /**
+   * @brief Get the timeline value of the latest submission to a queue
+   */
+  uint64_t getSubmittedValue(QueueType queue) const;
+
+  /**
+   * @brief Check without waiting whether a submission has finished
+   *
+   * Without timeline semaphores only submissions waited for with wait()
+   * count as finished.
+   */
+  bool isComplete(QueueType queue, uint64_t value) const;
+
+  /**
+   * @brief Block until a submission has finished
+   *
+   * Submits the queue first if the value is still in its batch.
+   */
+  void wait(QueueType queue, uint64_t value);
+
+  /**
+   * @brief Check whether queues are linked by timeline semaphores
+   */
+  bool hasTimelineSemaphores() const { return m_timelineSemaphores; }
+
+private:
+  static constexpr size_t QUEUE_COUNT = 2;
+
+  /**
+   * @struct AccessInfo
+   * @brief Stage, access mask and layout of a ResourceAccess
+   */
+  struct AccessInfo {
+    VkPipelineStageFlags stage;
+    VkAccessFlags access;
+    VkImageLayout layout;
+    bool write;
+  };
+
+  /**
+   * @struct Resource
+   * @brief Tracked state of a declared buffer or image
+   *
+   * Values are timeline values of the submission the access belongs to
+   * (0 = none since the handle was bound).
+   */
+  struct Resource {
+    std::string name;
+    bool isImage = false;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkImage image = VK_NULL_HANDLE;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    // Last write (layout transitions count as writes)
+    QueueType writeQueue = QueueType::COMPUTE;
+    uint64_t writeValue = 0;
+    VkPipelineStageFlags writeStages = 0;
+    VkAccessFlags writeAccess = 0;
+
+    // Reads since the last write, per queue
+    std::array<uint64_t, QUEUE_COUNT> readValues{};
+    std::array<VkPipelineStageFlags, QUEUE_COUNT> readStages{};
+  };
+
+  /**
+   * @struct Pass
+   * @brief Declared pass
+   */
+  struct Pass {
+    std::string name;
+    QueueType queue;
+    std::vector<ResourceUse> uses;
+  };
+
+  /**
+   * @struct QueueState
+   * @brief Timeline and pending batch of one queue
+   */
+  struct QueueState {
+    VkQueue queue = VK_NULL_HANDLE;
+    VkSemaphore timeline = VK_NULL_HANDLE;
+    uint64_t submittedValue = 0; ///< Signalled by the latest submission
+    uint64_t completedValue = 0; ///< Known finished (fallback path)
+    std::vector<VkCommandBuffer> commandBuffers; ///< Pending batch
+    std::array<uint64_t, QUEUE_COUNT> waitValues{};
+    std::array<VkPipelineStageFlags, QUEUE_COUNT> waitStages{};
+  };
+
+  static AccessInfo accessInfo(ResourceAccess access);
+  QueueState &queueState(QueueType queue);
+  const QueueState &queueState(QueueType queue) const;
+
+  /**
+   * @brief Order a use after an earlier access
+   *
+   * Same queue: adds the earlier stages and accesses to the barrier. Other
+   * queue: submits it if needed, adds a timeline wait and sets waited.
+   */
+  void dependOn(QueueType queue, VkPipelineStageFlags stage,
+                QueueType earlierQueue, uint64_t earlierValue,
+                VkPipelineStageFlags earlierStages,
+                VkAccessFlags earlierAccess, VkPipelineStageFlags &srcStages,
+                VkAccessFlags &srcAccess, bool &waited);
+
+  VkDevice m_device;
+  bool m_timelineSemaphores;
+  PFN_vkGetSemaphoreCounterValueKHR m_getSemaphoreCounterValue;
+  PFN_vkWaitSemaphoresKHR m_waitSemaphores;
+
+  std::array<QueueState, QUEUE_COUNT> m_queues;
+  std::vector<Resource> m_resources;
+  std::vector<Pass> m_passes;
+  PassBarriers m_barriers; ///< Result of the latest beginPass()
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Barrier Derivation:
+ *    - Writes wait for the last write and every read since; reads wait
+ *      for the last write unless an earlier read on the same queue and
+ *      stage already did
+ *    - Buffer hazards use one global memory barrier; images get an image
+ *      barrier with the layout transition, from UNDEFINED when discarded
+ *
+ * 2. Queues:
+ *    - The two queue types may share one VkQueue (one queue family with
+ *      a single queue); dependencies between them are then barriers, after
+ *      submitting the earlier batch so submission order holds
+ *    - On different queues the later batch waits on the earlier queue's
+ *      timeline value at the stage of the use
+ *    - Without timeline semaphores that wait becomes vkQueueWaitIdle of
+ *      the earlier queue at submit time
+ *
+ * 3. Limits:
+ *    - Dispatch chains inside one command buffer (fractal, anti-aliasing
+ *      resolve, accumulation) keep their own barriers in ComputePipeline
+ *    - Render pass attachments are transitioned by the render pass
+ *    - No transient aliasing: every compute buffer keeps state between
+ *      frames, so none has a lifetime the graph could reuse
+ */
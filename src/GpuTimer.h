@@ -0,0 +1,117 @@
+/**
+ * @file GpuTimer.h
+ * @brief GPU timestamp queries for measuring command buffer sections
+ *
+ * This class brackets a span of recorded commands with two timestamp
+ * queries and reports the GPU time between them once the results are
+ * available, without ever waiting for them.
+ *
+ * Phase 5 Focus:
+ * - GPU-side compute time, independent of CPU stalls and vsync
+ * - Non-blocking result collection for feedback control
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @class GpuTimer
+ * @brief Ring of timestamp query pairs
+ *
+ * begin() and end() record a query pair into the next slot; collect() reads
+ * every slot whose results are available, oldest first. With more slots
+ * than frames in flight a slot is never overwritten before it was read.
+ */
+class GpuTimer {
+public:
+  /**
+   * @brief Constructor - create the query pool
+   *
+   * @param device Vulkan logical device
+   * @param physicalDevice Physical device for the timestamp period
+   * @param queueFamilyIndex Family of the queue the timed commands run on
+   *
+   * @throws std::runtime_error If the query pool cannot be created
+   */
+  GpuTimer(VkDevice device, VkPhysicalDevice physicalDevice,
+           uint32_t queueFamilyIndex);
+
+  /**
+   * @brief Destructor - destroy the query pool
+   */
+  ~GpuTimer();
+
+  // Disable copy and move for simplicity
+  GpuTimer(const GpuTimer &) = delete;
+  GpuTimer &operator=(const GpuTimer &) = delete;
+  GpuTimer(GpuTimer &&) = delete;
+  GpuTimer &operator=(GpuTimer &&) = delete;
+
+  /**
+   * @brief Check whether the queue family supports timestamps
+   * @return false if begin()/end() record nothing
+   */
+  bool isSupported() const { return m_validBitsMask != 0; }
+
+  /**
+   * @brief Record the start timestamp
+   *
+   * @param commandBuffer Command buffer outside a render pass
+   */
+  void begin(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Record the end timestamp of the span started by begin()
+   *
+   * @param commandBuffer Same command buffer as begin()
+   */
+  void end(VkCommandBuffer commandBuffer);
+
+  /**
+   * @brief Read every finished measurement without waiting
+   *
+   * @return true if at least one new measurement arrived
+   */
+  bool collect();
+
+  /**
+   * @brief Get the newest measurement
+   * @return GPU time of the last collected span in milliseconds
+   */
+  double getLastMilliseconds() const { return m_lastMilliseconds; }
+
+private:
+  static constexpr uint32_t SLOT_COUNT = 4;
+
+  VkDevice m_device;
+  VkQueryPool m_queryPool;
+  double m_nanosecondsPerTick;
+  uint64_t m_validBitsMask; ///< Meaningful bits of a timestamp, 0 = none
+
+  uint32_t m_nextSlot;     ///< Slot the next begin() writes
+  uint32_t m_pendingSlots; ///< Slots recorded but not collected, oldest at
+                           ///< m_nextSlot - m_pendingSlots
+  double m_lastMilliseconds;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Timestamps:
+ *    - The start is written at TOP_OF_PIPE and the end at BOTTOM_OF_PIPE,
+ *      so the span covers all work in between, including barriers
+ *    - Results are masked to timestampValidBits before subtracting
+ *
+ * 2. Collection:
+ *    - Results are read without VK_QUERY_RESULT_WAIT_BIT; a slot that is
+ *      not ready stops collection until the next call
+ *    - If more spans are recorded than slots exist, the oldest pending one
+ *      is dropped
+ */
@@ -11,9 +11,13 @@
  */
 
 #include "GraphicsPipeline.h"
+#include "LayoutCache.h"
+#include "MemoryManager.h"
+#include "PipelineCache.h"
 #include "ShaderManager.h"
 #include "SwapchainManager.h"
 
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -22,13 +26,19 @@
  */
 GraphicsPipeline::GraphicsPipeline(
     VkDevice device, std::shared_ptr<ShaderManager> shaderManager,
-    std::shared_ptr<SwapchainManager> swapchainManager)
+    std::shared_ptr<SwapchainManager> swapchainManager,
+    std::shared_ptr<MemoryManager> memoryManager, uint32_t framesInFlight,
+    std::shared_ptr<PipelineCache> pipelineCache)
     : m_device(device), m_shaderManager(shaderManager),
-      m_swapchainManager(swapchainManager), m_renderPass(VK_NULL_HANDLE),
+      m_swapchainManager(swapchainManager), m_memoryManager(memoryManager),
+      m_pipelineCache(pipelineCache), m_framesInFlight(framesInFlight),
+      m_renderPass(VK_NULL_HANDLE),
       m_pipelineLayout(VK_NULL_HANDLE), m_graphicsPipeline(VK_NULL_HANDLE),
       m_descriptorSetLayout(VK_NULL_HANDLE), m_descriptorPool(VK_NULL_HANDLE),
       m_descriptorSet(VK_NULL_HANDLE), m_vertexShader(VK_NULL_HANDLE),
-      m_fragmentShader(VK_NULL_HANDLE), m_pipelineReady(false) {
+      m_fragmentShader(VK_NULL_HANDLE), m_pipelineReady(false),
+      m_recordingVersion(0),
+      m_displayRegion{{1.0f, 1.0f}, {1.0f, 1.0f}} {
   std::cout << "GraphicsPipeline: Initializing graphics pipeline..."
             << std::endl;
 }
@@ -43,6 +53,9 @@ GraphicsPipeline::~GraphicsPipeline() {
   // Clean up framebuffers
   cleanupFramebuffers();
 
+  // Deferred descriptor set frees need the pool, which is destroyed below
+  m_memoryManager->getDeletionQueue().flush();
+
   // Clean up shader modules
   if (m_vertexShader != VK_NULL_HANDLE) {
     vkDestroyShaderModule(m_device, m_vertexShader, nullptr);
@@ -55,15 +68,9 @@ GraphicsPipeline::~GraphicsPipeline() {
   if (m_graphicsPipeline != VK_NULL_HANDLE) {
     vkDestroyPipeline(m_device, m_graphicsPipeline, nullptr);
   }
-  if (m_pipelineLayout != VK_NULL_HANDLE) {
-    vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
-  }
   if (m_descriptorPool != VK_NULL_HANDLE) {
     vkDestroyDescriptorPool(m_device, m_descriptorPool, nullptr);
   }
-  if (m_descriptorSetLayout != VK_NULL_HANDLE) {
-    vkDestroyDescriptorSetLayout(m_device, m_descriptorSetLayout, nullptr);
-  }
   if (m_renderPass != VK_NULL_HANDLE) {
     vkDestroyRenderPass(m_device, m_renderPass, nullptr);
   }
@@ -79,13 +86,18 @@ bool GraphicsPipeline::createFractalDisplayPipeline() {
             << std::endl;
 
   try {
-    // Create descriptor set layout first
-    if (!createDescriptorSetLayout()) {
-      std::cerr << "GraphicsPipeline: Failed to create descriptor set layout!"
+    // Load shaders first; the layouts are reflected from them
+    if (!loadShaders()) {
+      std::cerr << "GraphicsPipeline: Failed to load display shaders!"
                 << std::endl;
       return false;
     }
 
+    if (!createLayouts()) {
+      std::cerr << "GraphicsPipeline: Failed to create layouts!" << std::endl;
+      return false;
+    }
+
     // Create descriptor pool
     if (!createDescriptorPool()) {
       std::cerr << "GraphicsPipeline: Failed to create descriptor pool!"
@@ -143,7 +155,8 @@ bool GraphicsPipeline::isPipelineReady() const { return m_pipelineReady; }
  * @brief Begin a render pass
  */
 void GraphicsPipeline::beginRenderPass(VkCommandBuffer commandBuffer,
-                                       uint32_t imageIndex) {
+                                       uint32_t imageIndex,
+                                       VkSubpassContents contents) {
   VkRenderPassBeginInfo renderPassInfo{};
   renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
   renderPassInfo.renderPass = m_renderPass;
@@ -156,8 +169,7 @@ void GraphicsPipeline::beginRenderPass(VkCommandBuffer commandBuffer,
   renderPassInfo.clearValueCount = 1;
   renderPassInfo.pClearValues = &clearColor;
 
-  vkCmdBeginRenderPass(commandBuffer, &renderPassInfo,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
 }
 
 /**
@@ -190,15 +202,49 @@ void GraphicsPipeline::renderFractal(VkCommandBuffer commandBuffer,
   vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                           m_pipelineLayout, 0, 1, &m_descriptorSet, 0, nullptr);
 
+  vkCmdPushConstants(commandBuffer, m_pipelineLayout,
+                     m_reflection.pushConstantStages, 0,
+                     sizeof(DisplayRegion), &m_displayRegion);
+
   // Draw fullscreen quad (4 vertices as triangle strip)
   vkCmdDraw(commandBuffer, 4, 1, 0, 0);
 }
 
+/**
+ * @brief Limit sampling to the rendered part of the fractal texture
+ */
+void GraphicsPipeline::setDisplayRegion(uint32_t renderWidth,
+                                        uint32_t renderHeight,
+                                        uint32_t textureWidth,
+                                        uint32_t textureHeight) {
+  if (textureWidth == 0 || textureHeight == 0) {
+    return;
+  }
+
+  float width = static_cast<float>(textureWidth);
+  float height = static_cast<float>(textureHeight);
+  DisplayRegion region{};
+  region.uvScale[0] = renderWidth / width;
+  region.uvScale[1] = renderHeight / height;
+  region.uvMax[0] = (renderWidth - 0.5f) / width;
+  region.uvMax[1] = (renderHeight - 0.5f) / height;
+
+  // Recorded draws push the region, so only a real change invalidates them
+  if (std::memcmp(&region, &m_displayRegion, sizeof(DisplayRegion)) != 0) {
+    m_displayRegion = region;
+    m_recordingVersion++;
+  }
+}
+
 /**
  * @brief Update the fractal texture binding
  */
 bool GraphicsPipeline::updateFractalTexture(VkImageView textureImageView,
                                             VkSampler textureSampler) {
+  if (!replaceDescriptorSet()) {
+    return false;
+  }
+
   VkDescriptorImageInfo imageInfo{};
   imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
   imageInfo.imageView = textureImageView;
@@ -214,6 +260,7 @@ bool GraphicsPipeline::updateFractalTexture(VkImageView textureImageView,
   descriptorWrite.pImageInfo = &imageInfo;
 
   vkUpdateDescriptorSets(m_device, 1, &descriptorWrite, 0, nullptr);
+  m_recordingVersion++;
   return true;
 }
 
@@ -234,6 +281,8 @@ void GraphicsPipeline::recreateForSwapchain() {
   // Clean up old framebuffers
   cleanupFramebuffers();
 
+  m_recordingVersion++;
+
   // Recreate framebuffers with new swapchain images
   if (!createFramebuffers()) {
     std::cerr << "GraphicsPipeline: Failed to recreate framebuffers!"
@@ -243,31 +292,60 @@ void GraphicsPipeline::recreateForSwapchain() {
 }
 
 /**
- * @brief Create descriptor set layout
+ * @brief Load the display shaders
  */
-bool GraphicsPipeline::createDescriptorSetLayout() {
-  // Create descriptor set layout for fractal texture sampling
-  VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-  samplerLayoutBinding.binding = 0;
-  samplerLayoutBinding.descriptorCount = 1;
-  samplerLayoutBinding.descriptorType =
-      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-  samplerLayoutBinding.pImmutableSamplers = nullptr;
-  samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-  VkDescriptorSetLayoutCreateInfo layoutInfo{};
-  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-  layoutInfo.bindingCount = 1;
-  layoutInfo.pBindings = &samplerLayoutBinding;
-
-  VkResult result = vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr,
-                                                &m_descriptorSetLayout);
-  if (result != VK_SUCCESS) {
-    std::cerr
-        << "GraphicsPipeline: Failed to create descriptor set layout! Error: "
-        << result << std::endl;
+bool GraphicsPipeline::loadShaders() {
+  std::cout << "GraphicsPipeline: Loading vertex shader..." << std::endl;
+  auto vertexShaderInfo = m_shaderManager->loadShaderFromFile(
+      "fullscreen_vertex", "shaders/fullscreen.vert", ShaderType::VERTEX);
+  if (!vertexShaderInfo) {
+    std::cerr << "GraphicsPipeline: Failed to load vertex shader!" << std::endl;
     return false;
   }
+  m_vertexShader = vertexShaderInfo->module;
+
+  std::cout << "GraphicsPipeline: Loading fragment shader..." << std::endl;
+  auto fragmentShaderInfo = m_shaderManager->loadShaderFromFile(
+      "fractal_display_fragment", "shaders/fractal_display.frag",
+      ShaderType::FRAGMENT);
+  if (!fragmentShaderInfo) {
+    std::cerr << "GraphicsPipeline: Failed to load fragment shader!"
+              << std::endl;
+    return false;
+  }
+  m_fragmentShader = fragmentShaderInfo->module;
+
+  // The layout is whatever the two stages declare together
+  m_reflection = vertexShaderInfo->reflection;
+  m_reflection.merge(fragmentShaderInfo->reflection);
+  return true;
+}
+
+/**
+ * @brief Get descriptor set and pipeline layouts from the shader reflection
+ */
+bool GraphicsPipeline::createLayouts() {
+  // updateFractalTexture() writes binding 0; renderFractal() pushes
+  // DisplayRegion
+  auto bindings = m_reflection.getSetBindings(0);
+  if (m_reflection.getSetCount() != 1 || bindings.size() != 1 ||
+      bindings[0].binding != 0 ||
+      bindings[0].descriptorType != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+    std::cerr << "GraphicsPipeline: Display shaders must declare exactly one "
+              << "combined image sampler at set 0, binding 0" << std::endl;
+    return false;
+  }
+  if (m_reflection.pushConstantSize != sizeof(DisplayRegion)) {
+    std::cerr << "GraphicsPipeline: Display shader push constants are "
+              << m_reflection.pushConstantSize << " bytes, expected "
+              << sizeof(DisplayRegion) << std::endl;
+    return false;
+  }
+
+  LayoutCache &layoutCache = m_shaderManager->getLayoutCache();
+  m_descriptorSetLayout = layoutCache.getDescriptorSetLayout(bindings);
+  m_pipelineLayout = layoutCache.getPipelineLayout(
+      {m_descriptorSetLayout}, m_reflection.getPushConstantRanges());
 
   return true;
 }
@@ -328,26 +406,7 @@ bool GraphicsPipeline::createRenderPass() {
  * @brief Create the graphics pipeline
  */
 bool GraphicsPipeline::createPipeline() {
-  // Load and compile shaders
-  std::cout << "GraphicsPipeline: Loading vertex shader..." << std::endl;
-  auto vertexShaderInfo = m_shaderManager->loadShaderFromFile(
-      "fullscreen_vertex", "shaders/fullscreen.vert", ShaderType::VERTEX);
-  if (!vertexShaderInfo) {
-    std::cerr << "GraphicsPipeline: Failed to load vertex shader!" << std::endl;
-    return false;
-  }
-  m_vertexShader = vertexShaderInfo->module;
-
-  std::cout << "GraphicsPipeline: Loading fragment shader..." << std::endl;
-  auto fragmentShaderInfo = m_shaderManager->loadShaderFromFile(
-      "fractal_display_fragment", "shaders/fractal_display.frag",
-      ShaderType::FRAGMENT);
-  if (!fragmentShaderInfo) {
-    std::cerr << "GraphicsPipeline: Failed to load fragment shader!"
-              << std::endl;
-    return false;
-  }
-  m_fragmentShader = fragmentShaderInfo->module;
+  // Shaders come from loadShaders(), layouts from createLayouts()
 
   // Shader stage creation
   VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
@@ -432,20 +491,6 @@ bool GraphicsPipeline::createPipeline() {
   colorBlending.blendConstants[2] = 0.0f;
   colorBlending.blendConstants[3] = 0.0f;
 
-  // Pipeline layout
-  VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-  pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  pipelineLayoutInfo.setLayoutCount = 1;
-  pipelineLayoutInfo.pSetLayouts = &m_descriptorSetLayout;
-
-  VkResult result = vkCreatePipelineLayout(m_device, &pipelineLayoutInfo,
-                                           nullptr, &m_pipelineLayout);
-  if (result != VK_SUCCESS) {
-    std::cerr << "GraphicsPipeline: Failed to create pipeline layout! Error: "
-              << result << std::endl;
-    return false;
-  }
-
   // Create graphics pipeline
   VkGraphicsPipelineCreateInfo pipelineInfo{};
   pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -463,8 +508,10 @@ bool GraphicsPipeline::createPipeline() {
   pipelineInfo.subpass = 0;
   pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-  result = vkCreateGraphicsPipelines(m_device, VK_NULL_HANDLE, 1, &pipelineInfo,
-                                     nullptr, &m_graphicsPipeline);
+  VkPipelineCache cache =
+      m_pipelineCache ? m_pipelineCache->getHandle() : VK_NULL_HANDLE;
+  VkResult result = vkCreateGraphicsPipelines(
+      m_device, cache, 1, &pipelineInfo, nullptr, &m_graphicsPipeline);
   if (result != VK_SUCCESS) {
     std::cerr << "GraphicsPipeline: Failed to create graphics pipeline! Error: "
               << result << std::endl;
@@ -521,15 +568,16 @@ void GraphicsPipeline::cleanupFramebuffers() {
  * @brief Create descriptor pool
  */
 bool GraphicsPipeline::createDescriptorPool() {
-  VkDescriptorPoolSize poolSize{};
-  poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-  poolSize.descriptorCount = 1;
+  uint32_t maxSets = m_framesInFlight + 1;
+  std::vector<VkDescriptorPoolSize> poolSizes =
+      m_reflection.getPoolSizes(maxSets);
 
   VkDescriptorPoolCreateInfo poolInfo{};
   poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-  poolInfo.poolSizeCount = 1;
-  poolInfo.pPoolSizes = &poolSize;
-  poolInfo.maxSets = 1;
+  poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+  poolInfo.pPoolSizes = poolSizes.data();
+  poolInfo.maxSets = maxSets;
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
   VkResult result =
       vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_descriptorPool);
@@ -562,3 +610,54 @@ bool GraphicsPipeline::createDescriptorSet() {
 
   return true;
 }
+
+/**
+ * @brief Replace the bound descriptor set with a fresh one
+ */
+bool GraphicsPipeline::replaceDescriptorSet() {
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = m_descriptorPool;
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &m_descriptorSetLayout;
+
+  VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+  VkDescriptorPool retiredPool = VK_NULL_HANDLE;
+  VkResult result =
+      vkAllocateDescriptorSets(m_device, &allocInfo, &descriptorSet);
+  if (result == VK_ERROR_OUT_OF_POOL_MEMORY ||
+      result == VK_ERROR_FRAGMENTED_POOL) {
+    // A frame that is slow to retire still holds the earlier sets
+    retiredPool = m_descriptorPool;
+    if (!createDescriptorPool()) {
+      m_descriptorPool = retiredPool;
+      return false;
+    }
+    allocInfo.descriptorPool = m_descriptorPool;
+    result = vkAllocateDescriptorSets(m_device, &allocInfo, &descriptorSet);
+    if (result != VK_SUCCESS) {
+      vkDestroyDescriptorPool(m_device, m_descriptorPool, nullptr);
+      m_descriptorPool = retiredPool;
+    }
+  }
+  if (result != VK_SUCCESS) {
+    std::cerr << "GraphicsPipeline: Failed to allocate descriptor set! Error: "
+              << result << std::endl;
+    return false;
+  }
+
+  // Destroying a retired pool frees the sets still allocated from it
+  DeletionQueue &deletionQueue = m_memoryManager->getDeletionQueue();
+  if (retiredPool != VK_NULL_HANDLE) {
+    deletionQueue.enqueue([device = m_device, retiredPool]() {
+      vkDestroyDescriptorPool(device, retiredPool, nullptr);
+    });
+  } else if (m_descriptorSet != VK_NULL_HANDLE) {
+    deletionQueue.enqueue([device = m_device, pool = m_descriptorPool,
+                           retired = m_descriptorSet]() {
+      vkFreeDescriptorSets(device, pool, 1, &retired);
+    });
+  }
+  m_descriptorSet = descriptorSet;
+  return true;
+}
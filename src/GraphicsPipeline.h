@@ -19,13 +19,16 @@
 
 #pragma once
 
+#include "ShaderReflection.h"
 #include <memory>
 #include <vector>
 #include <vulkan/vulkan.h>
 
 // Forward declarations
+class MemoryManager;
 class ShaderManager;
 class SwapchainManager;
+class PipelineCache;
 
 /**
  * @class GraphicsPipeline
@@ -42,10 +45,17 @@ public:
    * @param device Vulkan logical device
    * @param shaderManager Shared shader manager for compilation
    * @param swapchainManager Shared swapchain manager for format info
+   * @param memoryManager Memory manager whose deletion queue frees retired
+   *        descriptor sets
+   * @param framesInFlight Frames that may still sample a replaced texture
+   * @param pipelineCache Cache shared by all pipelines (may be null)
    */
   GraphicsPipeline(VkDevice device,
                    std::shared_ptr<ShaderManager> shaderManager,
-                   std::shared_ptr<SwapchainManager> swapchainManager);
+                   std::shared_ptr<SwapchainManager> swapchainManager,
+                   std::shared_ptr<MemoryManager> memoryManager,
+                   uint32_t framesInFlight,
+                   std::shared_ptr<PipelineCache> pipelineCache = nullptr);
 
   /**
    * @brief Destructor - cleanup all resources
@@ -81,8 +91,11 @@ public:
    *
    * @param commandBuffer Command buffer to record commands
    * @param imageIndex Current swapchain image index
+   * @param contents Whether the subpass is recorded inline or executed from
+   *                 secondary command buffers
    */
-  void beginRenderPass(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+  void beginRenderPass(VkCommandBuffer commandBuffer, uint32_t imageIndex,
+                       VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
   /**
    * @brief Render the fractal fullscreen quad
@@ -95,7 +108,9 @@ public:
   /**
    * @brief Update the fractal texture binding
    *
-   * Updates the descriptor set to bind a new fractal texture.
+   * Writes the texture into a freshly allocated descriptor set, since frames
+   * in flight may still sample through the current one. The old set is
+   * freed through the deletion queue once those frames retire.
    *
    * @param textureImageView Image view of the fractal texture
    * @param textureSampler Sampler for the fractal texture
@@ -104,6 +119,21 @@ public:
   bool updateFractalTexture(VkImageView textureImageView,
                             VkSampler textureSampler);
 
+  /**
+   * @brief Limit sampling to the rendered part of the fractal texture
+   *
+   * With dynamic resolution the compute pass fills only the top-left
+   * renderWidth x renderHeight texels; this stretches that region over the
+   * whole quad.
+   *
+   * @param renderWidth Width of the rendered region in texels
+   * @param renderHeight Height of the rendered region in texels
+   * @param textureWidth Full texture width
+   * @param textureHeight Full texture height
+   */
+  void setDisplayRegion(uint32_t renderWidth, uint32_t renderHeight,
+                        uint32_t textureWidth, uint32_t textureHeight);
+
   /**
    * @brief End the current render pass
    *
@@ -130,6 +160,26 @@ public:
    */
   VkRenderPass getRenderPass() const { return m_renderPass; }
 
+  /**
+   * @brief Get the framebuffer of a swapchain image
+   * @param imageIndex Swapchain image index
+   * @return VkFramebuffer handle
+   */
+  VkFramebuffer getFramebuffer(uint32_t imageIndex) const {
+    return m_framebuffers[imageIndex];
+  }
+
+  /**
+   * @brief Get a counter that changes whenever recorded commands go stale
+   *
+   * Bumped when the texture binding, the display region or the
+   * framebuffers change; renderFractal() recordings made at an older
+   * version must be recorded again.
+   *
+   * @return Current recording version
+   */
+  uint64_t getRecordingVersion() const { return m_recordingVersion; }
+
 private:
   /**
    * @brief Create the render pass
@@ -153,15 +203,32 @@ private:
   bool createFramebuffers();
 
   /**
-   * @brief Create descriptor set layout for texture sampling
+   * @brief Load the vertex and fragment shaders
+   *
+   * Sets the shader modules and fills m_reflection with the interface both
+   * stages declare.
+   *
+   * @return true if successful, false otherwise
+   */
+  bool loadShaders();
+
+  /**
+   * @brief Get layouts from the reflected shader interface
+   *
+   * Checks m_reflection against what the display code binds and pushes,
+   * then takes the descriptor set layout and pipeline layout from the
+   * shader manager's layout cache.
    *
    * @return true if successful, false otherwise
    */
-  bool createDescriptorSetLayout();
+  bool createLayouts();
 
   /**
    * @brief Create descriptor pool for descriptor set allocation
    *
+   * Holds the bound set plus one per frame in flight, so a texture update
+   * every frame never has to wait for a retired set.
+   *
    * @return true if successful, false otherwise
    */
   bool createDescriptorPool();
@@ -173,6 +240,16 @@ private:
    */
   bool createDescriptorSet();
 
+  /**
+   * @brief Replace the bound descriptor set with a fresh one
+   *
+   * The old set is freed through the deletion queue. If retired sets still
+   * fill the pool, the whole pool is retired and a new one takes over.
+   *
+   * @return true if successful, false otherwise
+   */
+  bool replaceDescriptorSet();
+
   /**
    * @brief Cleanup framebuffers
    */
@@ -182,12 +259,15 @@ private:
   VkDevice m_device;
   std::shared_ptr<ShaderManager> m_shaderManager;
   std::shared_ptr<SwapchainManager> m_swapchainManager;
+  std::shared_ptr<MemoryManager> m_memoryManager;
+  std::shared_ptr<PipelineCache> m_pipelineCache;
+  uint32_t m_framesInFlight;
 
   // Graphics pipeline objects
   VkRenderPass m_renderPass;
-  VkPipelineLayout m_pipelineLayout;
+  VkPipelineLayout m_pipelineLayout; // Owned by the layout cache
   VkPipeline m_graphicsPipeline;
-  VkDescriptorSetLayout m_descriptorSetLayout;
+  VkDescriptorSetLayout m_descriptorSetLayout; // Owned by the layout cache
   VkDescriptorPool m_descriptorPool;
   VkDescriptorSet m_descriptorSet;
 
@@ -197,7 +277,16 @@ private:
   // Shader modules
   VkShaderModule m_vertexShader;
   VkShaderModule m_fragmentShader;
+  ShaderReflection m_reflection; // Merged vertex and fragment interface
 
   // Pipeline state
   bool m_pipelineReady;
+  uint64_t m_recordingVersion; // Bumped when recorded commands go stale
+
+  // Fragment push constants, matches DisplayRegion in fractal_display.frag
+  struct DisplayRegion {
+    float uvScale[2]; ///< Texture coordinate scale of the rendered region
+    float uvMax[2];   ///< Last texel centre, keeps filtering inside it
+  };
+  DisplayRegion m_displayRegion;
 };
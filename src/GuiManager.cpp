@@ -13,6 +13,7 @@
 
 #include "GuiManager.h"
 #include "GraphicsPipeline.h"
+#include "MemoryManager.h"
 #include "SwapchainManager.h"
 #include "VulkanSetup.h"
 
@@ -361,7 +362,7 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
     bool resChanged = false;
     if (ImGui::InputInt("##Width", &parameters.resolutionWidth, 0, 0)) {
       parameters.resolutionWidth =
-          std::max(100, std::min(4096, parameters.resolutionWidth));
+          std::max(100, std::min(7680, parameters.resolutionWidth));
       resChanged = true;
     }
     ImGui::SameLine();
@@ -369,7 +370,7 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
     ImGui::SameLine();
     if (ImGui::InputInt("##Height", &parameters.resolutionHeight, 0, 0)) {
       parameters.resolutionHeight =
-          std::max(100, std::min(4096, parameters.resolutionHeight));
+          std::max(100, std::min(7680, parameters.resolutionHeight));
       resChanged = true;
     }
     ImGui::PopItemWidth();
@@ -401,6 +402,17 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
       parameters.resolutionHeight = 2048;
       changed = true;
     }
+    if (ImGui::Button("3840x2160")) {
+      parameters.resolutionWidth = 3840;
+      parameters.resolutionHeight = 2160;
+      changed = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("7680x4320")) {
+      parameters.resolutionWidth = 7680;
+      parameters.resolutionHeight = 4320;
+      changed = true;
+    }
 
     ImGui::Separator();
 
@@ -440,6 +452,39 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
     ImGui::SameLine();
     ImGui::Text("Color Scale");
     ImGui::PopItemWidth();
+
+    // Adaptive anti-aliasing: extra samples only on edge pixels
+    const char *aaModes[] = {"Off", "Adaptive 4x", "Adaptive 16x",
+                             "Adaptive 64x"};
+    const int aaSampleCounts[] = {0, 4, 16, 64};
+    int aaMode = 0;
+    for (int i = 0; i < IM_ARRAYSIZE(aaSampleCounts); i++) {
+      if (aaSampleCounts[i] == parameters.antiAliasingSamples) {
+        aaMode = i;
+      }
+    }
+    ImGui::PushItemWidth(120);
+    if (ImGui::Combo("Anti-Aliasing", &aaMode, aaModes,
+                     IM_ARRAYSIZE(aaModes))) {
+      parameters.antiAliasingSamples = aaSampleCounts[aaMode];
+      changed = true;
+    }
+    ImGui::PopItemWidth();
+
+    if (ImGui::Checkbox("Temporal Accumulation",
+                        &parameters.temporalAccumulation)) {
+      changed = true;
+    }
+
+    // Dynamic resolution only sizes the next renders; it changes no
+    // parameter, so it does not request a recompute itself
+    ImGui::Checkbox("Dynamic Resolution", &parameters.dynamicResolution);
+    if (parameters.dynamicResolution) {
+      ImGui::PushItemWidth(120);
+      ImGui::SliderFloat("Target (ms)", &parameters.targetFrameTime, 4.0f,
+                         100.0f, "%.0f");
+      ImGui::PopItemWidth();
+    }
   }
 
   ImGui::Separator();
@@ -458,6 +503,12 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
     changed = true;
   }
 
+  // Export does not change the image, so it is reported separately
+  ImGui::SameLine();
+  if (ImGui::Button("Export Image")) {
+    parameters.exportRequested = true;
+  }
+
   // Status information
   if (ImGui::CollapsingHeader("Status")) {
     ImGui::Text("Center: (%.8f, %.8f)", parameters.centerX, parameters.centerY);
@@ -468,6 +519,9 @@ bool GuiManager::renderFractalControls(FractalUIParameters &parameters) {
     float aspectRatio =
         (float)parameters.resolutionWidth / parameters.resolutionHeight;
     ImGui::Text("Aspect Ratio: %.3f", aspectRatio);
+    ImGui::Text("Accumulated Samples: %d", parameters.accumulatedSamples);
+    ImGui::Text("Render Scale: %.0f%%", parameters.renderScale * 100.0f);
+    ImGui::Text("Compute Time: %.2f ms", parameters.computeTime);
   }
 
   ImGui::PopStyleVar();
@@ -496,6 +550,32 @@ void GuiManager::renderMetricsPanel() {
   getFractalViewport(fractalWidth, fractalHeight);
   ImGui::Text("Fractal Viewport: %ux%u", fractalWidth, fractalHeight);
 
+  // Device memory pools
+  if (m_memoryManager) {
+    DeviceMemoryStats stats = m_memoryManager->getMemoryStats();
+    const float mb = 1024.0f * 1024.0f;
+
+    ImGui::Separator();
+    ImGui::Text("Device Memory: %.1f / %.1f MB used", stats.usedBytes / mb,
+                stats.reservedBytes / mb);
+    ImGui::Text("Blocks: %u (+%u dedicated)", stats.blockCount,
+                stats.dedicatedCount);
+    ImGui::Text("Allocations: %u", stats.allocationCount);
+    ImGui::Text("Largest Free Region: %.1f MB", stats.largestFreeBytes / mb);
+
+    // Per-heap budgets (driver-reported or estimated)
+    ImGui::Text("Heap Budgets (%s):",
+                m_memoryManager->isMemoryBudgetExtensionEnabled()
+                    ? "VK_EXT_memory_budget"
+                    : "estimated");
+    std::vector<HeapBudget> budgets = m_memoryManager->getHeapBudgets();
+    for (size_t i = 0; i < budgets.size(); i++) {
+      ImGui::Text("  Heap %zu%s: %.1f / %.1f MB", i,
+                  budgets[i].deviceLocal ? " (device)" : "",
+                  budgets[i].usage / mb, budgets[i].budget / mb);
+    }
+  }
+
   ImGui::End();
 }
 
@@ -32,6 +32,7 @@
 class VulkanSetup;
 class SwapchainManager;
 class GraphicsPipeline;
+class MemoryManager;
 
 /**
  * @struct FractalUIParameters
@@ -49,6 +50,14 @@ struct FractalUIParameters {
   int fractalType = 0;        ///< Fractal type (0=Mandelbrot, 1=Julia, etc.)
   int resolutionWidth = 800;  ///< Fractal resolution width
   int resolutionHeight = 600; ///< Fractal resolution height
+  int antiAliasingSamples = 0; ///< Adaptive AA sample cap (0 = off)
+  bool temporalAccumulation = true; ///< Accumulate samples on still frames
+  int accumulatedSamples = 1; ///< Samples in the displayed image (read-only)
+  bool dynamicResolution = true; ///< Render smaller while the view changes
+  float targetFrameTime = 33.0f; ///< Compute time target in milliseconds
+  float renderScale = 1.0f;      ///< Current per-axis scale (read-only)
+  float computeTime = 0.0f;      ///< Last full render in ms (read-only)
+  bool exportRequested = false; ///< Set when "Export Image" is clicked
 
   // UI state
   bool parametersChanged = true; ///< Flag indicating parameters have changed
@@ -166,11 +175,21 @@ public:
    */
   void getFractalViewport(uint32_t &width, uint32_t &height) const;
 
+  /**
+   * @brief Set the memory manager whose statistics the metrics panel shows
+   *
+   * @param memoryManager Shared memory manager (may be nullptr)
+   */
+  void setMemoryManager(std::shared_ptr<MemoryManager> memoryManager) {
+    m_memoryManager = memoryManager;
+  }
+
 private:
   // Vulkan resources
   std::shared_ptr<VulkanSetup> m_vulkanSetup;
   std::shared_ptr<SwapchainManager> m_swapchainManager;
   std::shared_ptr<GraphicsPipeline> m_graphicsPipeline;
+  std::shared_ptr<MemoryManager> m_memoryManager; ///< For memory statistics
   GLFWwindow *m_window;
 
   // ImGui Vulkan resources
@@ -0,0 +1,129 @@
+/**
+ * @file LayoutCache.cpp
+ * @brief Implementation of deduplicated layout creation
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "LayoutCache.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+LayoutCache::LayoutCache(VkDevice device) : m_device(device) {}
+
+LayoutCache::~LayoutCache() {
+  std::cout << "[LayoutCache] Destroying " << m_pipelineLayouts.size()
+            << " pipeline layouts and " << m_setLayouts.size()
+            << " descriptor set layouts" << std::endl;
+
+  for (const auto &[key, layout] : m_pipelineLayouts) {
+    vkDestroyPipelineLayout(m_device, layout, nullptr);
+  }
+  for (const auto &[key, layout] : m_setLayouts) {
+    vkDestroyDescriptorSetLayout(m_device, layout, nullptr);
+  }
+}
+
+VkDescriptorSetLayout LayoutCache::getDescriptorSetLayout(
+    std::vector<VkDescriptorSetLayoutBinding> bindings) {
+  std::sort(bindings.begin(), bindings.end(),
+            [](const VkDescriptorSetLayoutBinding &a,
+               const VkDescriptorSetLayoutBinding &b) {
+              return a.binding < b.binding;
+            });
+
+  std::vector<uint64_t> key;
+  key.reserve(bindings.size() * 4);
+  for (const auto &binding : bindings) {
+    key.insert(key.end(), {binding.binding,
+                           static_cast<uint64_t>(binding.descriptorType),
+                           binding.descriptorCount, binding.stageFlags});
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_setLayouts.find(key);
+  if (it != m_setLayouts.end()) {
+    return it->second;
+  }
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+  layoutInfo.pBindings = bindings.data();
+
+  VkDescriptorSetLayout layout;
+  VkResult result =
+      vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &layout);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error("Failed to create descriptor set layout: " +
+                             std::to_string(result));
+  }
+
+  m_setLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+VkPipelineLayout LayoutCache::getPipelineLayout(
+    const std::vector<VkDescriptorSetLayout> &setLayouts,
+    const std::vector<VkPushConstantRange> &pushConstantRanges) {
+  std::vector<uint64_t> key;
+  key.push_back(setLayouts.size());
+  for (VkDescriptorSetLayout setLayout : setLayouts) {
+    key.push_back(reinterpret_cast<uint64_t>(setLayout));
+  }
+  for (const auto &range : pushConstantRanges) {
+    key.insert(key.end(), {range.stageFlags, range.offset, range.size});
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_pipelineLayouts.find(key);
+  if (it != m_pipelineLayouts.end()) {
+    return it->second;
+  }
+
+  VkPipelineLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+  layoutInfo.pSetLayouts = setLayouts.data();
+  layoutInfo.pushConstantRangeCount =
+      static_cast<uint32_t>(pushConstantRanges.size());
+  layoutInfo.pPushConstantRanges = pushConstantRanges.data();
+
+  VkPipelineLayout layout;
+  VkResult result =
+      vkCreatePipelineLayout(m_device, &layoutInfo, nullptr, &layout);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error("Failed to create pipeline layout: " +
+                             std::to_string(result));
+  }
+
+  m_pipelineLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+std::vector<VkDescriptorSetLayout>
+LayoutCache::getDescriptorSetLayouts(const ShaderReflection &reflection) {
+  std::vector<VkDescriptorSetLayout> setLayouts;
+  for (uint32_t set = 0; set < reflection.getSetCount(); set++) {
+    setLayouts.push_back(
+        getDescriptorSetLayout(reflection.getSetBindings(set)));
+  }
+  return setLayouts;
+}
+
+VkPipelineLayout
+LayoutCache::getPipelineLayout(const ShaderReflection &reflection) {
+  return getPipelineLayout(getDescriptorSetLayouts(reflection),
+                           reflection.getPushConstantRanges());
+}
+
+void LayoutCache::getStatistics(size_t &setLayouts,
+                                size_t &pipelineLayouts) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  setLayouts = m_setLayouts.size();
+  pipelineLayouts = m_pipelineLayouts.size();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file LayoutCache.h
+ * @brief Deduplicated descriptor set and pipeline layouts
+ *
+ * This class hands out VkDescriptorSetLayout and VkPipelineLayout objects
+ * built from shader reflection. Pipelines with identical resource
+ * interfaces get the same layout objects, which also makes their
+ * descriptor sets compatible with each other.
+ *
+ * Phase 5 Focus:
+ * - One layout object per distinct interface, not per pipeline
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include "ShaderReflection.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @class LayoutCache
+ * @brief Owns every descriptor set and pipeline layout of the application
+ *
+ * Layouts live until the cache is destroyed; callers never destroy them.
+ */
+class LayoutCache {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param device Vulkan logical device
+   */
+  explicit LayoutCache(VkDevice device);
+
+  /**
+   * @brief Destructor - destroy all layouts
+   */
+  ~LayoutCache();
+
+  // Disable copy and move for simplicity
+  LayoutCache(const LayoutCache &) = delete;
+  LayoutCache &operator=(const LayoutCache &) = delete;
+  LayoutCache(LayoutCache &&) = delete;
+  LayoutCache &operator=(LayoutCache &&) = delete;
+
+  /**
+   * @brief Get a descriptor set layout for a list of bindings
+   *
+   * @param bindings Layout bindings, in any order
+   * @return Shared layout handle
+   *
+   * @throws std::runtime_error If layout creation fails
+   */
+  VkDescriptorSetLayout getDescriptorSetLayout(
+      std::vector<VkDescriptorSetLayoutBinding> bindings);
+
+  /**
+   * @brief Get a pipeline layout for set layouts and push constant ranges
+   *
+   * @param setLayouts Descriptor set layouts, indexed by set number
+   * @param pushConstantRanges Push constant ranges
+   * @return Shared layout handle
+   *
+   * @throws std::runtime_error If layout creation fails
+   */
+  VkPipelineLayout getPipelineLayout(
+      const std::vector<VkDescriptorSetLayout> &setLayouts,
+      const std::vector<VkPushConstantRange> &pushConstantRanges);
+
+  /**
+   * @brief Get the set layouts of a reflected interface
+   *
+   * @param reflection Merged reflection of a pipeline's shaders
+   * @return One layout per set index, empty sets included
+   */
+  std::vector<VkDescriptorSetLayout>
+  getDescriptorSetLayouts(const ShaderReflection &reflection);
+
+  /**
+   * @brief Get the pipeline layout of a reflected interface
+   *
+   * @param reflection Merged reflection of a pipeline's shaders
+   * @return Shared layout handle
+   */
+  VkPipelineLayout getPipelineLayout(const ShaderReflection &reflection);
+
+  /**
+   * @brief Get the number of distinct layouts created so far
+   *
+   * @param setLayouts Output descriptor set layout count
+   * @param pipelineLayouts Output pipeline layout count
+   */
+  void getStatistics(size_t &setLayouts, size_t &pipelineLayouts) const;
+
+private:
+  VkDevice m_device; ///< Vulkan logical device
+
+  mutable std::mutex m_mutex; ///< Guards both maps
+  std::map<std::vector<uint64_t>, VkDescriptorSetLayout>
+      m_setLayouts; ///< Binding tuples -> layout
+  std::map<std::vector<uint64_t>, VkPipelineLayout>
+      m_pipelineLayouts; ///< Set layouts and push ranges -> layout
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Keys:
+ *    - Set layouts are keyed by (binding, type, count, stages) sorted by
+ *      binding; pipeline layouts by their set layout handles and push
+ *      constant ranges, which is exact because set layouts are unique
+ *
+ * 2. Lifetime:
+ *    - Owned by ShaderManager, which outlives every pipeline; nothing is
+ *      destroyed while the application runs, so a layout handle stays
+ *      valid for hot-reloaded pipelines too
+ */
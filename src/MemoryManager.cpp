@@ -8,17 +8,42 @@
  */
 
 #include "MemoryManager.h"
+#include "StagingRing.h"
+
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
 
+namespace {
+
+// Staging space for uploads and readbacks; larger transfers are chunked
+constexpr VkDeviceSize STAGING_RING_SIZE = 16ull * 1024 * 1024;
+constexpr VkDeviceSize READBACK_RING_SIZE = 16ull * 1024 * 1024;
+
+// Without VK_EXT_memory_budget, assume this share of a heap is ours to use
+constexpr VkDeviceSize ESTIMATED_BUDGET_PERCENT = 80;
+
+// Usage above this share of the budget counts as memory pressure
+constexpr VkDeviceSize BUDGET_PRESSURE_PERCENT = 90;
+
+// Size classes: four per power of two, nothing below 64 KB
+constexpr VkDeviceSize MIN_SIZE_CLASS = 64 * 1024;
+constexpr VkDeviceSize SIZE_CLASSES_PER_OCTAVE = 4;
+
+} // namespace
+
 MemoryManager::MemoryManager(VkDevice device, VkPhysicalDevice physicalDevice)
     : m_device(device), m_physicalDevice(physicalDevice),
-      m_totalAllocatedMemory(0) {
+      m_totalAllocatedMemory(0), m_getMemoryProperties2(nullptr),
+      m_unifiedMemory(false) {
 
   // Get physical device memory properties
   vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
 
+  m_allocator =
+      std::make_unique<DeviceMemoryAllocator>(m_device, m_physicalDevice);
+
   std::cout << "[MemoryManager] Initialized with "
             << m_memoryProperties.memoryTypeCount << " memory types and "
             << m_memoryProperties.memoryHeapCount << " memory heaps"
@@ -34,12 +59,47 @@ MemoryManager::MemoryManager(VkDevice device, VkPhysicalDevice physicalDevice)
     }
     std::cout << std::endl;
   }
+
+  // Only integrated and CPU devices really share memory with the host; a
+  // discrete GPU's host-visible VRAM is slow to read from the CPU
+  VkPhysicalDeviceProperties deviceProperties;
+  vkGetPhysicalDeviceProperties(m_physicalDevice, &deviceProperties);
+  bool sharedMemoryDevice =
+      deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU ||
+      deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+  VkMemoryPropertyFlags unifiedFlags =
+      memoryLocationToVulkanFlags(MemoryLocation::GPU_HOST_VISIBLE);
+  for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+    if (sharedMemoryDevice &&
+        (m_memoryProperties.memoryTypes[i].propertyFlags & unifiedFlags) ==
+            unifiedFlags) {
+      m_unifiedMemory = true;
+      break;
+    }
+  }
+  if (m_unifiedMemory) {
+    std::cout << "[MemoryManager] Unified memory: results are read in place"
+              << std::endl;
+  }
 }
 
 MemoryManager::~MemoryManager() {
+  // The ring waits for its in-flight copies and releases its buffer; with
+  // the rings gone, deferred buffer frees no longer wait for batches
+  m_stagingRing.reset();
+  m_readbackRing.reset();
+
+  // Deferred deleters still reference buffers, images and the allocator
+  m_deletionQueue.flush();
+
   std::cout << "[MemoryManager] Cleaning up " << m_buffers.size()
             << " buffers..." << std::endl;
   clearBuffers();
+  for (const auto &[image, allocation] : m_imageAllocations) {
+    vkDestroyImage(m_device, image, nullptr);
+    m_allocator->free(allocation);
+  }
+  m_imageAllocations.clear();
   std::cout << "[MemoryManager] Cleanup complete. Total memory freed: "
             << (m_totalAllocatedMemory / (1024 * 1024)) << " MB" << std::endl;
 }
@@ -54,23 +114,53 @@ std::shared_ptr<BufferInfo> MemoryManager::createBuffer(const std::string &name,
   VkMemoryPropertyFlags memoryProperties =
       memoryLocationToVulkanFlags(location);
 
+  // The output buffer is the only one compute hands to graphics
   return createBufferExplicit(name, size, usageFlags, memoryProperties,
-                              persistentMap);
+                              persistentMap,
+                              usage == BufferUsage::FRACTAL_OUTPUT_BUFFER);
+}
+
+void MemoryManager::setSharedQueueFamilies(
+    const std::vector<uint32_t> &queueFamilies) {
+  m_sharedQueueFamilies.clear();
+  for (uint32_t family : queueFamilies) {
+    if (std::find(m_sharedQueueFamilies.begin(), m_sharedQueueFamilies.end(),
+                  family) == m_sharedQueueFamilies.end()) {
+      m_sharedQueueFamilies.push_back(family);
+    }
+  }
+  if (m_sharedQueueFamilies.size() < 2) {
+    m_sharedQueueFamilies.clear();
+  }
+}
+
+VkDeviceSize MemoryManager::sizeClassFor(VkDeviceSize size) {
+  if (size <= MIN_SIZE_CLASS) {
+    return MIN_SIZE_CLASS;
+  }
+
+  // Largest power of two not above size; classes step by a fraction of it
+  VkDeviceSize octave = 1;
+  while (octave <= size / 2) {
+    octave <<= 1;
+  }
+  VkDeviceSize step = octave / SIZE_CLASSES_PER_OCTAVE;
+  return (size + step - 1) / step * step;
+}
+
+bool MemoryManager::fitsSizeClass(VkDeviceSize capacity, VkDeviceSize size) {
+  return capacity >= size && capacity <= 2 * sizeClassFor(size);
 }
 
 std::shared_ptr<BufferInfo> MemoryManager::createBufferExplicit(
     const std::string &name, VkDeviceSize size, VkBufferUsageFlags usageFlags,
-    VkMemoryPropertyFlags memoryProperties, bool persistentMap) {
+    VkMemoryPropertyFlags memoryProperties, bool persistentMap, bool shared) {
   std::cout << "[MemoryManager] Creating buffer '" << name
             << "' (size: " << (size / 1024) << " KB)" << std::endl;
 
-  // Check if buffer already exists
-  if (getBuffer(name)) {
-    throw std::runtime_error("Buffer with name '" + name + "' already exists");
-  }
-
   // Create buffer info structure
   auto bufferInfo = std::make_shared<BufferInfo>();
+  bufferInfo->name = name;
   bufferInfo->size = size;
   bufferInfo->offset = 0;
   bufferInfo->mappedData = nullptr;
@@ -83,6 +173,12 @@ std::shared_ptr<BufferInfo> MemoryManager::createBufferExplicit(
     bufferCreateInfo.size = size;
     bufferCreateInfo.usage = usageFlags;
     bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (shared && !m_sharedQueueFamilies.empty()) {
+      bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+      bufferCreateInfo.queueFamilyIndexCount =
+          static_cast<uint32_t>(m_sharedQueueFamilies.size());
+      bufferCreateInfo.pQueueFamilyIndices = m_sharedQueueFamilies.data();
+    }
 
     VkResult result = vkCreateBuffer(m_device, &bufferCreateInfo, nullptr,
                                      &bufferInfo->buffer);
@@ -100,26 +196,22 @@ std::shared_ptr<BufferInfo> MemoryManager::createBufferExplicit(
     uint32_t memoryTypeIndex =
         findMemoryType(memRequirements.memoryTypeBits, memoryProperties);
 
-    // Allocate memory
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-
-    result =
-        vkAllocateMemory(m_device, &allocInfo, nullptr, &bufferInfo->memory);
-    if (result != VK_SUCCESS) {
+    // Sub-allocate from a pooled block
+    try {
+      bufferInfo->allocation =
+          allocateMemory(memRequirements, memoryTypeIndex, ResourceKind::LINEAR);
+    } catch (const std::exception &) {
       vkDestroyBuffer(m_device, bufferInfo->buffer, nullptr);
-      throw std::runtime_error(
-          "Failed to allocate buffer memory! Vulkan error: " +
-          std::to_string(result));
+      throw;
     }
+    bufferInfo->memory = bufferInfo->allocation.memory;
+    bufferInfo->offset = bufferInfo->allocation.offset;
 
-    // Bind buffer to memory
-    result =
-        vkBindBufferMemory(m_device, bufferInfo->buffer, bufferInfo->memory, 0);
+    // Bind buffer to its region of the block
+    result = vkBindBufferMemory(m_device, bufferInfo->buffer,
+                                bufferInfo->memory, bufferInfo->offset);
     if (result != VK_SUCCESS) {
-      vkFreeMemory(m_device, bufferInfo->memory, nullptr);
+      m_allocator->free(bufferInfo->allocation);
       vkDestroyBuffer(m_device, bufferInfo->buffer, nullptr);
       throw std::runtime_error("Failed to bind buffer memory! Vulkan error: " +
                                std::to_string(result));
@@ -134,8 +226,14 @@ std::shared_ptr<BufferInfo> MemoryManager::createBufferExplicit(
       bufferInfo->mappedData = mapBuffer(bufferInfo);
     }
 
-    // Cache the buffer
-    m_buffers[name] = bufferInfo;
+    // Track the buffer
+    bufferInfo->handle = m_buffers.insert(bufferInfo);
+#ifndef NDEBUG
+    {
+      std::lock_guard<std::mutex> lock(m_debugNameMutex);
+      m_debugNames[name] = bufferInfo->handle;
+    }
+#endif
 
     std::cout << "[MemoryManager] Successfully created buffer '" << name
               << "' (allocated: " << (memRequirements.size / 1024) << " KB, "
@@ -163,74 +261,45 @@ void MemoryManager::uploadBufferData(std::shared_ptr<BufferInfo> buffer,
     throw std::runtime_error("Upload data exceeds buffer size");
   }
 
-  // Check if buffer memory is host-visible (can be mapped)
-  VkMemoryRequirements memRequirements;
-  vkGetBufferMemoryRequirements(m_device, buffer->buffer, &memRequirements);
-
-  VkMemoryPropertyFlags memFlags;
-  vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
-
-  // Find the memory type index for this buffer
-  for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
-    if ((memRequirements.memoryTypeBits & (1 << i))) {
-      // Get the memory properties for this type
-      VkDeviceMemory memory;
-      VkMemoryAllocateInfo allocInfo{};
-      allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-      allocInfo.memoryTypeIndex = i;
-
-      memFlags = m_memoryProperties.memoryTypes[i].propertyFlags;
-      break;
-    }
-  }
-
-  if (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
-    // Direct copy for host-visible memory
-    void *mappedMemory;
-    VkResult result =
-        vkMapMemory(m_device, buffer->memory, offset, size, 0, &mappedMemory);
-    if (result != VK_SUCCESS) {
-      throw std::runtime_error("Failed to map buffer memory for upload");
-    }
-
-    std::memcpy(mappedMemory, data, size);
+  if (isHostVisible(*buffer)) {
+    // Direct copy for host-visible memory (the block is always mapped)
+    auto *mappedMemory =
+        static_cast<uint8_t *>(m_allocator->map(buffer->allocation));
+    std::memcpy(mappedMemory + offset, data, size);
 
     // Flush if not coherent
-    if (!(memFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
-      VkMappedMemoryRange range{};
-      range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-      range.memory = buffer->memory;
-      range.offset = offset;
-      range.size = size;
-      vkFlushMappedMemoryRanges(m_device, 1, &range);
-    }
-
-    vkUnmapMemory(m_device, buffer->memory);
+    m_allocator->flush(buffer->allocation, offset, size);
 
   } else {
-    // Use staging buffer for device-local memory
+    // Use the staging ring for device-local memory
     if (commandPool == VK_NULL_HANDLE || queue == VK_NULL_HANDLE) {
       throw std::runtime_error(
           "Command pool and queue required for staging buffer upload");
     }
 
-    // Create temporary staging buffer
-    auto stagingBuffer = createStagingBuffer(size);
-
-    // Copy data to staging buffer
-    void *mappedMemory;
-    VkResult result =
-        vkMapMemory(m_device, stagingBuffer->memory, 0, size, 0, &mappedMemory);
-    if (result != VK_SUCCESS) {
-      throw std::runtime_error("Failed to map staging buffer memory");
+    // Half-ring chunks let one chunk copy while the next is written
+    StagingRing &ring = getStagingRing();
+    VkDeviceSize chunkSize = ring.getCapacity() / 2;
+    const auto *source = static_cast<const uint8_t *>(data);
+
+    for (VkDeviceSize done = 0; done < size; done += chunkSize) {
+      VkDeviceSize bytes = std::min(chunkSize, size - done);
+      StagingRegion region = ring.allocate(bytes);
+      std::memcpy(region.data, source + done, bytes);
+
+      VkBufferCopy copyRegion{};
+      copyRegion.srcOffset = region.offset;
+      copyRegion.dstOffset = offset + done;
+      copyRegion.size = bytes;
+      VkBuffer dstBuffer = buffer->buffer;
+      submitStagingBatch(
+          ring, commandPool, queue,
+          [&](VkCommandBuffer commandBuffer) {
+            vkCmdCopyBuffer(commandBuffer, region.buffer, dstBuffer, 1,
+                            &copyRegion);
+          },
+          nullptr);
     }
-
-    std::memcpy(mappedMemory, data, size);
-    vkUnmapMemory(m_device, stagingBuffer->memory);
-
-    // Copy from staging buffer to target buffer
-    copyBufferToBuffer(stagingBuffer->buffer, buffer->buffer, size, 0, offset,
-                       commandPool, queue);
   }
 }
 
@@ -245,17 +314,116 @@ void MemoryManager::downloadBufferData(std::shared_ptr<BufferInfo> buffer,
     throw std::runtime_error("Download size exceeds buffer size");
   }
 
-  // Map memory and copy data
-  void *mappedMemory;
-  VkResult result =
-      vkMapMemory(m_device, buffer->memory, offset, size, 0, &mappedMemory);
-  if (result != VK_SUCCESS) {
+  if (!isHostVisible(*buffer)) {
     throw std::runtime_error("Failed to map buffer memory for download (buffer "
-                             "may not be host-visible)");
+                             "is not host-visible)");
+  }
+
+  // Make device writes visible, then copy out of the block mapping
+  m_allocator->invalidate(buffer->allocation, offset, size);
+  auto *mappedMemory =
+      static_cast<const uint8_t *>(m_allocator->map(buffer->allocation));
+  std::memcpy(data, mappedMemory + offset, size);
+}
+
+void MemoryManager::readBufferDataAsync(std::shared_ptr<BufferInfo> buffer,
+                                        VkDeviceSize size, VkDeviceSize offset,
+                                        VkCommandPool commandPool,
+                                        VkQueue queue,
+                                        ReadbackCallback onChunk) {
+  if (!buffer) {
+    throw std::runtime_error("Invalid buffer for readback operation");
+  }
+
+  if (offset + size > buffer->size) {
+    throw std::runtime_error("Readback size exceeds buffer size");
+  }
+
+  // Host-visible source: only wait for the writes, then read in place
+  if (isHostVisible(*buffer)) {
+    const auto *source =
+        static_cast<const uint8_t *>(m_allocator->map(buffer->allocation)) +
+        offset;
+    submitStagingBatch(
+        getReadbackRing(), commandPool, queue,
+        [](VkCommandBuffer commandBuffer) {
+          VkMemoryBarrier barrier{};
+          barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+          barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+          barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+          vkCmdPipelineBarrier(commandBuffer,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0,
+                               nullptr, 0, nullptr);
+        },
+        [this, onChunk, buffer, source, offset, size]() {
+          m_allocator->invalidate(buffer->allocation, offset, size);
+          onChunk(source, 0, size);
+        });
+    return;
+  }
+
+  StagingRing &ring = getReadbackRing();
+  VkDeviceSize chunkSize = ring.getCapacity() / 2;
+  DeviceAllocation ringAllocation = ring.getBuffer()->allocation;
+
+  for (VkDeviceSize done = 0; done < size; done += chunkSize) {
+    VkDeviceSize bytes = std::min(chunkSize, size - done);
+    StagingRegion region = ring.allocate(bytes);
+
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = offset + done;
+    copyRegion.dstOffset = region.offset;
+    copyRegion.size = bytes;
+    VkBuffer srcBuffer = buffer->buffer;
+
+    submitStagingBatch(
+        ring, commandPool, queue,
+        [&](VkCommandBuffer commandBuffer) {
+          // Earlier writes on this queue (compute, transfers) -> copy
+          VkMemoryBarrier barrier{};
+          barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+          barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+          barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+          vkCmdPipelineBarrier(commandBuffer,
+                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier,
+                               0, nullptr, 0, nullptr);
+
+          vkCmdCopyBuffer(commandBuffer, srcBuffer, region.buffer, 1,
+                          &copyRegion);
+
+          // Copy -> host read once the fence has signalled
+          barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+          barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+          vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0,
+                               nullptr, 0, nullptr);
+        },
+        [this, onChunk, ringAllocation, region, done, bytes]() {
+          // Cached memory is not necessarily coherent
+          m_allocator->invalidate(ringAllocation, region.offset, bytes);
+          onChunk(region.data, done, bytes);
+        });
+  }
+}
+
+void MemoryManager::processCompletedTransfers() {
+  if (m_stagingRing) {
+    m_stagingRing->retireCompleted();
   }
+  if (m_readbackRing) {
+    m_readbackRing->retireCompleted();
+  }
+}
 
-  std::memcpy(data, mappedMemory, size);
-  vkUnmapMemory(m_device, buffer->memory);
+void MemoryManager::waitForTransfers() {
+  if (m_stagingRing) {
+    m_stagingRing->waitIdle();
+  }
+  if (m_readbackRing) {
+    m_readbackRing->waitIdle();
+  }
 }
 
 void *MemoryManager::mapBuffer(std::shared_ptr<BufferInfo> buffer) {
@@ -267,12 +435,12 @@ void *MemoryManager::mapBuffer(std::shared_ptr<BufferInfo> buffer) {
     return buffer->mappedData; // Already mapped
   }
 
-  VkResult result = vkMapMemory(m_device, buffer->memory, 0, buffer->size, 0,
-                                &buffer->mappedData);
-  if (result != VK_SUCCESS) {
+  if (!isHostVisible(*buffer)) {
     throw std::runtime_error("Failed to map buffer memory");
   }
 
+  // Blocks stay mapped; the buffer gets a pointer into the block mapping
+  buffer->mappedData = m_allocator->map(buffer->allocation);
   return buffer->mappedData;
 }
 
@@ -282,77 +450,218 @@ void MemoryManager::unmapBuffer(std::shared_ptr<BufferInfo> buffer) {
   }
 
   if (!buffer->persistentlyMapped) {
-    vkUnmapMemory(m_device, buffer->memory);
     buffer->mappedData = nullptr;
   }
 }
 
 std::shared_ptr<BufferInfo>
-MemoryManager::getBuffer(const std::string &name) const {
-  auto it = m_buffers.find(name);
-  if (it != m_buffers.end()) {
-    return it->second;
+MemoryManager::getBuffer(BufferHandle handle) const {
+  return m_buffers.get(handle);
+}
+
+bool MemoryManager::removeBuffer(BufferHandle handle) {
+  std::shared_ptr<BufferInfo> buffer = untrackBuffer(handle);
+  if (!buffer) {
+    return false;
   }
-  return nullptr;
+
+  std::cout << "[MemoryManager] Removing buffer: " << buffer->name
+            << std::endl;
+  destroyBufferResources(*buffer);
+
+  // Update tracking
+  m_totalAllocatedMemory -= buffer->size;
+  return true;
 }
 
-bool MemoryManager::removeBuffer(const std::string &name) {
-  auto it = m_buffers.find(name);
-  if (it != m_buffers.end()) {
-    std::cout << "[MemoryManager] Removing buffer: " << name << std::endl;
+bool MemoryManager::removeBufferDeferred(BufferHandle handle) {
+  std::shared_ptr<BufferInfo> buffer = untrackBuffer(handle);
+  if (!buffer) {
+    return false;
+  }
 
-    auto buffer = it->second;
+  // The bytes stay allocated until the deleter runs. Staged copies can run
+  // on a queue the frame fences do not cover, so the buffer also outlives
+  // every batch the rings have submitted so far.
+  uint64_t stagingBatch = m_stagingRing ? m_stagingRing->getLastBatch() : 0;
+  uint64_t readbackBatch =
+      m_readbackRing ? m_readbackRing->getLastBatch() : 0;
+  enqueueBufferDestruction(buffer, stagingBatch, readbackBatch);
+  return true;
+}
 
-    // Unmap if mapped
-    if (buffer->mappedData) {
-      vkUnmapMemory(m_device, buffer->memory);
+void MemoryManager::enqueueBufferDestruction(
+    std::shared_ptr<BufferInfo> buffer, uint64_t stagingBatch,
+    uint64_t readbackBatch) {
+  m_deletionQueue.enqueue([this, buffer, stagingBatch, readbackBatch]() {
+    // Poll only; a transfer still running pushes the buffer to a later frame
+    processCompletedTransfers();
+    bool stagingDone =
+        !m_stagingRing || m_stagingRing->isBatchRetired(stagingBatch);
+    bool readbackDone =
+        !m_readbackRing || m_readbackRing->isBatchRetired(readbackBatch);
+    if (!stagingDone || !readbackDone) {
+      enqueueBufferDestruction(buffer, stagingBatch, readbackBatch);
+      return;
     }
 
-    // Destroy Vulkan objects
-    vkDestroyBuffer(m_device, buffer->buffer, nullptr);
-    vkFreeMemory(m_device, buffer->memory, nullptr);
-
-    // Update tracking
+    destroyBufferResources(*buffer);
     m_totalAllocatedMemory -= buffer->size;
+  });
+}
 
-    // Remove from cache
-    m_buffers.erase(it);
-    return true;
-  }
-  return false;
+#ifndef NDEBUG
+std::shared_ptr<BufferInfo>
+MemoryManager::findBufferByName(const std::string &name) const {
+  std::lock_guard<std::mutex> lock(m_debugNameMutex);
+  auto it = m_debugNames.find(name);
+  return it != m_debugNames.end() ? m_buffers.get(it->second) : nullptr;
 }
+#endif
 
 void MemoryManager::clearBuffers() {
-  for (const auto &[name, buffer] : m_buffers) {
-    std::cout << "[MemoryManager] Destroying buffer: " << name << std::endl;
+  for (const auto &buffer : m_buffers.removeAll()) {
+    std::cout << "[MemoryManager] Destroying buffer: " << buffer->name
+              << std::endl;
+    destroyBufferResources(*buffer);
+  }
+
+#ifndef NDEBUG
+  {
+    std::lock_guard<std::mutex> lock(m_debugNameMutex);
+    m_debugNames.clear();
+  }
+#endif
+  m_totalAllocatedMemory = 0;
+}
+
+size_t MemoryManager::getBufferCount() const { return m_buffers.size(); }
+
+VkDeviceSize MemoryManager::getTotalAllocatedMemory() const {
+  return m_totalAllocatedMemory;
+}
+
+bool MemoryManager::enableMemoryBudgetExtension(VkInstance instance) {
+  m_getMemoryProperties2 =
+      reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(
+          vkGetInstanceProcAddr(instance,
+                                "vkGetPhysicalDeviceMemoryProperties2KHR"));
+  if (!m_getMemoryProperties2) {
+    std::cerr << "[MemoryManager] vkGetPhysicalDeviceMemoryProperties2KHR "
+              << "not found, estimating memory budgets" << std::endl;
+    return false;
+  }
+
+  std::cout << "[MemoryManager] Using VK_EXT_memory_budget for heap budgets"
+            << std::endl;
+  return true;
+}
+
+bool MemoryManager::isMemoryBudgetExtensionEnabled() const {
+  return m_getMemoryProperties2 != nullptr;
+}
+
+std::vector<HeapBudget> MemoryManager::getHeapBudgets() const {
+  std::vector<HeapBudget> budgets(m_memoryProperties.memoryHeapCount);
+
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+  budgetProperties.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+  if (m_getMemoryProperties2) {
+    VkPhysicalDeviceMemoryProperties2KHR properties{};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+    properties.pNext = &budgetProperties;
+    m_getMemoryProperties2(m_physicalDevice, &properties);
+  }
+
+  for (uint32_t i = 0; i < m_memoryProperties.memoryHeapCount; i++) {
+    const VkMemoryHeap &heap = m_memoryProperties.memoryHeaps[i];
+    budgets[i].deviceLocal = heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    if (m_getMemoryProperties2) {
+      budgets[i].budget = budgetProperties.heapBudget[i];
+      budgets[i].usage = budgetProperties.heapUsage[i];
+    } else {
+      budgets[i].budget = heap.size / 100 * ESTIMATED_BUDGET_PERCENT;
+      budgets[i].usage = m_allocator->getHeapUsage(i);
+    }
+  }
+  return budgets;
+}
 
-    // Unmap if mapped
-    if (buffer->mappedData) {
-      vkUnmapMemory(m_device, buffer->memory);
+VkDeviceSize MemoryManager::getAvailableMemory(MemoryLocation location) const {
+  // Heap of the first memory type a resource in this location could use
+  VkMemoryPropertyFlags flags = memoryLocationToVulkanFlags(location);
+  for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+    if ((m_memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+      HeapBudget heap =
+          getHeapBudgets()[m_memoryProperties.memoryTypes[i].heapIndex];
+      return heap.usage < heap.budget ? heap.budget - heap.usage : 0;
     }
+  }
+  return 0;
+}
 
-    // Destroy Vulkan objects
-    vkDestroyBuffer(m_device, buffer->buffer, nullptr);
-    vkFreeMemory(m_device, buffer->memory, nullptr);
+bool MemoryManager::isNearBudget() const {
+  for (const HeapBudget &heap : getHeapBudgets()) {
+    if (heap.usage > heap.budget / 100 * BUDGET_PRESSURE_PERCENT) {
+      return true;
+    }
   }
+  return false;
+}
 
-  m_buffers.clear();
-  m_totalAllocatedMemory = 0;
+VkDeviceSize MemoryManager::trimCaches() {
+  // Rings with nothing in flight are recreated on the next transfer
+  std::unique_ptr<StagingRing> *rings[] = {&m_stagingRing, &m_readbackRing};
+  for (std::unique_ptr<StagingRing> *ring : rings) {
+    if (*ring) {
+      (*ring)->retireCompleted();
+      if ((*ring)->getInFlightBatchCount() == 0) {
+        ring->reset();
+      }
+    }
+  }
+
+  VkDeviceSize released = m_allocator->releaseEmptyBlocks();
+  if (released > 0) {
+    std::cout << "[MemoryManager] Released " << (released / (1024 * 1024))
+              << " MB of cached device memory" << std::endl;
+  }
+  return released;
+}
+
+DeviceMemoryStats MemoryManager::getMemoryStats() const {
+  return m_allocator->getStats();
+}
+
+bool MemoryManager::isHostVisible(const BufferInfo &buffer) const {
+  return m_allocator->getMemoryProperties(buffer.allocation) &
+         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
 }
 
-std::vector<std::string> MemoryManager::getBufferNames() const {
-  std::vector<std::string> names;
-  names.reserve(m_buffers.size());
+std::shared_ptr<BufferInfo> MemoryManager::untrackBuffer(BufferHandle handle) {
+  std::shared_ptr<BufferInfo> buffer;
+  if (!m_buffers.remove(handle, &buffer)) {
+    return nullptr;
+  }
 
-  for (const auto &[name, buffer] : m_buffers) {
-    names.push_back(name);
+#ifndef NDEBUG
+  {
+    std::lock_guard<std::mutex> lock(m_debugNameMutex);
+    auto it = m_debugNames.find(buffer->name);
+    if (it != m_debugNames.end() && it->second == handle) {
+      m_debugNames.erase(it);
+    }
   }
+#endif
 
-  return names;
+  return buffer;
 }
 
-VkDeviceSize MemoryManager::getTotalAllocatedMemory() const {
-  return m_totalAllocatedMemory;
+void MemoryManager::destroyBufferResources(const BufferInfo &buffer) {
+  // The block mapping outlives the buffer, so there is nothing to unmap
+  vkDestroyBuffer(m_device, buffer.buffer, nullptr);
+  m_allocator->free(buffer.allocation);
 }
 
 uint32_t MemoryManager::findMemoryType(uint32_t typeFilter,
@@ -388,13 +697,17 @@ VkBufferUsageFlags MemoryManager::bufferUsageToVulkanFlags(BufferUsage usage) {
   case BufferUsage::FRACTAL_PARAMS_BUFFER:
     return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
            VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  case BufferUsage::INDIRECT_BUFFER:
+    return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+           VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+           VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   default:
     throw std::runtime_error("Unsupported buffer usage type");
   }
 }
 
 VkMemoryPropertyFlags
-MemoryManager::memoryLocationToVulkanFlags(MemoryLocation location) {
+MemoryManager::memoryLocationToVulkanFlags(MemoryLocation location) const {
   switch (location) {
   case MemoryLocation::GPU_ONLY:
     return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
@@ -407,28 +720,65 @@ MemoryManager::memoryLocationToVulkanFlags(MemoryLocation location) {
   case MemoryLocation::CPU_GPU_SHARED:
     return VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  case MemoryLocation::GPU_HOST_VISIBLE:
+    return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
   default:
     throw std::runtime_error("Unsupported memory location type");
   }
 }
 
-std::shared_ptr<BufferInfo>
-MemoryManager::createStagingBuffer(VkDeviceSize size) {
-  static int stagingCount = 0;
-  std::string name = "staging_" + std::to_string(stagingCount++);
-
-  return createBufferExplicit(name, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                              false);
-}
-
-void MemoryManager::copyBufferToBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
-                                       VkDeviceSize size,
-                                       VkDeviceSize srcOffset,
-                                       VkDeviceSize dstOffset,
-                                       VkCommandPool commandPool,
-                                       VkQueue queue) {
+DeviceAllocation
+MemoryManager::allocateMemory(const VkMemoryRequirements &requirements,
+                              uint32_t memoryTypeIndex, ResourceKind kind) {
+  try {
+    return m_allocator->allocate(requirements, memoryTypeIndex, kind);
+  } catch (const std::runtime_error &e) {
+    // Caches are cheap to rebuild; give their memory back and try again
+    VkDeviceSize released = trimCaches();
+    if (released == 0) {
+      throw;
+    }
+    std::cerr << "[MemoryManager] Allocation failed (" << e.what()
+              << "), retrying after releasing " << (released / (1024 * 1024))
+              << " MB of cached memory" << std::endl;
+    return m_allocator->allocate(requirements, memoryTypeIndex, kind);
+  }
+}
+
+StagingRing &MemoryManager::getStagingRing() {
+  if (!m_stagingRing) {
+    m_stagingRing = std::make_unique<StagingRing>(
+        m_device, *this, "staging_ring", STAGING_RING_SIZE,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  }
+  return *m_stagingRing;
+}
+
+StagingRing &MemoryManager::getReadbackRing() {
+  if (!m_readbackRing) {
+    try {
+      m_readbackRing = std::make_unique<StagingRing>(
+          m_device, *this, "readback_ring", READBACK_RING_SIZE,
+          memoryLocationToVulkanFlags(MemoryLocation::GPU_TO_CPU));
+    } catch (const std::exception &e) {
+      std::cerr << "[MemoryManager] No host-cached memory for readbacks ("
+                << e.what() << "), using coherent memory" << std::endl;
+      m_readbackRing = std::make_unique<StagingRing>(
+          m_device, *this, "readback_ring", READBACK_RING_SIZE,
+          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+  }
+  return *m_readbackRing;
+}
+
+void MemoryManager::submitStagingBatch(
+    StagingRing &ring, VkCommandPool commandPool, VkQueue queue,
+    const std::function<void(VkCommandBuffer)> &record,
+    std::function<void()> onComplete) {
   // Allocate command buffer
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -437,34 +787,44 @@ void MemoryManager::copyBufferToBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
   allocInfo.commandBufferCount = 1;
 
   VkCommandBuffer commandBuffer;
-  vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer);
+  VkResult result =
+      vkAllocateCommandBuffers(m_device, &allocInfo, &commandBuffer);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to allocate transfer command buffer! Vulkan error: " +
+        std::to_string(result));
+  }
 
-  // Record copy command
+  // Record transfer commands
   VkCommandBufferBeginInfo beginInfo{};
   beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   vkBeginCommandBuffer(commandBuffer, &beginInfo);
-
-  VkBufferCopy copyRegion{};
-  copyRegion.srcOffset = srcOffset;
-  copyRegion.dstOffset = dstOffset;
-  copyRegion.size = size;
-  vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-
+  record(commandBuffer);
   vkEndCommandBuffer(commandBuffer);
 
-  // Submit and wait
+  // The command buffer lives until the batch's fence signals
+  VkDevice device = m_device;
+  ring.onBatchComplete([device, commandPool, commandBuffer, onComplete]() {
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    if (onComplete) {
+      onComplete();
+    }
+  });
+
+  // Submit without waiting; the fence retires the staging space
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   submitInfo.commandBufferCount = 1;
   submitInfo.pCommandBuffers = &commandBuffer;
 
-  vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-  vkQueueWaitIdle(queue);
-
-  // Free command buffer
-  vkFreeCommandBuffers(m_device, commandPool, 1, &commandBuffer);
+  result = vkQueueSubmit(queue, 1, &submitInfo, ring.endBatch());
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to submit transfer commands! Vulkan error: " +
+        std::to_string(result));
+  }
 }
 
 bool MemoryManager::createImage(uint32_t width, uint32_t height,
@@ -510,22 +870,32 @@ bool MemoryManager::createImage(uint32_t width, uint32_t height,
     return false;
   }
 
-  // Allocate memory
-  VkMemoryAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  allocInfo.allocationSize = memRequirements.size;
-  allocInfo.memoryTypeIndex = memoryTypeIndex;
-
-  if (vkAllocateMemory(m_device, &allocInfo, nullptr, &imageMemory) !=
-      VK_SUCCESS) {
-    std::cerr << "[MemoryManager] Failed to allocate image memory!"
-              << std::endl;
+  // Sub-allocate; optimal-tiling images get blocks of their own so they
+  // never share a bufferImageGranularity page with a buffer
+  DeviceAllocation allocation;
+  try {
+    allocation = allocateMemory(memRequirements, memoryTypeIndex,
+                                tiling == VK_IMAGE_TILING_OPTIMAL
+                                    ? ResourceKind::OPTIMAL
+                                    : ResourceKind::LINEAR);
+  } catch (const std::runtime_error &e) {
+    std::cerr << "[MemoryManager] Failed to allocate image memory: "
+              << e.what() << std::endl;
     vkDestroyImage(m_device, image, nullptr);
     return false;
   }
 
   // Bind memory to image
-  vkBindImageMemory(m_device, image, imageMemory, 0);
+  if (vkBindImageMemory(m_device, image, allocation.memory,
+                        allocation.offset) != VK_SUCCESS) {
+    std::cerr << "[MemoryManager] Failed to bind image memory!" << std::endl;
+    m_allocator->free(allocation);
+    vkDestroyImage(m_device, image, nullptr);
+    return false;
+  }
+
+  imageMemory = allocation.memory;
+  m_imageAllocations[image] = allocation;
 
   std::cout << "[MemoryManager] Created image (" << width << "x" << height
             << ") with " << (memRequirements.size / 1024) << " KB memory"
@@ -534,6 +904,27 @@ bool MemoryManager::createImage(uint32_t width, uint32_t height,
   return true;
 }
 
+void MemoryManager::destroyImage(VkImage image) {
+  if (image == VK_NULL_HANDLE) {
+    return;
+  }
+
+  vkDestroyImage(m_device, image, nullptr);
+
+  auto it = m_imageAllocations.find(image);
+  if (it != m_imageAllocations.end()) {
+    m_allocator->free(it->second);
+    m_imageAllocations.erase(it);
+  }
+}
+
+void MemoryManager::destroyImageDeferred(VkImage image) {
+  if (image == VK_NULL_HANDLE) {
+    return;
+  }
+  m_deletionQueue.enqueue([this, image]() { destroyImage(image); });
+}
+
 VkImageView MemoryManager::createImageView(VkImage image, VkFormat format,
                                            VkImageAspectFlags aspectFlags) {
   VkImageViewCreateInfo viewInfo{};
@@ -556,48 +947,6 @@ VkImageView MemoryManager::createImageView(VkImage image, VkFormat format,
   return imageView;
 }
 
-void MemoryManager::transitionImageLayout(VkImage image, VkFormat format,
-                                          VkImageLayout oldLayout,
-                                          VkImageLayout newLayout,
-                                          VkCommandBuffer commandBuffer) {
-  VkImageMemoryBarrier barrier{};
-  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  barrier.oldLayout = oldLayout;
-  barrier.newLayout = newLayout;
-  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  barrier.image = image;
-  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  barrier.subresourceRange.baseMipLevel = 0;
-  barrier.subresourceRange.levelCount = 1;
-  barrier.subresourceRange.baseArrayLayer = 0;
-  barrier.subresourceRange.layerCount = 1;
-
-  VkPipelineStageFlags sourceStage;
-  VkPipelineStageFlags destinationStage;
-
-  if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-      newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-    barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-    sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-  } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
-             newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-  } else {
-    throw std::invalid_argument("Unsupported layout transition!");
-  }
-
-  vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0,
-                       nullptr, 0, nullptr, 1, &barrier);
-}
-
 void MemoryManager::copyBufferToImage(VkBuffer buffer, VkImage image,
                                       uint32_t width, uint32_t height,
                                       VkCommandBuffer commandBuffer) {
@@ -19,11 +19,22 @@
 
 #pragma once
 
+#include "DeletionQueue.h"
+#include "DeviceMemoryAllocator.h"
+#include "ResourceTable.h"
+
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan.h>
 
+// Forward declarations
+class StagingRing;
+
 /**
  * @enum BufferUsage
  * @brief Common buffer usage patterns for fractal generation
@@ -35,7 +46,8 @@ enum class BufferUsage {
   STORAGE_BUFFER,        ///< General storage for compute shaders
   STAGING_BUFFER,        ///< Temporary buffer for data transfer
   FRACTAL_OUTPUT_BUFFER, ///< Output buffer for fractal computation
-  FRACTAL_PARAMS_BUFFER  ///< Parameters for fractal computation
+  FRACTAL_PARAMS_BUFFER, ///< Parameters for fractal computation
+  INDIRECT_BUFFER        ///< Storage buffer also read as indirect dispatch args
 };
 
 /**
@@ -45,23 +57,42 @@ enum class BufferUsage {
 enum class MemoryLocation {
   GPU_ONLY,      ///< Device local memory (fastest for GPU)
   CPU_TO_GPU,    ///< Host visible, for CPU->GPU transfers
-  GPU_TO_CPU,    ///< Host cached, for GPU->CPU readback
-  CPU_GPU_SHARED ///< Host coherent, for frequent updates
+  GPU_TO_CPU,       ///< Host cached, for GPU->CPU readback
+  CPU_GPU_SHARED,   ///< Host coherent, for frequent updates
+  GPU_HOST_VISIBLE  ///< Device local and mappable (unified memory only)
 };
 
+/**
+ * @brief Handle of a buffer tracked by MemoryManager
+ */
+using BufferHandle = ResourceHandle;
+
 /**
  * @struct BufferInfo
  * @brief Information about an allocated buffer
  */
 struct BufferInfo {
-  VkBuffer buffer;         ///< Vulkan buffer handle
-  VkDeviceMemory memory;   ///< Allocated device memory
-  VkDeviceSize size;       ///< Size of the buffer in bytes
-  VkDeviceSize offset;     ///< Offset in the device memory
-  void *mappedData;        ///< Mapped host pointer (if applicable)
-  BufferUsage usage;       ///< Intended usage of the buffer
-  MemoryLocation location; ///< Memory location type
-  bool persistentlyMapped; ///< Whether the buffer stays mapped
+  BufferHandle handle;         ///< Handle in MemoryManager's buffer table
+  std::string name;            ///< Debug label given at creation
+  VkBuffer buffer;             ///< Vulkan buffer handle
+  VkDeviceMemory memory;       ///< Device memory block holding the buffer
+  VkDeviceSize size;           ///< Size of the buffer in bytes
+  VkDeviceSize offset;         ///< Offset of the buffer in the memory block
+  void *mappedData;            ///< Mapped host pointer (if applicable)
+  BufferUsage usage;           ///< Intended usage of the buffer
+  MemoryLocation location;     ///< Memory location type
+  bool persistentlyMapped;     ///< Whether the buffer stays mapped
+  DeviceAllocation allocation; ///< Sub-allocation backing the buffer
+};
+
+/**
+ * @struct HeapBudget
+ * @brief Memory budget of one heap for this process
+ */
+struct HeapBudget {
+  VkDeviceSize budget = 0;  ///< Bytes this process can use without failures
+  VkDeviceSize usage = 0;   ///< Bytes this process currently uses
+  bool deviceLocal = false; ///< Heap is VK_MEMORY_HEAP_DEVICE_LOCAL_BIT
 };
 
 /**
@@ -109,7 +140,9 @@ public:
   /**
    * @brief Create a buffer with automatic memory allocation
    *
-   * @param name Unique name for the buffer (for tracking and debugging)
+   * Safe to call from several threads at once.
+   *
+   * @param name Debug label for logs (need not be unique)
    * @param size Size of the buffer in bytes
    * @param usage Intended usage of the buffer
    * @param location Memory location preference
@@ -127,24 +160,62 @@ public:
   /**
    * @brief Create a buffer with explicit Vulkan usage flags
    *
-   * @param name Unique name for the buffer
+   * @param name Debug label for logs (need not be unique)
    * @param size Size of the buffer in bytes
    * @param usageFlags Vulkan buffer usage flags
    * @param memoryProperties Required memory property flags
    * @param persistentMap Whether to keep the buffer mapped
+   * @param shared Whether queues of every family set with
+   * setSharedQueueFamilies() may use the buffer (concurrent sharing)
    * @return Pointer to BufferInfo containing buffer details
    *
    * @throws std::runtime_error If buffer creation or memory allocation fails
    */
   std::shared_ptr<BufferInfo> createBufferExplicit(
       const std::string &name, VkDeviceSize size, VkBufferUsageFlags usageFlags,
-      VkMemoryPropertyFlags memoryProperties, bool persistentMap = false);
+      VkMemoryPropertyFlags memoryProperties, bool persistentMap = false,
+      bool shared = false);
+
+  /**
+   * @brief Round a size up to its allocation size class
+   *
+   * Classes are spaced four per power of two, so a buffer sized to its class
+   * wastes at most a quarter and absorbs small size changes.
+   *
+   * @param size Requested size in bytes
+   * @return Capacity to allocate
+   */
+  static VkDeviceSize sizeClassFor(VkDeviceSize size);
+
+  /**
+   * @brief Check whether an existing buffer can serve a new size
+   *
+   * True if the capacity holds the size without being more than twice its
+   * size class, so shrinking far enough still returns memory.
+   *
+   * @param capacity Size of the existing buffer
+   * @param size Size now needed
+   * @return true if the buffer can be kept
+   */
+  static bool fitsSizeClass(VkDeviceSize capacity, VkDeviceSize size);
+
+  /**
+   * @brief Called with each chunk of an asynchronous readback
+   *
+   * Arguments are the chunk's host data, its offset relative to the start of
+   * the readback, and its size. The data is only valid during the call.
+   */
+  using ReadbackCallback =
+      std::function<void(const void *, VkDeviceSize, VkDeviceSize)>;
 
   /**
    * @brief Upload data to a buffer using staging if necessary
    *
-   * Automatically handles staging buffer creation for GPU-only memory.
-   * For host-visible memory, copies directly.
+   * For host-visible memory, copies directly. GPU-only buffers are filled
+   * through the staging ring: the copy is submitted asynchronously and its
+   * staging space is reclaimed by processCompletedTransfers(). Later work on
+   * the same queue must order itself after the copy with a transfer barrier;
+   * other queues should call waitForTransfers() first.
    *
    * @param buffer Target buffer to upload to
    * @param data Source data pointer
@@ -173,6 +244,46 @@ public:
   void downloadBufferData(std::shared_ptr<BufferInfo> buffer, void *data,
                           VkDeviceSize size, VkDeviceSize offset = 0);
 
+  /**
+   * @brief Read a buffer back to the host without stalling the queue
+   *
+   * Copies the range into the host-cached readback ring in chunks and
+   * submits them. onChunk runs from processCompletedTransfers() once each
+   * chunk's copy has completed, in order. Prior writes to the buffer on the
+   * same queue are made visible to the copy. Any number of readbacks may be
+   * in flight; they only wait for each other when the ring is full.
+   *
+   * Host-visible buffers (unified memory) are not copied: a single onChunk
+   * call receives the range from the buffer's own mapping once prior
+   * writes have completed.
+   *
+   * @param buffer Source buffer (any memory location)
+   * @param size Number of bytes to read
+   * @param offset Offset in the source buffer
+   * @param commandPool Command pool for the copy commands
+   * @param queue Queue to submit the copies to
+   * @param onChunk Callback receiving each completed chunk
+   *
+   * @throws std::runtime_error If the range is invalid or submission fails
+   */
+  void readBufferDataAsync(std::shared_ptr<BufferInfo> buffer,
+                           VkDeviceSize size, VkDeviceSize offset,
+                           VkCommandPool commandPool, VkQueue queue,
+                           ReadbackCallback onChunk);
+
+  /**
+   * @brief Retire completed staging transfers
+   *
+   * Runs readback callbacks and frees staging space of finished copies.
+   * Call once per frame.
+   */
+  void processCompletedTransfers();
+
+  /**
+   * @brief Block until all staging transfers have completed
+   */
+  void waitForTransfers();
+
   /**
    * @brief Map buffer memory for host access
    *
@@ -191,20 +302,46 @@ public:
   void unmapBuffer(std::shared_ptr<BufferInfo> buffer);
 
   /**
-   * @brief Get buffer by name
+   * @brief Get buffer by handle
    *
-   * @param name Name of the buffer to retrieve
-   * @return Pointer to BufferInfo if found, nullptr otherwise
+   * @param handle Handle from BufferInfo::handle
+   * @return Pointer to BufferInfo if live, nullptr for stale handles
    */
-  std::shared_ptr<BufferInfo> getBuffer(const std::string &name) const;
+  std::shared_ptr<BufferInfo> getBuffer(BufferHandle handle) const;
 
   /**
    * @brief Remove buffer and free its memory
    *
-   * @param name Name of the buffer to remove
-   * @return true if buffer was found and removed, false otherwise
+   * Safe to call from several threads at once. The buffer must no longer be
+   * in use by the GPU.
+   *
+   * @param handle Handle from BufferInfo::handle
+   * @return true if buffer was live and removed, false otherwise
+   */
+  bool removeBuffer(BufferHandle handle);
+
+  /**
+   * @brief Remove a buffer now and free it once the GPU is done with it
+   *
+   * The handle goes stale immediately; the Vulkan buffer and its memory are
+   * released through the deletion queue when the current frame retires and
+   * every staging batch submitted before the call has retired. Never waits.
+   * Use this for buffers that submitted work may still reference.
+   *
+   * @param handle Handle from BufferInfo::handle
+   * @return true if buffer was live and removed, false otherwise
    */
-  bool removeBuffer(const std::string &name);
+  bool removeBufferDeferred(BufferHandle handle);
+
+#ifndef NDEBUG
+  /**
+   * @brief Find a live buffer by its debug label (debug builds only)
+   *
+   * @param name Label given at creation
+   * @return Most recently created live buffer with that label, or nullptr
+   */
+  std::shared_ptr<BufferInfo> findBufferByName(const std::string &name) const;
+#endif
 
   /**
    * @brief Clear all buffers and free memory
@@ -212,11 +349,11 @@ public:
   void clearBuffers();
 
   /**
-   * @brief Get list of all buffer names
+   * @brief Get the number of live buffers
    *
-   * @return Vector of buffer names
+   * @return Buffer count
    */
-  std::vector<std::string> getBufferNames() const;
+  size_t getBufferCount() const;
 
   /**
    * @brief Get total allocated memory size
@@ -225,6 +362,87 @@ public:
    */
   VkDeviceSize getTotalAllocatedMemory() const;
 
+  /**
+   * @brief Get sub-allocator statistics
+   *
+   * @return Block, allocation and usage counts of the device memory pools
+   */
+  DeviceMemoryStats getMemoryStats() const;
+
+  /**
+   * @brief Read budgets from VK_EXT_memory_budget from now on
+   *
+   * Must only be called when the device was created with the extension;
+   * without it, budgets are estimated from our own allocations.
+   *
+   * @param instance Instance with VK_KHR_get_physical_device_properties2
+   * @return true if the extension's query function was found
+   */
+  bool enableMemoryBudgetExtension(VkInstance instance);
+
+  /**
+   * @brief Check whether budgets come from VK_EXT_memory_budget
+   *
+   * @return true if the driver reports budgets, false if they are estimated
+   */
+  bool isMemoryBudgetExtensionEnabled() const;
+
+  /**
+   * @brief Get the current budget and usage of every memory heap
+   *
+   * @return One entry per memory heap
+   */
+  std::vector<HeapBudget> getHeapBudgets() const;
+
+  /**
+   * @brief Get the memory still available for a memory location
+   *
+   * @param location Memory location new resources would be placed in
+   * @return Budget minus usage of the heap backing the location
+   */
+  VkDeviceSize getAvailableMemory(MemoryLocation location) const;
+
+  /**
+   * @brief Check whether any heap is close to its budget
+   *
+   * @return true if usage exceeds the pressure threshold on some heap
+   */
+  bool isNearBudget() const;
+
+  /**
+   * @brief Check whether the device shares memory with the host
+   *
+   * True for integrated and CPU devices (Apple silicon, lavapipe) that
+   * expose device-local, host-visible memory. Results written there can be
+   * read in place instead of being copied through a staging buffer.
+   *
+   * @return true if GPU_HOST_VISIBLE buffers are cheap for both sides
+   */
+  bool hasUnifiedMemory() const { return m_unifiedMemory; }
+
+  /**
+   * @brief Set the queue families that share fractal output buffers
+   *
+   * When compute and graphics run on different families, the output buffer
+   * is written by one and copied by the other. Sharing it concurrently
+   * avoids a release/acquire ownership transfer on every frame. Affects
+   * buffers created afterwards; fewer than two distinct families means
+   * exclusive sharing.
+   *
+   * @param queueFamilies Queue family indices that access shared buffers
+   */
+  void setSharedQueueFamilies(const std::vector<uint32_t> &queueFamilies);
+
+  /**
+   * @brief Release memory held only for speed
+   *
+   * Destroys idle staging rings and the allocator's spare blocks. Also run
+   * automatically before an allocation is allowed to fail.
+   *
+   * @return Bytes returned to the driver
+   */
+  VkDeviceSize trimCaches();
+
   /**
    * @brief Create a Vulkan image with appropriate memory allocation
    *
@@ -235,7 +453,8 @@ public:
    * @param usage Image usage flags
    * @param properties Memory property flags
    * @param image Output image handle
-   * @param imageMemory Output allocated memory handle
+   * @param imageMemory Output memory block the image is bound to (owned by
+   * the memory manager; release the image with destroyImage())
    * @return True if creation was successful
    */
   bool createImage(uint32_t width, uint32_t height, VkFormat format,
@@ -243,6 +462,30 @@ public:
                    VkMemoryPropertyFlags properties, VkImage &image,
                    VkDeviceMemory &imageMemory);
 
+  /**
+   * @brief Destroy an image created by createImage() and free its memory
+   *
+   * @param image Image to destroy
+   */
+  void destroyImage(VkImage image);
+
+  /**
+   * @brief Destroy an image once the current frame has retired
+   *
+   * @param image Image created by createImage(); may still be in use
+   */
+  void destroyImageDeferred(VkImage image);
+
+  /**
+   * @brief Get the queue that defers destruction until frames retire
+   *
+   * Shared by every subsystem that owns GPU objects; the application
+   * advances and retires it from its frame fences.
+   *
+   * @return Deletion queue
+   */
+  DeletionQueue &getDeletionQueue() { return m_deletionQueue; }
+
   /**
    * @brief Create an image view for an existing image
    *
@@ -254,19 +497,6 @@ public:
   VkImageView createImageView(VkImage image, VkFormat format,
                               VkImageAspectFlags aspectFlags);
 
-  /**
-   * @brief Transition image layout using a command buffer
-   *
-   * @param image Image to transition
-   * @param format Image format
-   * @param oldLayout Current layout
-   * @param newLayout Target layout
-   * @param commandBuffer Command buffer to record commands into
-   */
-  void transitionImageLayout(VkImage image, VkFormat format,
-                             VkImageLayout oldLayout, VkImageLayout newLayout,
-                             VkCommandBuffer commandBuffer);
-
   /**
    * @brief Copy data from buffer to image
    *
@@ -279,9 +509,6 @@ public:
   void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width,
                          uint32_t height, VkCommandBuffer commandBuffer);
 
-  // TODO(Phase 4): Add memory pool management for efficiency
-  // TODO(Phase 5): Add memory budget tracking and optimization
-
 private:
   /**
    * @brief Find suitable memory type for buffer requirements
@@ -309,32 +536,91 @@ private:
    * @param location MemoryLocation enum value
    * @return Corresponding VkMemoryPropertyFlags
    */
-  VkMemoryPropertyFlags memoryLocationToVulkanFlags(MemoryLocation location);
+  VkMemoryPropertyFlags
+  memoryLocationToVulkanFlags(MemoryLocation location) const;
+
+  /**
+   * @brief Allocate memory, trimming caches and retrying once on failure
+   *
+   * @param requirements Memory requirements of the resource
+   * @param memoryTypeIndex Memory type to allocate from
+   * @param kind Tiling class of the resource
+   * @return Allocation to bind the resource to
+   *
+   * @throws std::runtime_error If memory is exhausted even after trimming
+   */
+  DeviceAllocation allocateMemory(const VkMemoryRequirements &requirements,
+                                  uint32_t memoryTypeIndex, ResourceKind kind);
+
+  /**
+   * @brief Check whether a buffer lives in host-visible memory
+   *
+   * @param buffer Buffer to check
+   * @return true if the buffer can be mapped
+   */
+  bool isHostVisible(const BufferInfo &buffer) const;
+
+  /**
+   * @brief Destroy a buffer and return its memory to the allocator
+   *
+   * @param buffer Buffer to destroy
+   */
+  void destroyBufferResources(const BufferInfo &buffer);
+
+  /**
+   * @brief Defer destroying a removed buffer past frames and staging batches
+   *
+   * Runs with the deletion queue; if either ring has not yet retired the
+   * given batch, the deleter enqueues itself again for a later frame.
+   *
+   * @param buffer Buffer already removed from the handle table
+   * @param stagingBatch Last upload batch submitted before the removal
+   * @param readbackBatch Last readback batch submitted before the removal
+   */
+  void enqueueBufferDestruction(std::shared_ptr<BufferInfo> buffer,
+                                uint64_t stagingBatch,
+                                uint64_t readbackBatch);
+
+  /**
+   * @brief Drop a buffer from the table and the debug label index
+   *
+   * @return The removed buffer, or nullptr for stale handles
+   */
+  std::shared_ptr<BufferInfo> untrackBuffer(BufferHandle handle);
+
+  /**
+   * @brief Get the upload staging ring, creating it on first use
+   *
+   * @return Write-combined staging ring for uploads
+   */
+  StagingRing &getStagingRing();
 
   /**
-   * @brief Create a temporary staging buffer for transfers
+   * @brief Get the readback ring, creating it on first use
    *
-   * @param size Size of the staging buffer
-   * @return BufferInfo for the staging buffer
+   * Prefers host-cached memory, so reads by the CPU are not uncached;
+   * falls back to coherent memory on devices without a cached type.
+   *
+   * @return Staging ring for readbacks
    */
-  std::shared_ptr<BufferInfo> createStagingBuffer(VkDeviceSize size);
+  StagingRing &getReadbackRing();
 
   /**
-   * @brief Copy data between buffers using command buffer
+   * @brief Record and submit one staging batch
+   *
+   * The command buffer is freed and onComplete runs once the batch's fence
+   * signals.
    *
-   * @param srcBuffer Source buffer
-   * @param dstBuffer Destination buffer
-   * @param size Size of data to copy
-   * @param srcOffset Offset in source buffer
-   * @param dstOffset Offset in destination buffer
-   * @param commandPool Command pool for operations
-   * @param queue Queue for command submission
+   * @param ring Ring whose open batch the submission closes
+   * @param commandPool Command pool to allocate the command buffer from
+   * @param queue Queue to submit to
+   * @param record Records the transfer commands
+   * @param onComplete Optional completion callback
    */
-  void copyBufferToBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer,
-                          VkDeviceSize size, VkDeviceSize srcOffset = 0,
-                          VkDeviceSize dstOffset = 0,
-                          VkCommandPool commandPool = VK_NULL_HANDLE,
-                          VkQueue queue = VK_NULL_HANDLE);
+  void submitStagingBatch(StagingRing &ring, VkCommandPool commandPool,
+                          VkQueue queue,
+                          const std::function<void(VkCommandBuffer)> &record,
+                          std::function<void()> onComplete);
 
   // Member variables
   VkDevice m_device;                 ///< Vulkan logical device
@@ -342,9 +628,30 @@ private:
   VkPhysicalDeviceMemoryProperties
       m_memoryProperties; ///< Device memory properties
 
-  std::unordered_map<std::string, std::shared_ptr<BufferInfo>>
-      m_buffers;                       ///< Tracked buffers
-  VkDeviceSize m_totalAllocatedMemory; ///< Total allocated memory
+  std::unique_ptr<DeviceMemoryAllocator>
+      m_allocator; ///< Pooled sub-allocator for buffers and images
+  DeletionQueue m_deletionQueue; ///< Resources waiting for their frame
+  std::unique_ptr<StagingRing>
+      m_stagingRing; ///< Upload staging space, created on first upload
+  std::unique_ptr<StagingRing>
+      m_readbackRing; ///< Host-cached readback space, created on first use
+
+  ResourceTable<std::shared_ptr<BufferInfo>> m_buffers; ///< Tracked buffers
+  std::unordered_map<VkImage, DeviceAllocation>
+      m_imageAllocations; ///< Memory of images from createImage
+  std::atomic<VkDeviceSize> m_totalAllocatedMemory; ///< Total allocated memory
+
+#ifndef NDEBUG
+  mutable std::mutex m_debugNameMutex; ///< Guards m_debugNames
+  std::unordered_map<std::string, BufferHandle>
+      m_debugNames; ///< Debug label -> newest live buffer with that label
+#endif
+
+  PFN_vkGetPhysicalDeviceMemoryProperties2KHR
+      m_getMemoryProperties2; ///< Budget query, null without the extension
+  bool m_unifiedMemory;       ///< Device-local memory is host-visible
+  std::vector<uint32_t>
+      m_sharedQueueFamilies; ///< Families of concurrently shared buffers
 };
 
 /**
@@ -371,8 +678,57 @@ private:
  *    - Graceful fallbacks for memory allocation failures
  *    - Validation of memory requirements and availability
  *
- * 5. Future Extensions:
- *    - Memory pools for efficient small allocations
- *    - Budget tracking for mobile/integrated GPUs
+ * 5. Sub-Allocation:
+ *    - Buffers and images are placed into large blocks by
+ *      DeviceMemoryAllocator instead of one vkAllocateMemory each
+ *    - BufferInfo::memory/offset describe the block and position; host
+ *      mappings point into the block's single persistent mapping
+ *
+ * 6. Staging:
+ *    - All staged transfers go through one persistently mapped StagingRing;
+ *      large transfers are split into chunks so the ring never has to hold
+ *      a whole image
+ *    - Nothing waits for the queue to go idle; staging space is reclaimed
+ *      by fence in processCompletedTransfers()
+ *    - Readbacks use a second, host-cached ring: CPU reads from
+ *      write-combined memory are an order of magnitude slower
+ *
+ * 7. Memory Budget:
+ *    - With VK_EXT_memory_budget the driver reports per-heap budgets that
+ *      account for other processes; otherwise budget is 80% of the heap and
+ *      usage is what our allocator holds
+ *    - Allocation failures trim caches and retry before throwing
+ *
+ * 8. Unified Memory:
+ *    - On integrated and CPU devices, GPU_HOST_VISIBLE buffers are read in
+ *      place; readBufferDataAsync then only waits for a fence and hands out
+ *      the mapping instead of copying through the readback ring
+ *    - Discrete GPUs with a host-visible BAR heap are not treated as
+ *      unified: host reads across PCIe are slower than a staged copy
+ *
+ * 9. Buffer Tracking:
+ *    - Buffers live in a sharded ResourceTable and are addressed by
+ *      generational handles; creating and removing buffers touches only the
+ *      calling thread's shard, plus the allocator's own lock
+ *    - Labels are for logs; the label -> buffer index exists in debug
+ *      builds only
+ *
+ * 10. Deferred Destruction:
+ *    - Resources replaced mid-run go through the deletion queue and are
+ *      freed when the frame fence of their last possible use signals, so
+ *      resizing never has to idle the device
+ *    - Buffers also outlive the staging batches submitted before their
+ *      removal, which may run on other queues; the deleter polls the rings
+ *      and re-enqueues itself rather than waiting
+ *    - The destructor releases the rings, then flushes the queue; the
+ *      device must be idle by then
+ *
+ * 11. Size Classes:
+ *    - Per-pixel buffers are allocated at sizeClassFor() capacity and kept
+ *      while fitsSizeClass() holds, so resizing by a few pixels reuses them
+ *    - Pooled allocations are powers of two anyway; the classes matter for
+ *      dedicated allocations of large resolutions
+ *
+ * 12. Future Extensions:
  *    - Advanced transfer scheduling and optimization
  */
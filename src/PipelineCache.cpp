@@ -0,0 +1,227 @@
+/**
+ * @file PipelineCache.cpp
+ * @brief Implementation of the disk-backed pipeline cache
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "PipelineCache.h"
+#include "CacheUtils.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t CACHE_FILE_MAGIC = 0x43504746; // "FGPC"
+constexpr uint32_t CACHE_FILE_VERSION = 1;
+
+/**
+ * @brief Header in front of the driver's cache data
+ */
+struct CacheFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t vendorID;
+  uint32_t deviceID;
+  uint32_t driverVersion;
+  uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+  uint64_t dataSize;
+  uint64_t checksum;
+};
+
+std::string uuidToHex(const uint8_t *uuid) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex;
+  for (uint32_t i = 0; i < VK_UUID_SIZE; i++) {
+    hex += digits[uuid[i] >> 4];
+    hex += digits[uuid[i] & 0xF];
+  }
+  return hex;
+}
+
+} // namespace
+
+PipelineCache::PipelineCache(VkDevice device, VkPhysicalDevice physicalDevice,
+                             const std::string &directory)
+    : m_device(device), m_cache(VK_NULL_HANDLE), m_properties{},
+      m_loadedSize(0), m_loadedChecksum(0) {
+  vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+
+  std::string dir =
+      directory.empty() ? CacheUtils::defaultDirectory() : directory;
+  m_path = dir + "/pipeline_cache_" +
+           uuidToHex(m_properties.pipelineCacheUUID) + ".bin";
+
+  std::string initialData;
+  loadFile(initialData);
+
+  VkPipelineCacheCreateInfo cacheInfo{};
+  cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cacheInfo.initialDataSize = initialData.size();
+  cacheInfo.pInitialData = initialData.data();
+
+  VkResult result =
+      vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_cache);
+  if (result != VK_SUCCESS && !initialData.empty()) {
+    // The driver rejected data that passed our checks; start cold
+    std::cerr << "[PipelineCache] Driver rejected " << m_path
+              << ", starting with an empty cache" << std::endl;
+    cacheInfo.initialDataSize = 0;
+    cacheInfo.pInitialData = nullptr;
+    m_loadedSize = 0;
+    result = vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_cache);
+  }
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to create pipeline cache! Vulkan error: " +
+        std::to_string(result));
+  }
+
+  if (wasLoaded()) {
+    std::cout << "[PipelineCache] Loaded " << m_loadedSize << " bytes from "
+              << m_path << std::endl;
+  } else {
+    std::cout << "[PipelineCache] No usable cache at " << m_path
+              << ", pipelines will be compiled from scratch" << std::endl;
+  }
+}
+
+PipelineCache::~PipelineCache() {
+  if (m_cache != VK_NULL_HANDLE) {
+    vkDestroyPipelineCache(m_device, m_cache, nullptr);
+  }
+}
+
+bool PipelineCache::save() {
+  size_t size = 0;
+  VkResult result = vkGetPipelineCacheData(m_device, m_cache, &size, nullptr);
+  if (result != VK_SUCCESS || size == 0) {
+    return false;
+  }
+
+  std::string data(size, '\0');
+  result = vkGetPipelineCacheData(m_device, m_cache, &size, data.data());
+  if (result != VK_SUCCESS) {
+    std::cerr << "[PipelineCache] Failed to read cache data! Error: "
+              << result << std::endl;
+    return false;
+  }
+  data.resize(size);
+
+  uint64_t checksum = CacheUtils::fnv1a(data.data(), data.size());
+  if (size == m_loadedSize && checksum == m_loadedChecksum) {
+    return true; // Nothing new since startup
+  }
+
+  CacheFileHeader header{};
+  header.magic = CACHE_FILE_MAGIC;
+  header.version = CACHE_FILE_VERSION;
+  header.vendorID = m_properties.vendorID;
+  header.deviceID = m_properties.deviceID;
+  header.driverVersion = m_properties.driverVersion;
+  std::memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID,
+              VK_UUID_SIZE);
+  header.dataSize = data.size();
+  header.checksum = checksum;
+
+  std::error_code error;
+  std::filesystem::path path(m_path);
+  std::filesystem::create_directories(path.parent_path(), error);
+
+  std::string tempPath = m_path + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      std::cerr << "[PipelineCache] Failed to write " << tempPath
+                << std::endl;
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tempPath, path, error);
+  if (error) {
+    std::cerr << "[PipelineCache] Failed to replace " << m_path << ": "
+              << error.message() << std::endl;
+    std::filesystem::remove(tempPath, error);
+    return false;
+  }
+
+  m_loadedSize = data.size();
+  m_loadedChecksum = checksum;
+  std::cout << "[PipelineCache] Saved " << data.size() << " bytes to "
+            << m_path << std::endl;
+  return true;
+}
+
+void PipelineCache::loadFile(std::string &initialData) {
+  std::ifstream file(m_path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return;
+  }
+  uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  CacheFileHeader header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!file || header.magic != CACHE_FILE_MAGIC ||
+      header.version != CACHE_FILE_VERSION) {
+    std::cerr << "[PipelineCache] Ignoring " << m_path
+              << ": not a pipeline cache file" << std::endl;
+    return;
+  }
+
+  // A driver update or a different GPU invalidates the data
+  if (header.vendorID != m_properties.vendorID ||
+      header.deviceID != m_properties.deviceID ||
+      header.driverVersion != m_properties.driverVersion ||
+      std::memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID,
+                  VK_UUID_SIZE) != 0) {
+    std::cout << "[PipelineCache] Ignoring " << m_path
+              << ": written by another device or driver version"
+              << std::endl;
+    return;
+  }
+
+  if (header.dataSize != fileSize - sizeof(header)) {
+    std::cerr << "[PipelineCache] Ignoring " << m_path
+              << ": truncated or corrupt" << std::endl;
+    return;
+  }
+
+  std::string data(header.dataSize, '\0');
+  file.read(data.data(), static_cast<std::streamsize>(data.size()));
+  if (!file ||
+      CacheUtils::fnv1a(data.data(), data.size()) != header.checksum) {
+    std::cerr << "[PipelineCache] Ignoring " << m_path
+              << ": truncated or corrupt" << std::endl;
+    return;
+  }
+
+  // The driver's header must agree as well before it sees the data
+  VkPipelineCacheHeaderVersionOne driverHeader{};
+  if (data.size() < sizeof(driverHeader)) {
+    return;
+  }
+  std::memcpy(&driverHeader, data.data(), sizeof(driverHeader));
+  if (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+      driverHeader.vendorID != m_properties.vendorID ||
+      driverHeader.deviceID != m_properties.deviceID ||
+      std::memcmp(driverHeader.pipelineCacheUUID,
+                  m_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+    std::cerr << "[PipelineCache] Ignoring " << m_path
+              << ": driver header mismatch" << std::endl;
+    return;
+  }
+
+  m_loadedSize = data.size();
+  m_loadedChecksum = header.checksum;
+  initialData = std::move(data);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file PipelineCompiler.cpp
+ * @brief Implementation of background shader and pipeline compilation
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "PipelineCompiler.h"
+#include "PipelineCache.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+PipelineCompiler::PipelineCompiler(
+    VkDevice device, std::shared_ptr<ShaderManager> shaderManager,
+    std::shared_ptr<PipelineCache> pipelineCache)
+    : m_device(device), m_shaderManager(std::move(shaderManager)),
+      m_pipelineCache(std::move(pipelineCache)), m_activeCount(0),
+      m_stopping(false), m_ready(nullptr) {
+  m_worker = std::thread(&PipelineCompiler::workerLoop, this);
+}
+
+PipelineCompiler::~PipelineCompiler() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    m_queue.clear();
+  }
+  m_condition.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+
+  // Nobody collected these; they were never used
+  for (auto &result : collectReady()) {
+    if (result.pipeline != VK_NULL_HANDLE) {
+      vkDestroyPipeline(m_device, result.pipeline, nullptr);
+    }
+  }
+}
+
+void PipelineCompiler::submit(PipelineCompileRequest request) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Only the newest request for a name is worth building
+    for (auto &queued : m_queue) {
+      if (queued.pipelineName == request.pipelineName) {
+        queued = std::move(request);
+        return;
+      }
+    }
+    m_queue.push_back(std::move(request));
+  }
+  m_condition.notify_one();
+}
+
+std::vector<CompiledPipeline> PipelineCompiler::collectReady() {
+  ReadyNode *node = m_ready.exchange(nullptr, std::memory_order_acquire);
+
+  // The list is newest first; reverse it into completion order
+  std::vector<CompiledPipeline> results;
+  while (node) {
+    ReadyNode *next = node->next;
+    results.push_back(std::move(node->result));
+    delete node;
+    node = next;
+  }
+  std::reverse(results.begin(), results.end());
+  return results;
+}
+
+size_t PipelineCompiler::getPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_queue.size() + m_activeCount;
+}
+
+void PipelineCompiler::workerLoop() {
+  while (true) {
+    PipelineCompileRequest request;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+      if (m_stopping) {
+        return;
+      }
+      request = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_activeCount++;
+    }
+
+    CompiledPipeline result = compile(request);
+    if (result.pipeline != VK_NULL_HANDLE) {
+      std::cout << "[PipelineCompiler] Compiled " << result.pipelineName
+                << " in " << result.milliseconds << " ms" << std::endl;
+    } else {
+      std::cerr << "[PipelineCompiler] Failed to compile "
+                << result.pipelineName << ": " << result.error << std::endl;
+    }
+    publish(std::move(result));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_activeCount--;
+  }
+}
+
+CompiledPipeline
+PipelineCompiler::compile(const PipelineCompileRequest &request) {
+  auto start = std::chrono::steady_clock::now();
+  CompiledPipeline result{request.pipelineName, VK_NULL_HANDLE, "", 0.0};
+  VkShaderModule module = VK_NULL_HANDLE;
+
+  try {
+    std::vector<uint32_t> spirvCode = m_shaderManager->compileFileToSPIRV(
+        request.filePath, ShaderType::COMPUTE, request.entryPoint,
+        request.defines, request.useEmbedded);
+
+    result.reflection =
+        ShaderReflection::reflect(spirvCode, VK_SHADER_STAGE_COMPUTE_BIT);
+    if (!request.layoutInterface.covers(result.reflection)) {
+      throw std::runtime_error("Shader resources no longer match the "
+                               "pipeline layout; restart to apply");
+    }
+
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = spirvCode.size() * sizeof(uint32_t);
+    moduleInfo.pCode = spirvCode.data();
+
+    VkResult vkResult =
+        vkCreateShaderModule(m_device, &moduleInfo, nullptr, &module);
+    if (vkResult != VK_SUCCESS) {
+      throw std::runtime_error("Failed to create shader module! Vulkan "
+                               "error: " +
+                               std::to_string(vkResult));
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.layout = request.layout;
+    pipelineInfo.stage.sType =
+        VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = module;
+    pipelineInfo.stage.pName = request.entryPoint.c_str();
+
+    VkPipelineCache cache =
+        m_pipelineCache ? m_pipelineCache->getHandle() : VK_NULL_HANDLE;
+    vkResult = vkCreateComputePipelines(m_device, cache, 1, &pipelineInfo,
+                                        nullptr, &result.pipeline);
+    if (vkResult != VK_SUCCESS) {
+      result.pipeline = VK_NULL_HANDLE;
+      throw std::runtime_error(
+          "Failed to create compute pipeline! Vulkan error: " +
+          std::to_string(vkResult));
+    }
+  } catch (const std::exception &e) {
+    result.error = e.what();
+  }
+
+  // The pipeline keeps what it needs from the module
+  if (module != VK_NULL_HANDLE) {
+    vkDestroyShaderModule(m_device, module, nullptr);
+  }
+
+  result.milliseconds = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+  return result;
+}
+
+void PipelineCompiler::publish(CompiledPipeline result) {
+  auto *node = new ReadyNode{std::move(result), nullptr};
+  node->next = m_ready.load(std::memory_order_relaxed);
+  while (!m_ready.compare_exchange_weak(node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+  }
+}
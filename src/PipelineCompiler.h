@@ -0,0 +1,180 @@
+/**
+ * @file PipelineCompiler.h
+ * @brief Background shader and compute pipeline compilation
+ *
+ * This class moves shader compilation, module creation and pipeline
+ * creation off the render thread. Requests are queued to a single worker;
+ * finished pipelines are handed back through a lock-free list that the
+ * render thread swaps out once per frame, so it never waits on shaderc or
+ * the driver compiler.
+ *
+ * Phase 5 Focus:
+ * - No frame hitches from hot-reload or pipeline variant switches
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include "ShaderManager.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+// Forward declarations
+class PipelineCache;
+
+/**
+ * @struct PipelineCompileRequest
+ * @brief One compute pipeline to build in the background
+ */
+struct PipelineCompileRequest {
+  std::string pipelineName;        ///< Name the result is published under
+  std::string filePath;            ///< GLSL compute shader file
+  std::string entryPoint = "main"; ///< Entry point function name
+  ShaderDefines defines;           ///< Preprocessor macros for the variant
+  VkPipelineLayout layout = VK_NULL_HANDLE; ///< Must outlive the request
+  ShaderReflection layoutInterface; ///< What the layout provides
+  bool useEmbedded = true; ///< false to recompile a modified source file
+};
+
+/**
+ * @struct CompiledPipeline
+ * @brief Result of a background compile
+ */
+struct CompiledPipeline {
+  std::string pipelineName; ///< Name from the request
+  VkPipeline pipeline;      ///< New pipeline, VK_NULL_HANDLE on failure
+  std::string error;        ///< Failure reason, empty on success
+  double milliseconds;      ///< Time spent compiling and creating
+  ShaderReflection reflection; ///< Interface of the compiled shader
+};
+
+/**
+ * @class PipelineCompiler
+ * @brief Single worker thread that compiles compute pipelines
+ *
+ * A request for a pipeline name that is still queued replaces the queued
+ * one, so rapid hot-reloads or variant switches only build the latest.
+ * Ownership of every published pipeline passes to whoever collects it.
+ */
+class PipelineCompiler {
+public:
+  /**
+   * @brief Constructor - start the worker thread
+   *
+   * @param device Vulkan logical device
+   * @param shaderManager Shader manager used for SPIR-V compilation
+   * @param pipelineCache Cache shared by all pipelines (may be null)
+   */
+  PipelineCompiler(VkDevice device,
+                   std::shared_ptr<ShaderManager> shaderManager,
+                   std::shared_ptr<PipelineCache> pipelineCache = nullptr);
+
+  /**
+   * @brief Destructor - stop the worker and destroy uncollected pipelines
+   *
+   * A compile in progress is finished first; queued requests are dropped.
+   */
+  ~PipelineCompiler();
+
+  // Disable copy and move for simplicity
+  PipelineCompiler(const PipelineCompiler &) = delete;
+  PipelineCompiler &operator=(const PipelineCompiler &) = delete;
+  PipelineCompiler(PipelineCompiler &&) = delete;
+  PipelineCompiler &operator=(PipelineCompiler &&) = delete;
+
+  /**
+   * @brief Queue a pipeline for background compilation
+   *
+   * @param request Pipeline to build
+   */
+  void submit(PipelineCompileRequest request);
+
+  /**
+   * @brief Take every pipeline finished since the last call
+   *
+   * Never blocks. The caller owns the returned pipelines.
+   *
+   * @return Results in completion order
+   */
+  std::vector<CompiledPipeline> collectReady();
+
+  /**
+   * @brief Get the number of requests queued or being compiled
+   *
+   * @return Pending request count
+   */
+  size_t getPendingCount() const;
+
+private:
+  /**
+   * @brief Node of the lock-free ready list
+   */
+  struct ReadyNode {
+    CompiledPipeline result;
+    ReadyNode *next;
+  };
+
+  /**
+   * @brief Compile queued requests until the destructor stops the worker
+   */
+  void workerLoop();
+
+  /**
+   * @brief Compile SPIR-V, create the module and the pipeline
+   *
+   * @param request Pipeline to build
+   * @return Result to publish
+   */
+  CompiledPipeline compile(const PipelineCompileRequest &request);
+
+  /**
+   * @brief Push a result onto the ready list
+   *
+   * @param result Result to publish
+   */
+  void publish(CompiledPipeline result);
+
+  VkDevice m_device;                              ///< Vulkan logical device
+  std::shared_ptr<ShaderManager> m_shaderManager; ///< SPIR-V compilation
+  std::shared_ptr<PipelineCache> m_pipelineCache; ///< Driver pipeline cache
+
+  mutable std::mutex m_mutex;          ///< Guards the queue and counters
+  std::condition_variable m_condition; ///< Wakes the worker
+  std::deque<PipelineCompileRequest> m_queue; ///< Requests not yet started
+  size_t m_activeCount;                       ///< Requests being compiled
+  bool m_stopping;                            ///< Destructor has been called
+
+  std::atomic<ReadyNode *> m_ready; ///< Finished pipelines, newest first
+  std::thread m_worker;             ///< Compile thread
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Publication:
+ *    - The worker pushes results with a compare-and-swap; collectReady()
+ *      takes the whole list with one atomic exchange, so the render thread
+ *      holds no lock while a compile is running
+ *
+ * 2. Thread Safety:
+ *    - ShaderManager::compileFileToSPIRV() serializes shaderc and the
+ *      SPIR-V cache; the worker never touches the shader table
+ *    - The VkPipelineCache is created without the externally synchronized
+ *      flag, so the driver locks it for concurrent pipeline creation
+ *    - The module only lives for the pipeline creation call
+ *
+ * 3. Layout Checks:
+ *    - A shader edited to use a binding or push constant range its layout
+ *      lacks is rejected before pipeline creation; layouts are fixed for
+ *      the lifetime of the pipelines that share them
+ */
@@ -0,0 +1,90 @@
+/**
+ * @file ResolutionGovernor.cpp
+ * @brief Implementation of the dynamic render scale controller
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "ResolutionGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Scale quantization; one step is a sixteenth of the full size per axis
+constexpr float SCALE_STEP = 1.0f / 16.0f;
+
+// Predicted cost must stay below this share of the target to scale up
+constexpr double RAISE_HEADROOM = 0.85;
+
+// Weight of a new measurement in the smoothed cost
+constexpr double COST_SMOOTHING = 0.3;
+
+// Stillness after which the view is rendered at full resolution again
+constexpr double IDLE_RESTORE_SECONDS = 0.3;
+
+// Largest quantized scale whose predicted cost fits the budget
+float scaleForBudget(double budgetMilliseconds, double fullCost) {
+  float ideal = static_cast<float>(std::sqrt(budgetMilliseconds / fullCost));
+  float quantized = std::floor(ideal / SCALE_STEP) * SCALE_STEP;
+  return std::clamp(quantized, ResolutionGovernor::MIN_SCALE, 1.0f);
+}
+
+} // namespace
+
+void ResolutionGovernor::setTargetFrameTime(double milliseconds) {
+  m_targetMilliseconds = std::max(milliseconds, 1.0);
+}
+
+void ResolutionGovernor::reportComputeTime(double milliseconds, float scale) {
+  if (milliseconds <= 0.0 || scale <= 0.0f) {
+    return;
+  }
+
+  double fullCost = milliseconds / (static_cast<double>(scale) * scale);
+  m_fullResolutionCost =
+      m_fullResolutionCost > 0.0
+          ? m_fullResolutionCost +
+                COST_SMOOTHING * (fullCost - m_fullResolutionCost)
+          : fullCost;
+
+  // Drop at once when over target; climb back only with headroom
+  float lower = scaleForBudget(m_targetMilliseconds, m_fullResolutionCost);
+  float raise = scaleForBudget(m_targetMilliseconds * RAISE_HEADROOM,
+                               m_fullResolutionCost);
+  if (lower < m_interactiveScale) {
+    m_interactiveScale = lower;
+  } else if (raise > m_interactiveScale) {
+    m_interactiveScale = raise;
+  }
+}
+
+void ResolutionGovernor::onViewChanged() {
+  m_interactive = true;
+  m_idleSeconds = 0.0;
+}
+
+void ResolutionGovernor::advance(double deltaTime) {
+  if (!m_interactive) {
+    return;
+  }
+  m_idleSeconds += deltaTime;
+  if (m_idleSeconds >= IDLE_RESTORE_SECONDS) {
+    m_interactive = false;
+  }
+}
+
+float ResolutionGovernor::getScale() const {
+  return m_enabled && m_interactive ? m_interactiveScale : 1.0f;
+}
+
+void ResolutionGovernor::scaleExtent(uint32_t width, uint32_t height,
+                                     float scale, uint32_t &scaledWidth,
+                                     uint32_t &scaledHeight) {
+  scaledWidth = std::max(1u, static_cast<uint32_t>(std::lround(width * scale)));
+  scaledHeight =
+      std::max(1u, static_cast<uint32_t>(std::lround(height * scale)));
+}
@@ -0,0 +1,252 @@
+/**
+ * @file ResourceTable.h
+ * @brief Sharded table of resources addressed by generational handles
+ *
+ * This template replaces name-keyed maps for resource tracking. Inserting a
+ * resource returns a small handle (slot index plus generation); removing it
+ * bumps the slot's generation, so stale handles are detected instead of
+ * silently aliasing a newer resource in the same slot.
+ *
+ * Phase 5 Focus:
+ * - No string hashing on create, lookup or destroy
+ * - Concurrent create/retire from worker threads without a global lock
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct ResourceHandle
+ * @brief Generational reference to a ResourceTable slot
+ *
+ * The low bits of index select the shard, the rest the slot within it.
+ * Generation 0 is never issued, so a default-constructed handle is null.
+ */
+struct ResourceHandle {
+  uint32_t index = 0;      ///< Shard and slot of the resource
+  uint32_t generation = 0; ///< Slot generation when the handle was issued
+
+  /**
+   * @brief Check whether the handle was ever issued
+   * @return false for default-constructed handles
+   */
+  bool isValid() const { return generation != 0; }
+
+  bool operator==(const ResourceHandle &) const = default;
+};
+
+/**
+ * @class ResourceTable
+ * @brief Generational slot table split into independently locked shards
+ *
+ * Each thread inserts into its own shard (chosen by thread id), so threads
+ * only contend when they share a shard. Lookups and removals lock the shard
+ * encoded in the handle. Slots live in a deque and are recycled through a
+ * per-shard free list; a slot's generation increases on every removal.
+ *
+ * @tparam T Stored value; must be default-constructible and copyable
+ *         (typically a std::shared_ptr)
+ */
+template <typename T> class ResourceTable {
+public:
+  static constexpr uint32_t SHARD_BITS = 3;
+  static constexpr uint32_t SHARD_COUNT = 1u << SHARD_BITS;
+
+  ResourceTable() = default;
+
+  // Disable copy and move for simplicity
+  ResourceTable(const ResourceTable &) = delete;
+  ResourceTable &operator=(const ResourceTable &) = delete;
+  ResourceTable(ResourceTable &&) = delete;
+  ResourceTable &operator=(ResourceTable &&) = delete;
+
+  /**
+   * @brief Store a value in a free slot of the calling thread's shard
+   *
+   * @param value Value to store
+   * @return Handle addressing the value until it is removed
+   */
+  ResourceHandle insert(T value) {
+    uint32_t shardIndex = shardForCurrentThread();
+    Shard &shard = m_shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    uint32_t slotIndex;
+    if (!shard.freeSlots.empty()) {
+      slotIndex = shard.freeSlots.back();
+      shard.freeSlots.pop_back();
+    } else {
+      slotIndex = static_cast<uint32_t>(shard.slots.size());
+      shard.slots.emplace_back();
+    }
+
+    Slot &slot = shard.slots[slotIndex];
+    slot.value = std::move(value);
+    slot.occupied = true;
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    return ResourceHandle{(slotIndex << SHARD_BITS) | shardIndex,
+                          slot.generation};
+  }
+
+  /**
+   * @brief Look up a value
+   *
+   * @param handle Handle returned by insert()
+   * @return Stored value, or a default-constructed T for stale handles
+   */
+  T get(ResourceHandle handle) const {
+    const Shard &shard = m_shards[handle.index & (SHARD_COUNT - 1)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const Slot *slot = findSlot(shard, handle);
+    return slot ? slot->value : T{};
+  }
+
+  /**
+   * @brief Remove a value and invalidate every handle to it
+   *
+   * @param handle Handle returned by insert()
+   * @param removed Receives the removed value if not null
+   * @return true if the handle was live
+   */
+  bool remove(ResourceHandle handle, T *removed = nullptr) {
+    Shard &shard = m_shards[handle.index & (SHARD_COUNT - 1)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Slot *slot = const_cast<Slot *>(findSlot(shard, handle));
+    if (!slot) {
+      return false;
+    }
+
+    if (removed) {
+      *removed = std::move(slot->value);
+    }
+    slot->value = T{};
+    slot->occupied = false;
+
+    // Generation 0 marks null handles and is skipped on wrap-around
+    if (++slot->generation == 0) {
+      slot->generation = 1;
+    }
+    shard.freeSlots.push_back(handle.index >> SHARD_BITS);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Remove every value
+   *
+   * @return The removed values
+   */
+  std::vector<T> removeAll() {
+    std::vector<T> removed;
+    for (uint32_t shardIndex = 0; shardIndex < SHARD_COUNT; shardIndex++) {
+      Shard &shard = m_shards[shardIndex];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      for (uint32_t slotIndex = 0; slotIndex < shard.slots.size();
+           slotIndex++) {
+        Slot &slot = shard.slots[slotIndex];
+        if (!slot.occupied) {
+          continue;
+        }
+        removed.push_back(std::move(slot.value));
+        slot.value = T{};
+        slot.occupied = false;
+        if (++slot.generation == 0) {
+          slot.generation = 1;
+        }
+        shard.freeSlots.push_back(slotIndex);
+      }
+    }
+    m_size.fetch_sub(removed.size(), std::memory_order_relaxed);
+    return removed;
+  }
+
+  /**
+   * @brief Visit every live value
+   *
+   * Each shard is locked while it is visited; the callback must not access
+   * the table.
+   *
+   * @param visit Function called with each value
+   */
+  void forEach(const std::function<void(const T &)> &visit) const {
+    for (const Shard &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      for (const Slot &slot : shard.slots) {
+        if (slot.occupied) {
+          visit(slot.value);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of live values
+   * @return Value count (approximate while other threads modify the table)
+   */
+  size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    T value{};
+    uint32_t generation = 1;
+    bool occupied = false;
+  };
+
+  // Own cache line per shard so neighbouring locks do not false-share
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::deque<Slot> slots; ///< Deque: growth never moves existing slots
+    std::vector<uint32_t> freeSlots;
+  };
+
+  static const Slot *findSlot(const Shard &shard, ResourceHandle handle) {
+    uint32_t slotIndex = handle.index >> SHARD_BITS;
+    if (!handle.isValid() || slotIndex >= shard.slots.size()) {
+      return nullptr;
+    }
+    const Slot &slot = shard.slots[slotIndex];
+    return slot.occupied && slot.generation == handle.generation ? &slot
+                                                                 : nullptr;
+  }
+
+  static uint32_t shardForCurrentThread() {
+    thread_local uint32_t shard = static_cast<uint32_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) &
+        (SHARD_COUNT - 1));
+    return shard;
+  }
+
+  std::array<Shard, SHARD_COUNT> m_shards;
+  std::atomic<size_t> m_size{0};
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Generations:
+ *    - A removed slot is reused by the next insert in its shard, but with a
+ *      new generation, so use-after-free through an old handle returns an
+ *      empty value instead of someone else's resource
+ *
+ * 2. Sharding:
+ *    - Shards are picked per thread, not per resource; a single-threaded
+ *      application therefore uses one shard and never contends
+ *    - Slot indices carry the shard in their low bits, so lookups from any
+ *      thread go straight to the owning shard
+ */
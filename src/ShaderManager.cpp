@@ -8,17 +8,213 @@
  */
 
 #include "ShaderManager.h"
+#include "CacheUtils.h"
+#include "EmbeddedShaders.h"
+#include "LayoutCache.h"
+#include "ShaderWatcher.h"
+#include <fcntl.h>
+#include <filesystem>
 #include <fstream>
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <shaderc/shaderc.hpp>
 #include <stdexcept>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
 
-ShaderManager::ShaderManager(VkDevice device) : m_device(device) {
-  std::cout << "[ShaderManager] Initialized shader manager" << std::endl;
+namespace {
+
+constexpr uint32_t SPIRV_CACHE_MAGIC = 0x56505346; // "FSPV"
+constexpr uint32_t SPIRV_CACHE_VERSION = 1;
+
+// Seed of the check hash; any value other than the FNV basis will do
+constexpr uint64_t CHECK_HASH_SEED = 0x84222325cbf29ce4ull;
+
+// Deeper nesting than this is a cycle the compiler will reject anyway
+constexpr int MAX_INCLUDE_DEPTH = 32;
+
+/**
+ * @brief Header of a cached SPIR-V file, followed by the code words
+ */
+struct SpirvCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint64_t check;
+  uint64_t wordCount;
+};
+
+// Debug info is only worth its size when validation layers are on
+#ifdef VK_ENABLE_VALIDATION_LAYERS
+constexpr bool GENERATE_DEBUG_INFO = true;
+#else
+constexpr bool GENERATE_DEBUG_INFO = false;
+#endif
+
+/**
+ * @brief Find and read an included file
+ *
+ * Relative includes are looked up next to the including file first, then
+ * in the include directories in order.
+ *
+ * @return true if found; path and content are set
+ */
+bool resolveInclude(const std::string &requested, const std::string &requester,
+                    bool relative, const std::vector<std::string> &directories,
+                    std::string &path, std::string &content) {
+  std::vector<std::string> candidates;
+  size_t slash = requester.find_last_of('/');
+  if (relative && slash != std::string::npos) {
+    candidates.push_back(requester.substr(0, slash + 1) + requested);
+  }
+  for (const auto &directory : directories) {
+    candidates.push_back(directory + "/" + requested);
+  }
+
+  for (const auto &candidate : candidates) {
+    std::ifstream file(candidate, std::ios::binary);
+    if (file.is_open()) {
+      path = candidate;
+      content.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Append every file reachable through #include lines to a cache key
+ */
+void appendIncludes(const std::string &source, const std::string &fileName,
+                    const std::vector<std::string> &directories, int depth,
+                    std::unordered_set<std::string> &visited,
+                    std::string &material) {
+  if (depth > MAX_INCLUDE_DEPTH) {
+    return;
+  }
+
+  size_t lineStart = 0;
+  while (lineStart < source.size()) {
+    size_t lineEnd = source.find('\n', lineStart);
+    if (lineEnd == std::string::npos) {
+      lineEnd = source.size();
+    }
+    std::string line = source.substr(lineStart, lineEnd - lineStart);
+    lineStart = lineEnd + 1;
+
+    // Match: [spaces] # [spaces] include [spaces] "name" | <name>
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos == std::string::npos || line[pos] != '#') {
+      continue;
+    }
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+      continue;
+    }
+    pos = line.find_first_not_of(" \t", pos + 7);
+    if (pos == std::string::npos || (line[pos] != '"' && line[pos] != '<')) {
+      continue;
+    }
+    char close = line[pos] == '"' ? '"' : '>';
+    size_t end = line.find(close, pos + 1);
+    if (end == std::string::npos) {
+      continue;
+    }
+    std::string requested = line.substr(pos + 1, end - pos - 1);
+
+    std::string path;
+    std::string content;
+    material += "\ninclude:" + requested + "\n";
+    if (!resolveInclude(requested, fileName, close == '"', directories, path,
+                        content)) {
+      material += "<missing>"; // The compile will fail and not be cached
+      continue;
+    }
+    material += path + "\n" + content;
+
+    if (visited.insert(path).second) {
+      appendIncludes(content, path, directories, depth + 1, visited,
+                     material);
+    }
+  }
+}
+
+/**
+ * @brief Resolves #include directives against a list of directories
+ */
+class FileIncluder : public shaderc::CompileOptions::IncluderInterface {
+public:
+  explicit FileIncluder(std::vector<std::string> directories)
+      : m_directories(std::move(directories)) {}
+
+  shaderc_include_result *GetInclude(const char *requestedSource,
+                                     shaderc_include_type type,
+                                     const char *requestingSource,
+                                     size_t /*includeDepth*/) override {
+    auto *include = new IncludeData();
+
+    // shaderc reports an include error as an empty source name with the
+    // message in the content
+    if (!resolveInclude(requestedSource, requestingSource,
+                        type == shaderc_include_type_relative, m_directories,
+                        include->sourceName, include->content)) {
+      include->sourceName.clear();
+      include->content =
+          std::string("Cannot find include file: ") + requestedSource;
+    }
+
+    include->result.source_name = include->sourceName.c_str();
+    include->result.source_name_length = include->sourceName.size();
+    include->result.content = include->content.c_str();
+    include->result.content_length = include->content.size();
+    include->result.user_data = include;
+    return &include->result;
+  }
+
+  void ReleaseInclude(shaderc_include_result *result) override {
+    delete static_cast<IncludeData *>(result->user_data);
+  }
+
+private:
+  struct IncludeData {
+    shaderc_include_result result;
+    std::string sourceName;
+    std::string content;
+  };
+
+  std::vector<std::string> m_directories;
+};
+
+/**
+ * @brief Build the EmbeddedShaders key for a file and its defines
+ */
+std::string embeddedShaderKey(const std::string &filePath,
+                              const ShaderDefines &defines) {
+  std::string key = filePath;
+  for (const auto &[macro, value] : defines) {
+    key += "|" + macro + "=" + value;
+  }
+  return key;
+}
+
+} // namespace
+
+ShaderManager::ShaderManager(VkDevice device)
+    : m_device(device), m_includeDirectories{"shaders"},
+      m_cacheDirectory(CacheUtils::defaultDirectory() + "/spirv"),
+      m_layoutCache(std::make_unique<LayoutCache>(device)) {
+  std::cout << "[ShaderManager] Initialized shader manager ("
+            << EmbeddedShaders::count() << " embedded shaders)" << std::endl;
 }
 
 ShaderManager::~ShaderManager() {
+  // Stop watcher callbacks before the state they use goes away
+  m_watcher.reset();
+
   std::cout << "[ShaderManager] Cleaning up " << m_shaders.size() << " shaders"
             << std::endl;
   clearShaders();
@@ -26,7 +222,8 @@ ShaderManager::~ShaderManager() {
 
 std::shared_ptr<ShaderInfo>
 ShaderManager::compileShader(const std::string &name, const std::string &source,
-                             ShaderType type, const std::string &entryPoint) {
+                             ShaderType type, const std::string &entryPoint,
+                             const ShaderDefines &defines) {
   std::cout << "[ShaderManager] Compiling shader: " << name << std::endl;
 
   // Check if shader is already cached
@@ -37,9 +234,11 @@ ShaderManager::compileShader(const std::string &name, const std::string &source,
   }
 
   try {
-    // Compile GLSL to SPIR-V
+    // Compile GLSL to SPIR-V, or load it from an earlier run
     std::vector<uint32_t> spirvCode =
-        compileGLSLToSPIRV(source, type, entryPoint, name);
+        getOrCompileSPIRV(source, type, entryPoint, name, defines);
+    ShaderReflection reflection =
+        ShaderReflection::reflect(spirvCode, shaderTypeToVulkanStage(type));
 
     // Create Vulkan shader module
     VkShaderModule module = createVulkanShaderModule(spirvCode);
@@ -51,6 +250,7 @@ ShaderManager::compileShader(const std::string &name, const std::string &source,
     shaderInfo->entryPoint = entryPoint;
     shaderInfo->spirvCode = std::move(spirvCode);
     shaderInfo->sourceCode = source;
+    shaderInfo->reflection = std::move(reflection);
 
     // Cache the shader
     m_shaders[name] = shaderInfo;
@@ -71,16 +271,29 @@ ShaderManager::compileShader(const std::string &name, const std::string &source,
 std::shared_ptr<ShaderInfo>
 ShaderManager::loadShaderFromFile(const std::string &name,
                                   const std::string &filePath, ShaderType type,
-                                  const std::string &entryPoint) {
+                                  const std::string &entryPoint,
+                                  const ShaderDefines &defines) {
   std::cout << "[ShaderManager] Loading shader from file: " << filePath
             << std::endl;
 
+  // Build-time SPIR-V needs neither the source file nor shaderc
+  if (const EmbeddedShader *embedded =
+          EmbeddedShaders::find(embeddedShaderKey(filePath, defines))) {
+    std::cout << "[ShaderManager] Using embedded SPIR-V for " << filePath
+              << std::endl;
+    return createShaderModule(
+        name,
+        std::vector<uint32_t>(embedded->code,
+                              embedded->code + embedded->wordCount),
+        type, entryPoint);
+  }
+
   try {
     // Read shader source from file
     std::string source = readFile(filePath);
 
     // Compile the shader
-    return compileShader(name, source, type, entryPoint);
+    return compileShader(name, source, type, entryPoint, defines);
 
   } catch (const std::exception &e) {
     std::cerr << "[ShaderManager] Failed to load shader from file '" << filePath
@@ -89,6 +302,22 @@ ShaderManager::loadShaderFromFile(const std::string &name,
   }
 }
 
+std::vector<uint32_t> ShaderManager::compileFileToSPIRV(
+    const std::string &filePath, ShaderType type,
+    const std::string &entryPoint, const ShaderDefines &defines,
+    bool useEmbedded) {
+  if (useEmbedded) {
+    if (const EmbeddedShader *embedded =
+            EmbeddedShaders::find(embeddedShaderKey(filePath, defines))) {
+      return std::vector<uint32_t>(embedded->code,
+                                   embedded->code + embedded->wordCount);
+    }
+  }
+
+  std::string source = readFile(filePath);
+  return getOrCompileSPIRV(source, type, entryPoint, filePath, defines);
+}
+
 std::shared_ptr<ShaderInfo> ShaderManager::createShaderModule(
     const std::string &name, const std::vector<uint32_t> &spirvCode,
     ShaderType type, const std::string &entryPoint) {
@@ -102,6 +331,9 @@ std::shared_ptr<ShaderInfo> ShaderManager::createShaderModule(
   }
 
   try {
+    ShaderReflection reflection =
+        ShaderReflection::reflect(spirvCode, shaderTypeToVulkanStage(type));
+
     // Create Vulkan shader module
     VkShaderModule module = createVulkanShaderModule(spirvCode);
 
@@ -112,6 +344,7 @@ std::shared_ptr<ShaderInfo> ShaderManager::createShaderModule(
     shaderInfo->entryPoint = entryPoint;
     shaderInfo->spirvCode = spirvCode;
     shaderInfo->sourceCode = ""; // No source available for pre-compiled SPIR-V
+    shaderInfo->reflection = std::move(reflection);
 
     // Cache the shader
     m_shaders[name] = shaderInfo;
@@ -175,15 +408,24 @@ std::vector<std::string> ShaderManager::getShaderNames() const {
 std::vector<uint32_t>
 ShaderManager::compileGLSLToSPIRV(const std::string &source, ShaderType type,
                                   const std::string &entryPoint,
-                                  const std::string &fileName) {
-  // Initialize shaderc compiler
-  shaderc::Compiler compiler;
+                                  const std::string &fileName,
+                                  const ShaderDefines &defines) {
+  // The compiler is created once, and only when something misses the cache
+  if (!m_compiler) {
+    m_compiler = std::make_unique<shaderc::Compiler>();
+  }
   shaderc::CompileOptions options;
 
-  // Set compilation options
+  // Set compilation options (computeCacheKey() must cover every one)
   options.SetOptimizationLevel(shaderc_optimization_level_performance);
   options.SetWarningsAsErrors();
-  options.SetGenerateDebugInfo();
+  if (GENERATE_DEBUG_INFO) {
+    options.SetGenerateDebugInfo();
+  }
+  for (const auto &[macro, value] : defines) {
+    options.AddMacroDefinition(macro, value);
+  }
+  options.SetIncluder(std::make_unique<FileIncluder>(m_includeDirectories));
 
   // Convert shader type to shaderc kind
   shaderc_shader_kind shadercKind;
@@ -214,7 +456,7 @@ ShaderManager::compileGLSLToSPIRV(const std::string &source, ShaderType type,
   std::cout << "[ShaderManager] Compiling " << fileName
             << " (entry: " << entryPoint << ")" << std::endl;
 
-  shaderc::SpvCompilationResult result = compiler.CompileGlslToSpv(
+  shaderc::SpvCompilationResult result = m_compiler->CompileGlslToSpv(
       source, shadercKind, fileName.c_str(), entryPoint.c_str(), options);
 
   // Check compilation status
@@ -290,6 +532,153 @@ VkShaderStageFlagBits ShaderManager::shaderTypeToVulkanStage(ShaderType type) {
   }
 }
 
+std::vector<uint32_t> ShaderManager::getOrCompileSPIRV(
+    const std::string &source, ShaderType type, const std::string &entryPoint,
+    const std::string &fileName, const ShaderDefines &defines) {
+  // The background pipeline compiler calls in from its own thread
+  std::lock_guard<std::mutex> lock(m_compileMutex);
+
+  if (m_cacheDirectory.empty()) {
+    return compileGLSLToSPIRV(source, type, entryPoint, fileName, defines);
+  }
+
+  uint64_t key = 0;
+  uint64_t check = 0;
+  computeCacheKey(source, type, entryPoint, fileName, defines, key, check);
+
+  std::vector<uint32_t> spirvCode;
+  if (loadCachedSPIRV(key, check, spirvCode)) {
+    std::cout << "[ShaderManager] SPIR-V cache hit for " << fileName << " ("
+              << CacheUtils::toHex(key) << ")" << std::endl;
+    return spirvCode;
+  }
+
+  spirvCode = compileGLSLToSPIRV(source, type, entryPoint, fileName, defines);
+  storeCachedSPIRV(key, check, spirvCode);
+  return spirvCode;
+}
+
+void ShaderManager::computeCacheKey(const std::string &source, ShaderType type,
+                                    const std::string &entryPoint,
+                                    const std::string &fileName,
+                                    const ShaderDefines &defines,
+                                    uint64_t &key, uint64_t &check) const {
+  unsigned int spvVersion = 0;
+  unsigned int spvRevision = 0;
+  shaderc_get_spv_version(&spvVersion, &spvRevision);
+
+  // Everything compileGLSLToSPIRV() passes to shaderc, in a fixed order
+  std::string material = "spirv-cache-v" +
+                         std::to_string(SPIRV_CACHE_VERSION) + "\nshaderc:" +
+                         std::to_string(spvVersion) + "." +
+                         std::to_string(spvRevision) + "\nopt:performance" +
+                         "\nwerror:1\ndebug:" +
+                         std::to_string(GENERATE_DEBUG_INFO) + "\nkind:" +
+                         std::to_string(shaderTypeToShadercKind(type)) +
+                         "\nentry:" + entryPoint + "\nfile:" + fileName;
+  for (const auto &[macro, value] : defines) {
+    material += "\ndefine:" + macro + "=" + value;
+  }
+  for (const auto &directory : m_includeDirectories) {
+    material += "\nincdir:" + directory;
+  }
+  material += "\nsource:" + std::to_string(source.size()) + "\n" + source;
+
+  std::unordered_set<std::string> visited;
+  appendIncludes(source, fileName, m_includeDirectories, 0, visited, material);
+
+  key = CacheUtils::fnv1a(material.data(), material.size());
+  check = CacheUtils::fnv1a(material.data(), material.size(), CHECK_HASH_SEED);
+}
+
+bool ShaderManager::loadCachedSPIRV(uint64_t key, uint64_t check,
+                                    std::vector<uint32_t> &spirvCode) const {
+  std::string path = m_cacheDirectory + "/" + CacheUtils::toHex(key) + ".spv";
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 ||
+      static_cast<size_t>(fileStat.st_size) < sizeof(SpirvCacheHeader)) {
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(fileStat.st_size);
+
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  const auto *header = static_cast<const SpirvCacheHeader *>(mapping);
+  bool valid = header->magic == SPIRV_CACHE_MAGIC &&
+               header->version == SPIRV_CACHE_VERSION &&
+               header->key == key && header->check == check &&
+               header->wordCount > 0 &&
+               header->wordCount ==
+                   (size - sizeof(SpirvCacheHeader)) / sizeof(uint32_t);
+  if (valid) {
+    const auto *words = reinterpret_cast<const uint32_t *>(header + 1);
+    spirvCode.assign(words, words + header->wordCount);
+  } else {
+    std::cerr << "[ShaderManager] Ignoring invalid SPIR-V cache file " << path
+              << std::endl;
+  }
+
+  munmap(mapping, size);
+  return valid;
+}
+
+void ShaderManager::storeCachedSPIRV(
+    uint64_t key, uint64_t check,
+    const std::vector<uint32_t> &spirvCode) const {
+  std::error_code error;
+  std::filesystem::create_directories(m_cacheDirectory, error);
+
+  std::string path = m_cacheDirectory + "/" + CacheUtils::toHex(key) + ".spv";
+  std::string tempPath = path + ".tmp." + std::to_string(getpid());
+
+  SpirvCacheHeader header{};
+  header.magic = SPIRV_CACHE_MAGIC;
+  header.version = SPIRV_CACHE_VERSION;
+  header.key = key;
+  header.check = check;
+  header.wordCount = spirvCode.size();
+
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(spirvCode.data()),
+               static_cast<std::streamsize>(spirvCode.size() *
+                                            sizeof(uint32_t)));
+    if (!file) {
+      std::cerr << "[ShaderManager] Failed to write SPIR-V cache file "
+                << tempPath << std::endl;
+      std::filesystem::remove(tempPath, error);
+      return;
+    }
+  }
+
+  // rename() is atomic: readers see the old file, the new one or none
+  std::filesystem::rename(tempPath, path, error);
+  if (error) {
+    std::cerr << "[ShaderManager] Failed to publish SPIR-V cache file " << path
+              << ": " << error.message() << std::endl;
+    std::filesystem::remove(tempPath, error);
+  }
+}
+
+void ShaderManager::addIncludeDirectory(const std::string &directory) {
+  m_includeDirectories.push_back(directory);
+}
+
+void ShaderManager::setCacheDirectory(const std::string &directory) {
+  m_cacheDirectory = directory;
+}
+
 std::string ShaderManager::readFile(const std::string &filePath) {
   std::ifstream file(filePath, std::ios::ate | std::ios::binary);
 
@@ -322,17 +711,31 @@ bool ShaderManager::enableHotReload(const std::string &name,
     // Get file modification time
     std::time_t modTime = getFileModTime(filePath);
 
+    // Watch the directory, so saves that rename over the file are seen too
+    if (!m_watcher) {
+      m_watcher = std::make_unique<ShaderWatcher>(
+          [this](const std::vector<std::string> &paths) {
+            onFilesChanged(paths);
+          });
+    }
+    bool watched = m_watcher->watchDirectory(
+        std::filesystem::path(filePath).parent_path().string());
+
     // Store hot-reload info
     HotReloadInfo hotReloadInfo;
     hotReloadInfo.filePath = filePath;
     hotReloadInfo.type = shader->type;
     hotReloadInfo.entryPoint = shader->entryPoint;
     hotReloadInfo.lastModTime = modTime;
+    hotReloadInfo.watched = watched;
 
-    m_hotReloadShaders[name] = hotReloadInfo;
+    {
+      std::lock_guard<std::mutex> lock(m_hotReloadMutex);
+      m_hotReloadShaders[name] = hotReloadInfo;
+    }
 
     std::cout << "[ShaderManager] Hot-reload enabled for shader: " << name
-              << std::endl;
+              << (watched ? " (inotify)" : " (polling)") << std::endl;
     return true;
   } catch (const std::exception &e) {
     std::cerr << "[ShaderManager] Failed to enable hot-reload for '" << name
@@ -342,18 +745,65 @@ bool ShaderManager::enableHotReload(const std::string &name,
 }
 
 void ShaderManager::disableHotReload(const std::string &name) {
+  std::lock_guard<std::mutex> lock(m_hotReloadMutex);
   auto it = m_hotReloadShaders.find(name);
   if (it != m_hotReloadShaders.end()) {
     m_hotReloadShaders.erase(it);
+    std::erase_if(m_pendingChanges, [&name](const ShaderFileChange &change) {
+      return change.name == name;
+    });
     std::cout << "[ShaderManager] Hot-reload disabled for shader: " << name
               << std::endl;
   }
 }
 
+void ShaderManager::setChangeCallback(ChangeCallback callback) {
+  std::lock_guard<std::mutex> lock(m_callbackMutex);
+  m_changeCallback = std::move(callback);
+}
+
 std::vector<std::string> ShaderManager::checkForUpdates() {
   std::vector<std::string> recompiledShaders;
 
+  for (const auto &change : collectChangedShaders()) {
+    try {
+      // Read updated source
+      std::string updatedSource = readFile(change.filePath);
+
+      // Remove old shader from cache
+      removeShader(change.name);
+
+      // Recompile with updated source
+      auto recompiledShader = compileShader(change.name, updatedSource,
+                                            change.type, change.entryPoint);
+
+      if (recompiledShader) {
+        recompiledShaders.push_back(change.name);
+        std::cout << "[ShaderManager] Successfully recompiled shader: "
+                  << change.name << std::endl;
+      } else {
+        std::cerr << "[ShaderManager] Failed to recompile shader: "
+                  << change.name << std::endl;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "[ShaderManager] Error recompiling shader '" << change.name
+                << "': " << e.what() << std::endl;
+    }
+  }
+
+  return recompiledShaders;
+}
+
+std::vector<ShaderFileChange> ShaderManager::collectChangedShaders() {
+  std::lock_guard<std::mutex> lock(m_hotReloadMutex);
+  std::vector<ShaderFileChange> changes = std::move(m_pendingChanges);
+  m_pendingChanges.clear();
+
+  // Only files the watcher could not cover are polled
   for (auto &[name, hotReloadInfo] : m_hotReloadShaders) {
+    if (hotReloadInfo.watched) {
+      continue;
+    }
     try {
       std::time_t currentModTime = getFileModTime(hotReloadInfo.filePath);
 
@@ -362,26 +812,10 @@ std::vector<std::string> ShaderManager::checkForUpdates() {
         std::cout << "[ShaderManager] Detected change in shader file: "
                   << hotReloadInfo.filePath << std::endl;
 
-        // Read updated source
-        std::string updatedSource = readFile(hotReloadInfo.filePath);
-
-        // Remove old shader from cache
-        removeShader(name);
-
-        // Recompile with updated source
-        auto recompiledShader = compileShader(
-            name, updatedSource, hotReloadInfo.type, hotReloadInfo.entryPoint);
-
-        if (recompiledShader) {
-          // Update modification time
-          hotReloadInfo.lastModTime = currentModTime;
-          recompiledShaders.push_back(name);
-          std::cout << "[ShaderManager] Successfully recompiled shader: "
-                    << name << std::endl;
-        } else {
-          std::cerr << "[ShaderManager] Failed to recompile shader: " << name
-                    << std::endl;
-        }
+        // Report each change once, even if the recompile fails
+        hotReloadInfo.lastModTime = currentModTime;
+        changes.push_back({name, hotReloadInfo.filePath, hotReloadInfo.type,
+                           hotReloadInfo.entryPoint});
       }
     } catch (const std::exception &e) {
       std::cerr << "[ShaderManager] Error checking shader '" << name
@@ -389,7 +823,55 @@ std::vector<std::string> ShaderManager::checkForUpdates() {
     }
   }
 
-  return recompiledShaders;
+  return changes;
+}
+
+void ShaderManager::onFilesChanged(const std::vector<std::string> &paths) {
+  // Any watched shader may include a changed .glsl file
+  bool includeChanged =
+      std::any_of(paths.begin(), paths.end(), [](const std::string &path) {
+        return std::filesystem::path(path).extension() == ".glsl";
+      });
+
+  std::vector<ShaderFileChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(m_hotReloadMutex);
+    for (const auto &[name, hotReloadInfo] : m_hotReloadShaders) {
+      bool fileChanged = std::find(paths.begin(), paths.end(),
+                                   hotReloadInfo.filePath) != paths.end();
+      if (hotReloadInfo.watched && (includeChanged || fileChanged)) {
+        changes.push_back({name, hotReloadInfo.filePath, hotReloadInfo.type,
+                           hotReloadInfo.entryPoint});
+      }
+    }
+  }
+  if (changes.empty()) {
+    return;
+  }
+
+  for (const auto &change : changes) {
+    std::cout << "[ShaderManager] Detected change in shader file: "
+              << change.filePath << std::endl;
+  }
+
+  std::lock_guard<std::mutex> callbackLock(m_callbackMutex);
+  if (m_changeCallback) {
+    m_changeCallback(changes);
+    return;
+  }
+
+  // Queue for the next collectChangedShaders(), once per shader
+  std::lock_guard<std::mutex> lock(m_hotReloadMutex);
+  for (auto &change : changes) {
+    bool queued = std::any_of(
+        m_pendingChanges.begin(), m_pendingChanges.end(),
+        [&change](const ShaderFileChange &pending) {
+          return pending.name == change.name;
+        });
+    if (!queued) {
+      m_pendingChanges.push_back(std::move(change));
+    }
+  }
 }
 
 std::time_t ShaderManager::getFileModTime(const std::string &filePath) {
@@ -19,13 +19,24 @@
 
 #pragma once
 
+#include "ShaderReflection.h"
+#include <cstdint>
 #include <ctime>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <vulkan/vulkan.h>
 
+namespace shaderc {
+class Compiler;
+}
+class ShaderWatcher;
+class LayoutCache;
+
 /**
  * @enum ShaderType
  * @brief Types of shaders supported by the shader manager
@@ -39,6 +50,11 @@ enum class ShaderType {
   TESSELLATION_EVALUATION
 };
 
+/**
+ * @brief Preprocessor macros passed to the GLSL compiler (name, value)
+ */
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
 /**
  * @struct ShaderInfo
  * @brief Information about a compiled shader
@@ -49,6 +65,18 @@ struct ShaderInfo {
   std::string entryPoint;          ///< Entry point function name
   std::vector<uint32_t> spirvCode; ///< Compiled SPIR-V bytecode
   std::string sourceCode;          ///< Original GLSL source (for debugging)
+  ShaderReflection reflection;     ///< Descriptors, push constants, local size
+};
+
+/**
+ * @struct ShaderFileChange
+ * @brief A hot-reload watched file that changed on disk
+ */
+struct ShaderFileChange {
+  std::string name;       ///< Shader name given to enableHotReload()
+  std::string filePath;   ///< Modified file
+  ShaderType type;        ///< Type of shader
+  std::string entryPoint; ///< Entry point function name
 };
 
 /**
@@ -99,21 +127,28 @@ public:
    * @param source GLSL source code
    * @param type Type of shader to compile
    * @param entryPoint Entry point function name (default: "main")
+   * @param defines Preprocessor macros for this compilation
    * @return Pointer to ShaderInfo containing compiled shader data
    *
    * @throws std::runtime_error If compilation or module creation fails
    */
   std::shared_ptr<ShaderInfo>
   compileShader(const std::string &name, const std::string &source,
-                ShaderType type, const std::string &entryPoint = "main");
+                ShaderType type, const std::string &entryPoint = "main",
+                const ShaderDefines &defines = {});
 
   /**
    * @brief Load and compile shader from file
    *
+   * Uses the SPIR-V embedded at build time when the file and defines match
+   * an embedded variant, without reading the file; otherwise compiles the
+   * source at runtime.
+   *
    * @param name Unique name for the shader
    * @param filePath Path to GLSL shader file
    * @param type Type of shader to compile
    * @param entryPoint Entry point function name (default: "main")
+   * @param defines Preprocessor macros for this compilation
    * @return Pointer to ShaderInfo containing compiled shader data
    *
    * @throws std::runtime_error If file reading, compilation, or module creation
@@ -121,7 +156,31 @@ public:
    */
   std::shared_ptr<ShaderInfo>
   loadShaderFromFile(const std::string &name, const std::string &filePath,
-                     ShaderType type, const std::string &entryPoint = "main");
+                     ShaderType type, const std::string &entryPoint = "main",
+                     const ShaderDefines &defines = {});
+
+  /**
+   * @brief Get SPIR-V for a shader file without creating a module
+   *
+   * Safe to call from any thread: compilation and the disk cache are
+   * serialized internally and the shader table is not touched. Include
+   * directories must not be added concurrently.
+   *
+   * @param filePath Path to GLSL shader file
+   * @param type Type of shader to compile
+   * @param entryPoint Entry point function name (default: "main")
+   * @param defines Preprocessor macros for this compilation
+   * @param useEmbedded Use build-time SPIR-V if available; pass false when
+   *                    the file is known to have changed since the build
+   * @return Compiled SPIR-V bytecode
+   *
+   * @throws std::runtime_error If file reading or compilation fails
+   */
+  std::vector<uint32_t>
+  compileFileToSPIRV(const std::string &filePath, ShaderType type,
+                     const std::string &entryPoint = "main",
+                     const ShaderDefines &defines = {},
+                     bool useEmbedded = true);
 
   /**
    * @brief Create shader module from pre-compiled SPIR-V bytecode
@@ -171,7 +230,9 @@ public:
    * @brief Enable hot-reloading for a shader file
    *
    * Monitors the shader file for changes and automatically recompiles
-   * when modifications are detected. Useful for development.
+   * when modifications are detected. Useful for development. On Linux the
+   * file's directory is watched with inotify; elsewhere the file's
+   * modification time is polled by collectChangedShaders().
    *
    * @param name Shader name to enable hot-reloading for
    * @param filePath Path to the shader file to monitor
@@ -196,8 +257,66 @@ public:
    */
   std::vector<std::string> checkForUpdates();
 
+  /**
+   * @brief Find watched shader files that changed, without recompiling
+   *
+   * Each change is reported once. Callers recompile off the render thread
+   * (see PipelineCompiler); checkForUpdates() is the synchronous variant.
+   * Files seen by the inotify watcher cost no system call here; changes
+   * already passed to the change callback are not reported again.
+   *
+   * @return Watched files modified since the last check
+   */
+  std::vector<ShaderFileChange> collectChangedShaders();
+
+  /**
+   * @brief Called on the watcher thread with each batch of changes
+   */
+  using ChangeCallback =
+      std::function<void(const std::vector<ShaderFileChange> &)>;
+
+  /**
+   * @brief Receive inotify changes as they happen instead of by polling
+   *
+   * The callback runs on the watcher thread and must be thread-safe.
+   * Changes found by modification-time polling are still only returned
+   * from collectChangedShaders(). Setting a new callback waits for a
+   * running one to return, so the previous one may be destroyed after.
+   *
+   * @param callback Receiver, or nullptr to queue changes for polling
+   */
+  void setChangeCallback(ChangeCallback callback);
+
+  /**
+   * @brief Add a directory searched by GLSL #include directives
+   *
+   * Includes are resolved relative to the including file first, then in the
+   * include directories in the order they were added. "shaders" is always
+   * searched.
+   *
+   * @param directory Directory path (relative to the working directory)
+   */
+  void addIncludeDirectory(const std::string &directory);
+
+  /**
+   * @brief Set where compiled SPIR-V is cached on disk
+   *
+   * Defaults to the "spirv" subdirectory of the shared cache directory.
+   *
+   * @param directory Cache directory; empty disables the SPIR-V cache
+   */
+  void setCacheDirectory(const std::string &directory);
+
+  /**
+   * @brief Get the cache of layouts derived from shader reflection
+   *
+   * Layouts handed out stay valid until the shader manager is destroyed.
+   *
+   * @return Layout cache shared by all pipelines
+   */
+  LayoutCache &getLayoutCache() { return *m_layoutCache; }
+
   // TODO(Phase 4): Add shader optimization levels
-  // TODO(Phase 5): Add shader reflection for automatic descriptor set layout
 
 private:
   /**
@@ -217,7 +336,53 @@ private:
   std::vector<uint32_t>
   compileGLSLToSPIRV(const std::string &source, ShaderType type,
                      const std::string &entryPoint,
-                     const std::string &fileName = "shader");
+                     const std::string &fileName = "shader",
+                     const ShaderDefines &defines = {});
+
+  /**
+   * @brief Get SPIR-V from the disk cache, compiling only on a miss
+   *
+   * Parameters as for compileGLSLToSPIRV().
+   *
+   * @return Compiled SPIR-V bytecode
+   *
+   * @throws std::runtime_error If compilation fails
+   */
+  std::vector<uint32_t> getOrCompileSPIRV(const std::string &source,
+                                          ShaderType type,
+                                          const std::string &entryPoint,
+                                          const std::string &fileName,
+                                          const ShaderDefines &defines);
+
+  /**
+   * @brief Hash everything that affects the compiled SPIR-V
+   *
+   * Covers the source, every file it includes (resolved and read the same
+   * way the compiler will), defines, shader kind, entry point and compiler
+   * options.
+   *
+   * @param key Output hash naming the cache file
+   * @param check Output independent hash stored inside the file
+   */
+  void computeCacheKey(const std::string &source, ShaderType type,
+                       const std::string &entryPoint,
+                       const std::string &fileName,
+                       const ShaderDefines &defines, uint64_t &key,
+                       uint64_t &check) const;
+
+  /**
+   * @brief Map a cached SPIR-V file and copy out its code
+   *
+   * @return true on a valid hit
+   */
+  bool loadCachedSPIRV(uint64_t key, uint64_t check,
+                       std::vector<uint32_t> &spirvCode) const;
+
+  /**
+   * @brief Publish SPIR-V to the cache (write to a temp file, then rename)
+   */
+  void storeCachedSPIRV(uint64_t key, uint64_t check,
+                        const std::vector<uint32_t> &spirvCode) const;
 
   /**
    * @brief Create Vulkan shader module from SPIR-V bytecode
@@ -236,7 +401,7 @@ private:
    * @param type ShaderType to convert
    * @return Corresponding shaderc_shader_kind
    */
-  uint32_t shaderTypeToShadercKind(ShaderType type);
+  static uint32_t shaderTypeToShadercKind(ShaderType type);
 
   /**
    * @brief Convert ShaderType enum to VkShaderStageFlagBits
@@ -269,15 +434,37 @@ private:
   std::unordered_map<std::string, std::shared_ptr<ShaderInfo>>
       m_shaders; ///< Cached shaders
 
+  /**
+   * @brief Map a batch of changed files to watched shaders (watcher thread)
+   *
+   * @param paths Files written since the previous batch
+   */
+  void onFilesChanged(const std::vector<std::string> &paths);
+
   // Hot-reload support
   struct HotReloadInfo {
     std::string filePath;
     ShaderType type;
     std::string entryPoint;
     std::time_t lastModTime;
+    bool watched; ///< Reported by the watcher, never polled
   };
   std::unordered_map<std::string, HotReloadInfo>
       m_hotReloadShaders; ///< Hot-reload tracking
+  std::vector<ShaderFileChange>
+      m_pendingChanges;       ///< Watcher changes not yet collected
+  std::mutex m_hotReloadMutex; ///< Guards the two members above
+  std::mutex m_callbackMutex;  ///< Held while m_changeCallback runs
+  ChangeCallback m_changeCallback; ///< Receiver of watcher batches
+
+  std::vector<std::string> m_includeDirectories; ///< #include search path
+
+  std::unique_ptr<shaderc::Compiler> m_compiler; ///< Created on first miss
+  std::string m_cacheDirectory; ///< SPIR-V cache, empty = disabled
+  std::mutex m_compileMutex; ///< Serializes m_compiler and cache files
+
+  std::unique_ptr<ShaderWatcher> m_watcher; ///< Created on first hot-reload
+  std::unique_ptr<LayoutCache> m_layoutCache; ///< Reflected layouts
 };
 
 /**
@@ -302,6 +489,38 @@ private:
  * 4. Future Extensions:
  *    - Hot-reloading for development workflow
  *    - Shader optimization levels
- *    - Automatic descriptor set layout generation from reflection
- *    - Include system for modular shaders
+ *
+ * 5. Includes:
+ *    - #include (GL_GOOGLE_include_directive) is resolved by a shaderc
+ *      includer over m_includeDirectories, so shaders share fractal_common.glsl
+ *    - Hot-reload watches the top-level files; an edit to a .glsl file in
+ *      a watched directory reloads every watched shader, since any of them
+ *      may include it
+ *
+ * 6. SPIR-V Cache:
+ *    - Compiled SPIR-V is stored under a hash of everything that affects
+ *      it; a hit maps the file and never touches shaderc
+ *    - Includes are found by scanning for #include lines, so an include
+ *      inside an inactive #if still counts towards the key (a spurious
+ *      miss at worst, never a stale hit)
+ *    - Files are written to a per-process temp name and renamed into
+ *      place, so concurrent processes never see a partial file
+ *
+ * 7. Embedded SPIR-V:
+ *    - loadShaderFromFile() checks EmbeddedShaders first, keyed by the
+ *      path as passed in plus defines, so startup never touches shaderc
+ *    - Hot-reload recompiles from source through compileShader(), which
+ *      bypasses the embedded table; the compiler is created on first use
+ *
+ * 8. Threading:
+ *    - compileFileToSPIRV() may run on PipelineCompiler's worker while the
+ *      render thread uses the shader table; only the compiler and the disk
+ *      cache are shared, behind m_compileMutex
+ *    - ShaderWatcher delivers batches on its own thread; the hot-reload
+ *      table it reads is guarded by m_hotReloadMutex
+ *
+ * 9. Reflection:
+ *    - Every ShaderInfo carries the descriptor bindings, push constant size
+ *      and workgroup size read from its SPIR-V; pipelines build their
+ *      layouts from it through getLayoutCache() instead of by hand
  */
@@ -0,0 +1,463 @@
+/**
+ * @file ShaderReflection.cpp
+ * @brief Implementation of SPIR-V resource reflection
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "ShaderReflection.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+constexpr size_t SPIRV_HEADER_WORDS = 5;
+
+// Opcodes
+constexpr uint32_t OP_EXECUTION_MODE = 16;
+constexpr uint32_t OP_TYPE_BOOL = 20;
+constexpr uint32_t OP_TYPE_INT = 21;
+constexpr uint32_t OP_TYPE_FLOAT = 22;
+constexpr uint32_t OP_TYPE_VECTOR = 23;
+constexpr uint32_t OP_TYPE_MATRIX = 24;
+constexpr uint32_t OP_TYPE_IMAGE = 25;
+constexpr uint32_t OP_TYPE_SAMPLER = 26;
+constexpr uint32_t OP_TYPE_SAMPLED_IMAGE = 27;
+constexpr uint32_t OP_TYPE_ARRAY = 28;
+constexpr uint32_t OP_TYPE_RUNTIME_ARRAY = 29;
+constexpr uint32_t OP_TYPE_STRUCT = 30;
+constexpr uint32_t OP_TYPE_POINTER = 32;
+constexpr uint32_t OP_CONSTANT = 43;
+constexpr uint32_t OP_VARIABLE = 59;
+constexpr uint32_t OP_DECORATE = 71;
+constexpr uint32_t OP_MEMBER_DECORATE = 72;
+constexpr uint32_t OP_EXECUTION_MODE_ID = 331;
+
+// Decorations
+constexpr uint32_t DECORATION_BLOCK = 2;
+constexpr uint32_t DECORATION_BUFFER_BLOCK = 3;
+constexpr uint32_t DECORATION_ARRAY_STRIDE = 6;
+constexpr uint32_t DECORATION_MATRIX_STRIDE = 7;
+constexpr uint32_t DECORATION_BINDING = 33;
+constexpr uint32_t DECORATION_DESCRIPTOR_SET = 34;
+constexpr uint32_t DECORATION_OFFSET = 35;
+
+// Storage classes
+constexpr uint32_t STORAGE_UNIFORM_CONSTANT = 0;
+constexpr uint32_t STORAGE_UNIFORM = 2;
+constexpr uint32_t STORAGE_PUSH_CONSTANT = 9;
+constexpr uint32_t STORAGE_STORAGE_BUFFER = 12;
+
+// Execution modes
+constexpr uint32_t MODE_LOCAL_SIZE = 17;
+constexpr uint32_t MODE_LOCAL_SIZE_ID = 38;
+
+// Image dimensions and sampled-ness
+constexpr uint32_t DIM_BUFFER = 5;
+constexpr uint32_t DIM_SUBPASS_DATA = 6;
+constexpr uint32_t IMAGE_STORAGE = 2;
+
+/**
+ * @brief Everything the parser keeps about one result id
+ */
+struct SpirvId {
+  uint32_t opcode = 0;
+  std::vector<uint32_t> operands; ///< Operands after the result id
+  uint32_t binding = UINT32_MAX;
+  uint32_t set = UINT32_MAX;
+  uint32_t arrayStride = 0;
+  bool block = false;
+  bool bufferBlock = false;
+  std::map<uint32_t, uint32_t> memberOffsets;  ///< Member -> Offset
+  std::map<uint32_t, uint32_t> matrixStrides; ///< Member -> MatrixStride
+};
+
+/**
+ * @brief Parsed module, indexed by result id
+ */
+class SpirvModule {
+public:
+  explicit SpirvModule(const std::vector<uint32_t> &code) {
+    if (code.size() < SPIRV_HEADER_WORDS || code[0] != SPIRV_MAGIC) {
+      throw std::runtime_error("Not a SPIR-V module");
+    }
+    m_ids.resize(code[3]); // Id bound
+
+    size_t pos = SPIRV_HEADER_WORDS;
+    while (pos < code.size()) {
+      uint32_t wordCount = code[pos] >> 16;
+      uint32_t opcode = code[pos] & 0xFFFF;
+      if (wordCount == 0 || pos + wordCount > code.size()) {
+        throw std::runtime_error("Truncated SPIR-V instruction");
+      }
+      parse(opcode, &code[pos + 1], wordCount - 1);
+      pos += wordCount;
+    }
+  }
+
+  const SpirvId &operator[](uint32_t id) const {
+    if (id >= m_ids.size()) {
+      throw std::runtime_error("SPIR-V id out of range");
+    }
+    return m_ids[id];
+  }
+
+  const std::vector<uint32_t> &variables() const { return m_variables; }
+  const std::vector<std::vector<uint32_t>> &executionModes() const {
+    return m_executionModes;
+  }
+
+  /**
+   * @brief Get the value of a 32-bit integer constant
+   */
+  uint32_t constant(uint32_t id) const {
+    // Operands: result type, value
+    const SpirvId &value = (*this)[id];
+    if (value.opcode != OP_CONSTANT || value.operands.size() < 2) {
+      throw std::runtime_error("Expected a SPIR-V constant");
+    }
+    return value.operands[1];
+  }
+
+  /**
+   * @brief Get the size in bytes of a type as laid out in a block
+   *
+   * @param typeId Type to measure
+   * @param matrixStride MatrixStride of the member holding the type
+   */
+  uint32_t sizeOf(uint32_t typeId, uint32_t matrixStride = 0) const {
+    const SpirvId &type = (*this)[typeId];
+    switch (type.opcode) {
+    case OP_TYPE_BOOL:
+      return 4;
+    case OP_TYPE_INT:
+    case OP_TYPE_FLOAT:
+      return type.operands.at(0) / 8;
+    case OP_TYPE_VECTOR:
+      return sizeOf(type.operands.at(0)) * type.operands.at(1);
+    case OP_TYPE_MATRIX: {
+      uint32_t columnSize = sizeOf(type.operands.at(0));
+      return std::max(matrixStride, columnSize) * type.operands.at(1);
+    }
+    case OP_TYPE_ARRAY: {
+      uint32_t length = constant(type.operands.at(1));
+      uint32_t stride = type.arrayStride
+                            ? type.arrayStride
+                            : sizeOf(type.operands.at(0), matrixStride);
+      return stride * length;
+    }
+    case OP_TYPE_RUNTIME_ARRAY:
+      return 0;
+    case OP_TYPE_STRUCT: {
+      uint32_t size = 0;
+      for (uint32_t member = 0; member < type.operands.size(); member++) {
+        auto offset = type.memberOffsets.find(member);
+        auto stride = type.matrixStrides.find(member);
+        uint32_t end =
+            (offset != type.memberOffsets.end() ? offset->second : size) +
+            sizeOf(type.operands[member],
+                   stride != type.matrixStrides.end() ? stride->second : 0);
+        size = std::max(size, end);
+      }
+      return size;
+    }
+    default:
+      throw std::runtime_error("Unsupported type in SPIR-V block (opcode " +
+                               std::to_string(type.opcode) + ")");
+    }
+  }
+
+private:
+  void parse(uint32_t opcode, const uint32_t *operands, uint32_t count) {
+    switch (opcode) {
+    case OP_EXECUTION_MODE:
+    case OP_EXECUTION_MODE_ID: {
+      std::vector<uint32_t> mode(operands, operands + count);
+      mode.push_back(opcode == OP_EXECUTION_MODE_ID);
+      m_executionModes.push_back(std::move(mode));
+      break;
+    }
+    case OP_TYPE_BOOL:
+    case OP_TYPE_INT:
+    case OP_TYPE_FLOAT:
+    case OP_TYPE_VECTOR:
+    case OP_TYPE_MATRIX:
+    case OP_TYPE_IMAGE:
+    case OP_TYPE_SAMPLER:
+    case OP_TYPE_SAMPLED_IMAGE:
+    case OP_TYPE_ARRAY:
+    case OP_TYPE_RUNTIME_ARRAY:
+    case OP_TYPE_STRUCT:
+    case OP_TYPE_POINTER:
+      // Result id first, then the operands
+      define(opcode, operands[0], operands + 1, count - 1);
+      break;
+    case OP_CONSTANT:
+    case OP_VARIABLE:
+      // Result type, result id, then the operands
+      if (count >= 2) {
+        define(opcode, operands[1], operands + 2, count - 2);
+        m_ids[operands[1]].operands.insert(
+            m_ids[operands[1]].operands.begin(), operands[0]);
+        if (opcode == OP_VARIABLE) {
+          m_variables.push_back(operands[1]);
+        }
+      }
+      break;
+    case OP_DECORATE:
+      if (count >= 2 && operands[0] < m_ids.size()) {
+        decorate(m_ids[operands[0]], operands[1],
+                 count > 2 ? operands[2] : 0);
+      }
+      break;
+    case OP_MEMBER_DECORATE:
+      if (count >= 4 && operands[0] < m_ids.size()) {
+        SpirvId &type = m_ids[operands[0]];
+        if (operands[2] == DECORATION_OFFSET) {
+          type.memberOffsets[operands[1]] = operands[3];
+        } else if (operands[2] == DECORATION_MATRIX_STRIDE) {
+          type.matrixStrides[operands[1]] = operands[3];
+        }
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  void define(uint32_t opcode, uint32_t id, const uint32_t *operands,
+              uint32_t count) {
+    if (id >= m_ids.size()) {
+      throw std::runtime_error("SPIR-V id out of range");
+    }
+    m_ids[id].opcode = opcode;
+    m_ids[id].operands.assign(operands, operands + count);
+  }
+
+  static void decorate(SpirvId &target, uint32_t decoration,
+                       uint32_t literal) {
+    switch (decoration) {
+    case DECORATION_BLOCK:
+      target.block = true;
+      break;
+    case DECORATION_BUFFER_BLOCK:
+      target.bufferBlock = true;
+      break;
+    case DECORATION_ARRAY_STRIDE:
+      target.arrayStride = literal;
+      break;
+    case DECORATION_BINDING:
+      target.binding = literal;
+      break;
+    case DECORATION_DESCRIPTOR_SET:
+      target.set = literal;
+      break;
+    default:
+      break;
+    }
+  }
+
+  std::vector<SpirvId> m_ids;
+  std::vector<uint32_t> m_variables;
+  std::vector<std::vector<uint32_t>> m_executionModes;
+};
+
+/**
+ * @brief Map an opaque UniformConstant type to its descriptor type
+ */
+VkDescriptorType opaqueDescriptorType(const SpirvId &type) {
+  switch (type.opcode) {
+  case OP_TYPE_SAMPLER:
+    return VK_DESCRIPTOR_TYPE_SAMPLER;
+  case OP_TYPE_SAMPLED_IMAGE:
+    return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  case OP_TYPE_IMAGE: {
+    // Operands: sampled type, dim, depth, arrayed, ms, sampled, format
+    uint32_t dim = type.operands.at(1);
+    bool storage = type.operands.at(5) == IMAGE_STORAGE;
+    if (dim == DIM_BUFFER) {
+      return storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                     : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+    }
+    if (dim == DIM_SUBPASS_DATA) {
+      return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+    }
+    return storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                   : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+  }
+  default:
+    throw std::runtime_error("Unsupported UniformConstant type (opcode " +
+                             std::to_string(type.opcode) + ")");
+  }
+}
+
+} // namespace
+
+ShaderReflection ShaderReflection::reflect(const std::vector<uint32_t> &spirvCode,
+                                           VkShaderStageFlagBits stage) {
+  SpirvModule module(spirvCode);
+  ShaderReflection reflection;
+
+  for (uint32_t variableId : module.variables()) {
+    const SpirvId &variable = module[variableId];
+    // Operands: result type, storage class
+    uint32_t storageClass = variable.operands.at(1);
+    const SpirvId &pointer = module[variable.operands.at(0)];
+    uint32_t typeId = pointer.operands.at(1);
+
+    if (storageClass == STORAGE_PUSH_CONSTANT) {
+      reflection.pushConstantSize =
+          std::max(reflection.pushConstantSize, module.sizeOf(typeId));
+      reflection.pushConstantStages = stage;
+      continue;
+    }
+    if (storageClass != STORAGE_UNIFORM_CONSTANT &&
+        storageClass != STORAGE_UNIFORM &&
+        storageClass != STORAGE_STORAGE_BUFFER) {
+      continue;
+    }
+
+    // Arrays of descriptors
+    uint32_t count = 1;
+    const SpirvId *type = &module[typeId];
+    if (type->opcode == OP_TYPE_ARRAY) {
+      count = module.constant(type->operands.at(1));
+      type = &module[type->operands.at(0)];
+    } else if (type->opcode == OP_TYPE_RUNTIME_ARRAY) {
+      type = &module[type->operands.at(0)];
+    }
+
+    VkDescriptorType descriptorType;
+    if (storageClass == STORAGE_STORAGE_BUFFER ||
+        (storageClass == STORAGE_UNIFORM && type->bufferBlock)) {
+      descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    } else if (storageClass == STORAGE_UNIFORM) {
+      descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    } else {
+      descriptorType = opaqueDescriptorType(*type);
+    }
+
+    reflection.bindings.push_back(
+        {variable.set == UINT32_MAX ? 0 : variable.set,
+         variable.binding == UINT32_MAX ? 0 : variable.binding,
+         descriptorType, count, static_cast<VkShaderStageFlags>(stage)});
+  }
+
+  std::sort(reflection.bindings.begin(), reflection.bindings.end(),
+            [](const ReflectedBinding &a, const ReflectedBinding &b) {
+              return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+            });
+
+  // Operands: entry point, mode, literals or ids, then the "is id" flag
+  for (const auto &mode : module.executionModes()) {
+    if (mode.size() >= 6 &&
+        (mode[1] == MODE_LOCAL_SIZE || mode[1] == MODE_LOCAL_SIZE_ID)) {
+      bool ids = mode[1] == MODE_LOCAL_SIZE_ID;
+      for (int i = 0; i < 3; i++) {
+        reflection.localSize[i] =
+            ids ? module.constant(mode[2 + i]) : mode[2 + i];
+      }
+    }
+  }
+
+  return reflection;
+}
+
+void ShaderReflection::merge(const ShaderReflection &other) {
+  for (const auto &binding : other.bindings) {
+    auto it = std::find_if(bindings.begin(), bindings.end(),
+                           [&binding](const ReflectedBinding &existing) {
+                             return existing.set == binding.set &&
+                                    existing.binding == binding.binding;
+                           });
+    if (it == bindings.end()) {
+      bindings.push_back(binding);
+      continue;
+    }
+    if (it->descriptorType != binding.descriptorType) {
+      throw std::runtime_error(
+          "Shaders disagree on the type of set " + std::to_string(binding.set) +
+          " binding " + std::to_string(binding.binding));
+    }
+    it->descriptorCount = std::max(it->descriptorCount, binding.descriptorCount);
+    it->stageFlags |= binding.stageFlags;
+  }
+
+  std::sort(bindings.begin(), bindings.end(),
+            [](const ReflectedBinding &a, const ReflectedBinding &b) {
+              return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+            });
+
+  pushConstantSize = std::max(pushConstantSize, other.pushConstantSize);
+  pushConstantStages |= other.pushConstantStages;
+}
+
+bool ShaderReflection::covers(const ShaderReflection &other) const {
+  for (const auto &binding : other.bindings) {
+    bool found = std::any_of(
+        bindings.begin(), bindings.end(),
+        [&binding](const ReflectedBinding &existing) {
+          return existing.set == binding.set &&
+                 existing.binding == binding.binding &&
+                 existing.descriptorType == binding.descriptorType &&
+                 existing.descriptorCount >= binding.descriptorCount &&
+                 (existing.stageFlags & binding.stageFlags) ==
+                     binding.stageFlags;
+        });
+    if (!found) {
+      return false;
+    }
+  }
+  return other.pushConstantSize <= pushConstantSize &&
+         (pushConstantStages & other.pushConstantStages) ==
+             other.pushConstantStages;
+}
+
+uint32_t ShaderReflection::getSetCount() const {
+  return bindings.empty() ? 0 : bindings.back().set + 1;
+}
+
+std::vector<VkDescriptorSetLayoutBinding>
+ShaderReflection::getSetBindings(uint32_t set) const {
+  std::vector<VkDescriptorSetLayoutBinding> setBindings;
+  for (const auto &binding : bindings) {
+    if (binding.set == set) {
+      VkDescriptorSetLayoutBinding layoutBinding{};
+      layoutBinding.binding = binding.binding;
+      layoutBinding.descriptorType = binding.descriptorType;
+      layoutBinding.descriptorCount = binding.descriptorCount;
+      layoutBinding.stageFlags = binding.stageFlags;
+      layoutBinding.pImmutableSamplers = nullptr;
+      setBindings.push_back(layoutBinding);
+    }
+  }
+  return setBindings;
+}
+
+std::vector<VkPushConstantRange>
+ShaderReflection::getPushConstantRanges() const {
+  if (pushConstantSize == 0) {
+    return {};
+  }
+  return {{pushConstantStages, 0, pushConstantSize}};
+}
+
+std::vector<VkDescriptorPoolSize>
+ShaderReflection::getPoolSizes(uint32_t setCount) const {
+  std::unordered_map<uint32_t, uint32_t> counts; // VkDescriptorType -> count
+  for (const auto &binding : bindings) {
+    counts[binding.descriptorType] += binding.descriptorCount * setCount;
+  }
+
+  std::vector<VkDescriptorPoolSize> poolSizes;
+  for (const auto &[type, count] : counts) {
+    poolSizes.push_back({static_cast<VkDescriptorType>(type), count});
+  }
+  return poolSizes;
+}
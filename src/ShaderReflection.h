@@ -0,0 +1,124 @@
+/**
+ * @file ShaderReflection.h
+ * @brief Descriptor, push constant and workgroup reflection from SPIR-V
+ *
+ * Reads the resource interface straight out of a SPIR-V module, so
+ * descriptor set layouts, push constant ranges and dispatch sizes follow
+ * the GLSL instead of being written out by hand next to it.
+ *
+ * Phase 5 Focus:
+ * - New kernels need no layout boilerplate
+ * - Layouts can never drift out of sync with the shaders
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * @struct ReflectedBinding
+ * @brief One descriptor binding used by a shader
+ */
+struct ReflectedBinding {
+  uint32_t set;                    ///< Descriptor set index
+  uint32_t binding;                ///< Binding number within the set
+  VkDescriptorType descriptorType; ///< Kind of descriptor
+  uint32_t descriptorCount;        ///< Array size (1 for non-arrays)
+  VkShaderStageFlags stageFlags;   ///< Stages that use the binding
+};
+
+/**
+ * @struct ShaderReflection
+ * @brief Resource interface of one shader or a merged set of shaders
+ */
+struct ShaderReflection {
+  std::vector<ReflectedBinding> bindings; ///< Sorted by set, then binding
+  uint32_t pushConstantSize = 0;          ///< Bytes, 0 if none
+  VkShaderStageFlags pushConstantStages = 0; ///< Stages reading them
+  uint32_t localSize[3] = {1, 1, 1};         ///< Compute workgroup size
+
+  /**
+   * @brief Reflect a SPIR-V module
+   *
+   * @param spirvCode SPIR-V words
+   * @param stage Stage the module is used for
+   * @return Reflected interface
+   *
+   * @throws std::runtime_error If the module is malformed
+   */
+  static ShaderReflection reflect(const std::vector<uint32_t> &spirvCode,
+                                  VkShaderStageFlagBits stage);
+
+  /**
+   * @brief Add another shader's interface to this one
+   *
+   * Bindings are united and their stage flags combined; push constants
+   * become one range covering both. The workgroup size is kept.
+   *
+   * @param other Interface to add
+   *
+   * @throws std::runtime_error If both use a binding with different types
+   */
+  void merge(const ShaderReflection &other);
+
+  /**
+   * @brief Check that every binding of a shader exists in this interface
+   *
+   * @param other Interface of the shader
+   * @return true if a layout built from this one fits the shader
+   */
+  bool covers(const ShaderReflection &other) const;
+
+  /**
+   * @brief Get the number of descriptor sets (highest set index + 1)
+   *
+   * @return Set count, 0 without bindings
+   */
+  uint32_t getSetCount() const;
+
+  /**
+   * @brief Get the layout bindings of one descriptor set
+   *
+   * @param set Descriptor set index
+   * @return Bindings ready for VkDescriptorSetLayoutCreateInfo
+   */
+  std::vector<VkDescriptorSetLayoutBinding> getSetBindings(uint32_t set) const;
+
+  /**
+   * @brief Get the push constant ranges for a pipeline layout
+   *
+   * @return Zero or one range starting at offset 0
+   */
+  std::vector<VkPushConstantRange> getPushConstantRanges() const;
+
+  /**
+   * @brief Get descriptor pool sizes for a number of sets of every layout
+   *
+   * @param setCount How many times each descriptor set is allocated
+   * @return One entry per descriptor type
+   */
+  std::vector<VkDescriptorPoolSize> getPoolSizes(uint32_t setCount) const;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Coverage:
+ *    - Uniform and storage buffers (Block and legacy BufferBlock), images,
+ *      samplers, combined image samplers, texel buffers and input
+ *      attachments, including fixed-size descriptor arrays
+ *    - Push constant size is the end of the last member, using Offset,
+ *      ArrayStride and MatrixStride decorations
+ *    - LocalSize and LocalSizeId execution modes
+ *
+ * 2. Limits:
+ *    - Runtime descriptor arrays are reported with a count of 1
+ *    - Every declared resource counts, used or not; the optimizer already
+ *      strips unused ones from release SPIR-V
+ */
@@ -0,0 +1,175 @@
+/**
+ * @file ShaderWatcher.cpp
+ * @brief Implementation of event-driven shader file watching
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "ShaderWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// A batch is delivered after this long without events...
+constexpr auto DEBOUNCE_QUIET = std::chrono::milliseconds(20);
+
+// ...or this long after its first event, whichever comes first
+constexpr auto DEBOUNCE_MAX_DELAY = std::chrono::milliseconds(60);
+
+} // namespace
+
+#ifdef __linux__
+
+ShaderWatcher::ShaderWatcher(Callback callback)
+    : m_callback(std::move(callback)), m_inotifyFd(-1), m_wakeFd(-1) {
+  m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_inotifyFd < 0) {
+    std::cerr << "[ShaderWatcher] inotify unavailable, falling back to "
+              << "polling" << std::endl;
+    return;
+  }
+
+  m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_wakeFd < 0) {
+    close(m_inotifyFd);
+    m_inotifyFd = -1;
+    std::cerr << "[ShaderWatcher] eventfd unavailable, falling back to "
+              << "polling" << std::endl;
+    return;
+  }
+
+  m_thread = std::thread(&ShaderWatcher::threadLoop, this);
+}
+
+ShaderWatcher::~ShaderWatcher() {
+  if (m_thread.joinable()) {
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = write(m_wakeFd, &one, sizeof(one));
+    m_thread.join();
+  }
+  if (m_wakeFd >= 0) {
+    close(m_wakeFd);
+  }
+  if (m_inotifyFd >= 0) {
+    close(m_inotifyFd);
+  }
+}
+
+bool ShaderWatcher::watchDirectory(const std::string &directory) {
+  if (m_inotifyFd < 0) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_watches.count(directory) > 0) {
+    return true;
+  }
+
+  int wd = inotify_add_watch(m_inotifyFd,
+                             directory.empty() ? "." : directory.c_str(),
+                             IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (wd < 0) {
+    std::cerr << "[ShaderWatcher] Cannot watch '" << directory
+              << "': errno " << errno << std::endl;
+    return false;
+  }
+
+  m_watches[directory] = wd;
+  m_directories[wd] = directory;
+  std::cout << "[ShaderWatcher] Watching '"
+            << (directory.empty() ? "." : directory) << "'" << std::endl;
+  return true;
+}
+
+void ShaderWatcher::threadLoop() {
+  using Clock = std::chrono::steady_clock;
+
+  // inotify_event is variable-length; align the buffer for its header
+  alignas(inotify_event) char buffer[4096];
+  std::set<std::string> pending;
+  Clock::time_point firstEvent;
+  Clock::time_point lastEvent;
+
+  while (true) {
+    int timeout = -1;
+    if (!pending.empty()) {
+      auto deadline = std::min(lastEvent + DEBOUNCE_QUIET,
+                               firstEvent + DEBOUNCE_MAX_DELAY);
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+          deadline - Clock::now());
+      timeout = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+    }
+
+    pollfd fds[2] = {{m_inotifyFd, POLLIN, 0}, {m_wakeFd, POLLIN, 0}};
+    int ready = poll(fds, 2, timeout);
+    if (ready < 0 && errno != EINTR) {
+      std::cerr << "[ShaderWatcher] poll failed: errno " << errno
+                << std::endl;
+      return;
+    }
+    if (fds[1].revents & POLLIN) {
+      return;
+    }
+
+    if (fds[0].revents & POLLIN) {
+      bool batchStarted = pending.empty();
+      ssize_t length;
+      while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (char *ptr = buffer; ptr < buffer + length;) {
+          const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+          ptr += sizeof(inotify_event) + event->len;
+
+          auto it = m_directories.find(event->wd);
+          if (event->len == 0 || it == m_directories.end()) {
+            continue;
+          }
+          std::string name(event->name);
+          pending.insert(it->second.empty() ? name : it->second + "/" + name);
+        }
+      }
+
+      if (!pending.empty()) {
+        lastEvent = Clock::now();
+        if (batchStarted) {
+          firstEvent = lastEvent;
+        }
+      }
+    }
+
+    if (!pending.empty() &&
+        Clock::now() >= std::min(lastEvent + DEBOUNCE_QUIET,
+                                 firstEvent + DEBOUNCE_MAX_DELAY)) {
+      m_callback(std::vector<std::string>(pending.begin(), pending.end()));
+      pending.clear();
+    }
+  }
+}
+
+#else
+
+ShaderWatcher::ShaderWatcher(Callback callback)
+    : m_callback(std::move(callback)), m_inotifyFd(-1), m_wakeFd(-1) {}
+
+ShaderWatcher::~ShaderWatcher() = default;
+
+bool ShaderWatcher::watchDirectory(const std::string & /*directory*/) {
+  return false;
+}
+
+void ShaderWatcher::threadLoop() {}
+
+#endif
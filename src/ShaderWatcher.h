@@ -0,0 +1,114 @@
+/**
+ * @file ShaderWatcher.h
+ * @brief Event-driven file watching for shader hot-reload
+ *
+ * This class watches shader directories with inotify on a background
+ * thread and reports batches of changed files. Editors often write a file
+ * several times per save (truncate, write, rename, chmod), so events are
+ * debounced into one batch per save.
+ *
+ * Phase 5 Focus:
+ * - No per-frame stat() calls for hot-reload
+ * - Save-to-recompile latency well under 100 ms
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ShaderWatcher
+ * @brief Reports files written in watched directories
+ *
+ * Directories rather than files are watched, so saves that replace a file
+ * by renaming a temporary over it are seen as well. Only available on
+ * Linux; elsewhere isSupported() is false and callers fall back to
+ * polling modification times.
+ */
+class ShaderWatcher {
+public:
+  /**
+   * @brief Called on the watcher thread with the files of one batch
+   *
+   * Paths are the watched directory as given, "/", then the file name.
+   */
+  using Callback = std::function<void(const std::vector<std::string> &)>;
+
+  /**
+   * @brief Constructor - start the watcher thread
+   *
+   * @param callback Receives each debounced batch of changed files
+   */
+  explicit ShaderWatcher(Callback callback);
+
+  /**
+   * @brief Destructor - stop and join the watcher thread
+   *
+   * No callback runs after the destructor returns.
+   */
+  ~ShaderWatcher();
+
+  // Disable copy and move for simplicity
+  ShaderWatcher(const ShaderWatcher &) = delete;
+  ShaderWatcher &operator=(const ShaderWatcher &) = delete;
+  ShaderWatcher(ShaderWatcher &&) = delete;
+  ShaderWatcher &operator=(ShaderWatcher &&) = delete;
+
+  /**
+   * @brief Check whether file events are available on this platform
+   *
+   * @return true if the watcher thread is running
+   */
+  bool isSupported() const { return m_inotifyFd >= 0; }
+
+  /**
+   * @brief Watch a directory for written or replaced files
+   *
+   * Watching the same directory twice is a no-op.
+   *
+   * @param directory Directory path; empty means the working directory
+   * @return true if the directory is being watched
+   */
+  bool watchDirectory(const std::string &directory);
+
+private:
+  /**
+   * @brief Read events and deliver debounced batches until stopped
+   */
+  void threadLoop();
+
+  Callback m_callback; ///< Batch receiver
+
+  int m_inotifyFd; ///< inotify instance, -1 if unsupported
+  int m_wakeFd;    ///< eventfd that stops the thread
+
+  std::mutex m_mutex; ///< Guards the watch maps
+  std::unordered_map<int, std::string>
+      m_directories; ///< Watch descriptor -> directory as given
+  std::unordered_map<std::string, int>
+      m_watches; ///< Directory as given -> watch descriptor
+
+  std::thread m_thread; ///< Watcher thread
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Debouncing:
+ *    - A batch is delivered once no event has arrived for a short quiet
+ *      period, or at the latest a fixed time after its first event, so a
+ *      continuous stream of writes cannot postpone a reload forever
+ *
+ * 2. Events:
+ *    - IN_CLOSE_WRITE covers in-place saves and IN_MOVED_TO covers
+ *      rename-over saves; partial writes are never reported
+ */
@@ -0,0 +1,179 @@
+/**
+ * @file StagingRing.cpp
+ * @brief Implementation of the persistently mapped staging ring
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#include "StagingRing.h"
+#include "MemoryManager.h"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+StagingRing::StagingRing(VkDevice device, MemoryManager &memoryManager,
+                         const std::string &name, VkDeviceSize capacity,
+                         VkMemoryPropertyFlags memoryProperties)
+    : m_device(device), m_memoryManager(memoryManager), m_name(name),
+      m_capacity(capacity), m_head(0), m_tail(0), m_openBatchUsed(false),
+      m_closedBatches(0), m_retiredBatches(0) {
+  m_buffer = m_memoryManager.createBufferExplicit(
+      m_name, capacity,
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      memoryProperties, true);
+
+  std::cout << "[StagingRing] Created " << (capacity / (1024 * 1024))
+            << " MB ring '" << m_name << "'" << std::endl;
+}
+
+StagingRing::~StagingRing() {
+  // Regions may still be read by the GPU; callbacks are dropped at shutdown
+  for (const Batch &batch : m_inFlight) {
+    vkWaitForFences(m_device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    vkDestroyFence(m_device, batch.fence, nullptr);
+  }
+  for (VkFence fence : m_freeFences) {
+    vkDestroyFence(m_device, fence, nullptr);
+  }
+  m_memoryManager.removeBuffer(m_buffer->handle);
+}
+
+StagingRegion StagingRing::allocate(VkDeviceSize size,
+                                    VkDeviceSize alignment) {
+  if (size == 0 || size > m_capacity) {
+    throw std::runtime_error("Staging request of " + std::to_string(size) +
+                             " bytes does not fit the staging ring");
+  }
+
+  VkDeviceSize offset = 0;
+  retireCompleted();
+  while (!tryAllocate(size, alignment, offset)) {
+    if (m_inFlight.empty()) {
+      throw std::runtime_error(
+          "Staging ring exhausted by the open batch; end the batch first");
+    }
+
+    // Full: wait for the oldest submission only, never the whole queue
+    vkWaitForFences(m_device, 1, &m_inFlight.front().fence, VK_TRUE,
+                    UINT64_MAX);
+    retireOldest();
+  }
+
+  m_openBatchUsed = true;
+
+  StagingRegion region;
+  region.buffer = m_buffer->buffer;
+  region.offset = offset;
+  region.size = size;
+  region.data = static_cast<uint8_t *>(m_buffer->mappedData) + offset;
+  return region;
+}
+
+void StagingRing::onBatchComplete(CompletionCallback callback) {
+  m_openCallbacks.push_back(std::move(callback));
+}
+
+VkFence StagingRing::endBatch() {
+  Batch batch;
+  batch.fence = acquireFence();
+  batch.endOffset = m_head;
+  batch.callbacks = std::move(m_openCallbacks);
+  m_openCallbacks.clear();
+  m_inFlight.push_back(std::move(batch));
+  m_openBatchUsed = false;
+  m_closedBatches++;
+  return m_inFlight.back().fence;
+}
+
+void StagingRing::retireCompleted() {
+  while (!m_inFlight.empty() &&
+         vkGetFenceStatus(m_device, m_inFlight.front().fence) == VK_SUCCESS) {
+    retireOldest();
+  }
+}
+
+void StagingRing::waitIdle() {
+  while (!m_inFlight.empty()) {
+    vkWaitForFences(m_device, 1, &m_inFlight.front().fence, VK_TRUE,
+                    UINT64_MAX);
+    retireOldest();
+  }
+}
+
+bool StagingRing::tryAllocate(VkDeviceSize size, VkDeviceSize alignment,
+                              VkDeviceSize &offset) {
+  VkDeviceSize aligned = alignUp(m_head, alignment);
+
+  if (m_head >= m_tail) {
+    // Used bytes are [tail, head): take the end, or wrap to the start. The
+    // wrapped region must stay strictly below the tail so that head == tail
+    // always means "empty".
+    if (aligned + size <= m_capacity) {
+      offset = aligned;
+    } else if (size < m_tail) {
+      offset = 0;
+    } else {
+      return false;
+    }
+  } else {
+    // Wrapped: the free gap is [head, tail)
+    if (aligned + size >= m_tail) {
+      return false;
+    }
+    offset = aligned;
+  }
+
+  m_head = offset + size;
+  return true;
+}
+
+void StagingRing::retireOldest() {
+  Batch batch = std::move(m_inFlight.front());
+  m_inFlight.pop_front();
+  m_retiredBatches++;
+
+  // Readback callbacks still read their regions, so release them afterwards
+  for (auto &callback : batch.callbacks) {
+    callback();
+  }
+
+  m_tail = batch.endOffset;
+  if (m_inFlight.empty() && !m_openBatchUsed) {
+    m_head = 0;
+    m_tail = 0;
+  }
+
+  vkResetFences(m_device, 1, &batch.fence);
+  m_freeFences.push_back(batch.fence);
+}
+
+VkFence StagingRing::acquireFence() {
+  if (!m_freeFences.empty()) {
+    VkFence fence = m_freeFences.back();
+    m_freeFences.pop_back();
+    return fence;
+  }
+
+  VkFenceCreateInfo fenceInfo{};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  VkFence fence;
+  VkResult result = vkCreateFence(m_device, &fenceInfo, nullptr, &fence);
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error("Failed to create staging fence! Vulkan error: " +
+                             std::to_string(result));
+  }
+  return fence;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file StagingRing.h
+ * @brief Persistently mapped staging ring for uploads and readbacks
+ *
+ * This class owns one host-visible buffer that is used as a ring: every
+ * transfer takes the next free region, the copy is recorded and submitted,
+ * and the region is handed back once the fence of its submission signals.
+ * Nothing ever waits for the queue to go idle.
+ *
+ * Phase 5 Focus:
+ * - No per-transfer buffer creation or allocation
+ * - No vkQueueWaitIdle on uploads or readbacks
+ * - Completion callbacks for readbacks
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+// Forward declarations
+class MemoryManager;
+struct BufferInfo;
+
+/**
+ * @struct StagingRegion
+ * @brief A slice of the staging ring
+ */
+struct StagingRegion {
+  VkBuffer buffer = VK_NULL_HANDLE; ///< Ring buffer (copy source/destination)
+  VkDeviceSize offset = 0;          ///< Offset of the slice in the buffer
+  VkDeviceSize size = 0;            ///< Size of the slice in bytes
+  void *data = nullptr;             ///< Host pointer to the slice
+};
+
+/**
+ * @class StagingRing
+ * @brief Fence-tracked ring allocator over one mapped staging buffer
+ *
+ * Regions are grouped into batches. allocate() adds regions to the open
+ * batch; endBatch() closes it and returns the fence that the caller passes
+ * to vkQueueSubmit. retireCompleted() polls the fences in submission order,
+ * runs the batches' completion callbacks and frees their regions. When the
+ * ring is full, allocate() waits for the oldest batch only.
+ *
+ * Not thread-safe: use it from the thread that submits transfers.
+ */
+class StagingRing {
+public:
+  /**
+   * @brief Callback run once a batch's fence has signalled
+   */
+  using CompletionCallback = std::function<void()>;
+
+  /**
+   * @brief Constructor - create and map the ring buffer
+   *
+   * @param device Vulkan logical device
+   * @param memoryManager Memory manager that owns the ring buffer
+   * @param name Name of the ring buffer in the memory manager
+   * @param capacity Size of the ring in bytes
+   * @param memoryProperties Host-visible memory properties of the ring
+   *
+   * @throws std::runtime_error If the buffer cannot be created
+   */
+  StagingRing(VkDevice device, MemoryManager &memoryManager,
+              const std::string &name, VkDeviceSize capacity,
+              VkMemoryPropertyFlags memoryProperties);
+
+  /**
+   * @brief Destructor - wait for in-flight batches and release resources
+   */
+  ~StagingRing();
+
+  // Disable copy and move for simplicity
+  StagingRing(const StagingRing &) = delete;
+  StagingRing &operator=(const StagingRing &) = delete;
+  StagingRing(StagingRing &&) = delete;
+  StagingRing &operator=(StagingRing &&) = delete;
+
+  /**
+   * @brief Take a region from the ring for the open batch
+   *
+   * @param size Size of the region in bytes (at most getCapacity())
+   * @param alignment Required offset alignment
+   * @return Region to fill (uploads) or copy into (readbacks)
+   *
+   * @throws std::runtime_error If the request can never fit, or the open
+   *         batch alone already fills the ring
+   */
+  StagingRegion allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+  /**
+   * @brief Register a callback for when the open batch completes
+   *
+   * The batch's regions stay valid while the callback runs. Callbacks must
+   * not allocate from or retire the ring themselves.
+   *
+   * @param callback Function run from retireCompleted() after the fence
+   */
+  void onBatchComplete(CompletionCallback callback);
+
+  /**
+   * @brief Close the open batch
+   *
+   * The returned fence is unsignalled and must be passed to the
+   * vkQueueSubmit that executes the batch's copies.
+   *
+   * @return Fence that retires the batch
+   */
+  VkFence endBatch();
+
+  /**
+   * @brief Retire every batch whose fence has signalled
+   *
+   * Runs completion callbacks and frees the batches' regions. Cheap; call
+   * it once per frame.
+   */
+  void retireCompleted();
+
+  /**
+   * @brief Block until every submitted batch has completed, then retire them
+   */
+  void waitIdle();
+
+  /**
+   * @brief Get the size of the ring
+   * @return Capacity in bytes
+   */
+  VkDeviceSize getCapacity() const { return m_capacity; }
+
+  /**
+   * @brief Get the ring buffer
+   * @return Buffer backing every region
+   */
+  std::shared_ptr<BufferInfo> getBuffer() const { return m_buffer; }
+
+  /**
+   * @brief Get the number of submitted batches that have not retired yet
+   * @return In-flight batch count
+   */
+  size_t getInFlightBatchCount() const { return m_inFlight.size(); }
+
+  /**
+   * @brief Get the number of the latest batch closed by endBatch()
+   *
+   * Batches are numbered from 1 in submission order; 0 means none yet.
+   * Fences are pooled and reused, so this number, not the fence, is what
+   * identifies a batch later.
+   *
+   * @return Batch number to pass to isBatchRetired()
+   */
+  uint64_t getLastBatch() const { return m_closedBatches; }
+
+  /**
+   * @brief Check whether a batch has been retired
+   *
+   * Only reflects the last retireCompleted() (or allocation); it does not
+   * poll fences itself.
+   *
+   * @param batch Number from getLastBatch()
+   * @return true once the batch's fence signalled and it was retired
+   */
+  bool isBatchRetired(uint64_t batch) const {
+    return batch <= m_retiredBatches;
+  }
+
+private:
+  /**
+   * @struct Batch
+   * @brief Submitted regions that retire together
+   */
+  struct Batch {
+    VkFence fence;
+    VkDeviceSize endOffset; ///< Ring head when the batch was closed
+    std::vector<CompletionCallback> callbacks;
+  };
+
+  /**
+   * @brief Try to place a region without waiting
+   *
+   * @return true and the offset if the ring had room
+   */
+  bool tryAllocate(VkDeviceSize size, VkDeviceSize alignment,
+                   VkDeviceSize &offset);
+
+  /**
+   * @brief Retire the oldest in-flight batch
+   */
+  void retireOldest();
+
+  /**
+   * @brief Get an unsignalled fence from the pool
+   */
+  VkFence acquireFence();
+
+  VkDevice m_device;
+  MemoryManager &m_memoryManager;
+  std::string m_name;
+  std::shared_ptr<BufferInfo> m_buffer;
+  VkDeviceSize m_capacity;
+
+  // Ring state: used bytes run from m_tail to m_head (wrapping)
+  VkDeviceSize m_head;
+  VkDeviceSize m_tail;
+  bool m_openBatchUsed; ///< Open batch holds at least one region
+
+  std::vector<CompletionCallback> m_openCallbacks;
+  std::deque<Batch> m_inFlight;
+  std::vector<VkFence> m_freeFences;
+  uint64_t m_closedBatches;  ///< Batches closed by endBatch()
+  uint64_t m_retiredBatches; ///< Batches retired, in submission order
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Ordering:
+ *    - Batches retire in submission order, so the tail only ever moves
+ *      forward; a batch whose fence signals early waits for older ones
+ *
+ * 2. Oversized Transfers:
+ *    - Callers split transfers larger than the ring into chunks; each chunk
+ *      goes into its own batch so earlier chunks can retire while later
+ *      ones are still being written
+ *
+ * 3. Memory:
+ *    - Upload rings are host-visible and coherent, so writes need no flush
+ *    - Readback rings prefer host-cached memory, which may not be coherent;
+ *      their users invalidate a region before reading it
+ */
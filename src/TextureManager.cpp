@@ -2,8 +2,8 @@
  * @file TextureManager.cpp
  * @brief Implementation of texture management for fractal visualization
  *
- * This file implements texture creation, buffer-to-texture copying,
- * and image layout transitions for displaying computed fractal data.
+ * This file implements texture creation and buffer-to-texture copying
+ * for displaying computed fractal data.
  *
  * @author Fractal Generator Project
  * @date July 4, 2025
@@ -13,6 +13,7 @@
 #include "TextureManager.h"
 #include "MemoryManager.h"
 
+#include <algorithm>
 #include <iostream>
 
 /**
@@ -44,48 +45,22 @@ bool TextureManager::createFractalTexture(uint32_t width, uint32_t height,
   std::cout << "TextureManager: Creating fractal texture (" << width << "x"
             << height << ")..." << std::endl;
 
-  // Store texture properties
-  m_textureWidth = width;
-  m_textureHeight = height;
-  m_textureFormat = format;
-
-  // Create the texture image using MemoryManager utilities - Phase 3
-  // integration
-  VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
-  VkImageUsageFlags usage =
-      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-  VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-  bool success =
-      m_memoryManager->createImage(width, height, format, tiling, usage,
-                                   properties, m_textureImage, m_textureMemory);
-
-  if (!success) {
-    std::cerr
-        << "TextureManager: Failed to create texture image using MemoryManager!"
-        << std::endl;
-    return false;
+  if (m_textureImage != VK_NULL_HANDLE ||
+      m_textureSampler != VK_NULL_HANDLE) {
+    retireTexture();
   }
 
-  // Create image view using MemoryManager utilities
-  m_textureImageView = m_memoryManager->createImageView(
-      m_textureImage, format, VK_IMAGE_ASPECT_COLOR_BIT);
+  // Store texture properties
+  m_textureFormat = format;
 
-  if (m_textureImageView == VK_NULL_HANDLE) {
-    std::cerr << "TextureManager: Failed to create texture image view!"
-              << std::endl;
-    vkFreeMemory(m_device, m_textureMemory, nullptr);
-    vkDestroyImage(m_device, m_textureImage, nullptr);
-    m_textureImage = VK_NULL_HANDLE;
-    m_textureMemory = VK_NULL_HANDLE;
+  if (!createTextureImage(width, height)) {
     return false;
   }
 
   // Create texture sampler
   if (!createTextureSampler()) {
     vkDestroyImageView(m_device, m_textureImageView, nullptr);
-    vkFreeMemory(m_device, m_textureMemory, nullptr);
-    vkDestroyImage(m_device, m_textureImage, nullptr);
+    m_memoryManager->destroyImage(m_textureImage);
     m_textureImage = VK_NULL_HANDLE;
     m_textureMemory = VK_NULL_HANDLE;
     m_textureImageView = VK_NULL_HANDLE;
@@ -98,12 +73,35 @@ bool TextureManager::createFractalTexture(uint32_t width, uint32_t height,
   return true;
 }
 
+/**
+ * @brief Replace the texture image with one of a new size
+ */
+bool TextureManager::resizeFractalTexture(uint32_t width, uint32_t height) {
+  if (m_textureReady && width == m_textureWidth && height == m_textureHeight) {
+    return true;
+  }
+  if (m_textureSampler == VK_NULL_HANDLE) {
+    return createFractalTexture(width, height, m_textureFormat);
+  }
+
+  // Frames in flight may still sample the old image
+  retireTextureImage();
+  if (!createTextureImage(width, height)) {
+    return false;
+  }
+
+  m_textureReady = true;
+  std::cout << "TextureManager: Resized fractal texture to " << width << "x"
+            << height << std::endl;
+  return true;
+}
+
 /**
  * @brief Copy data from compute buffer to texture
  */
 void TextureManager::copyBufferToTexture(VkCommandBuffer commandBuffer,
                                          VkBuffer sourceBuffer,
-                                         VkDeviceSize bufferSize) {
+                                         uint32_t width, uint32_t height) {
   // Copy buffer to image
   VkBufferImageCopy region{};
   region.bufferOffset = 0;
@@ -114,15 +112,11 @@ void TextureManager::copyBufferToTexture(VkCommandBuffer commandBuffer,
   region.imageSubresource.baseArrayLayer = 0;
   region.imageSubresource.layerCount = 1;
   region.imageOffset = {0, 0, 0};
-  region.imageExtent = {m_textureWidth, m_textureHeight, 1};
+  region.imageExtent = {std::min(width, m_textureWidth),
+                        std::min(height, m_textureHeight), 1};
 
   vkCmdCopyBufferToImage(commandBuffer, sourceBuffer, m_textureImage,
                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-  // Transition texture to shader read-only layout using MemoryManager utility
-  m_memoryManager->transitionImageLayout(
-      m_textureImage, m_textureFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, commandBuffer);
 }
 
 /**
@@ -158,6 +152,82 @@ bool TextureManager::createTextureSampler() {
   return true;
 }
 
+/**
+ * @brief Create the texture image and view
+ */
+bool TextureManager::createTextureImage(uint32_t width, uint32_t height) {
+  m_textureWidth = width;
+  m_textureHeight = height;
+
+  // Create the texture image using MemoryManager utilities - Phase 3
+  // integration
+  VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
+  VkImageUsageFlags usage =
+      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+  VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+  bool success = m_memoryManager->createImage(width, height, m_textureFormat,
+                                              tiling, usage, properties,
+                                              m_textureImage, m_textureMemory);
+
+  if (!success) {
+    std::cerr
+        << "TextureManager: Failed to create texture image using MemoryManager!"
+        << std::endl;
+    return false;
+  }
+
+  // Create image view using MemoryManager utilities
+  m_textureImageView = m_memoryManager->createImageView(
+      m_textureImage, m_textureFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+
+  if (m_textureImageView == VK_NULL_HANDLE) {
+    std::cerr << "TextureManager: Failed to create texture image view!"
+              << std::endl;
+    m_memoryManager->destroyImage(m_textureImage);
+    m_textureImage = VK_NULL_HANDLE;
+    m_textureMemory = VK_NULL_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Queue texture resources for deferred destruction
+ */
+void TextureManager::retireTexture() {
+  VkDevice device = m_device;
+  VkSampler sampler = m_textureSampler;
+  if (sampler != VK_NULL_HANDLE) {
+    m_memoryManager->getDeletionQueue().enqueue(
+        [device, sampler]() { vkDestroySampler(device, sampler, nullptr); });
+  }
+  m_textureSampler = VK_NULL_HANDLE;
+
+  retireTextureImage();
+}
+
+/**
+ * @brief Queue the texture image and view for deferred destruction
+ */
+void TextureManager::retireTextureImage() {
+  // Deleters run in order, so the view goes before its image
+  VkDevice device = m_device;
+  VkImageView imageView = m_textureImageView;
+  if (imageView != VK_NULL_HANDLE) {
+    m_memoryManager->getDeletionQueue().enqueue([device, imageView]() {
+      vkDestroyImageView(device, imageView, nullptr);
+    });
+  }
+  m_memoryManager->destroyImageDeferred(m_textureImage);
+
+  m_textureImageView = VK_NULL_HANDLE;
+  m_textureImage = VK_NULL_HANDLE;
+  m_textureMemory = VK_NULL_HANDLE;
+  m_textureReady = false;
+}
+
 /**
  * @brief Cleanup texture resources
  */
@@ -172,14 +242,11 @@ void TextureManager::cleanupTexture() {
     m_textureImageView = VK_NULL_HANDLE;
   }
 
-  if (m_textureMemory != VK_NULL_HANDLE) {
-    vkFreeMemory(m_device, m_textureMemory, nullptr);
-    m_textureMemory = VK_NULL_HANDLE;
-  }
-
+  // The image's memory is a sub-allocation owned by the memory manager
   if (m_textureImage != VK_NULL_HANDLE) {
-    vkDestroyImage(m_device, m_textureImage, nullptr);
+    m_memoryManager->destroyImage(m_textureImage);
     m_textureImage = VK_NULL_HANDLE;
+    m_textureMemory = VK_NULL_HANDLE;
   }
 
   m_textureReady = false;
@@ -7,7 +7,6 @@
  *
  * Phase 4 Focus:
  * - Compute buffer to texture conversion
- * - Image layout transitions
  * - Texture sampling setup for graphics pipeline
  *
  * @author Fractal Generator Project
@@ -27,9 +26,9 @@ class MemoryManager;
  * @class TextureManager
  * @brief Manages texture creation and compute buffer to texture transfers
  *
- * This class provides utilities for creating textures from compute buffer data,
- * handling image layout transitions, and setting up texture sampling for
- * the graphics pipeline.
+ * This class provides utilities for creating textures from compute buffer data
+ * and setting up texture sampling for the graphics pipeline. Layout
+ * transitions of the texture are derived by the frame graph.
  */
 class TextureManager {
 public:
@@ -56,7 +55,9 @@ public:
    * @brief Create a texture for fractal data
    *
    * Creates a 2D texture suitable for storing computed fractal data
-   * and sampling in the graphics pipeline.
+   * and sampling in the graphics pipeline. A previous texture is handed to
+   * the deletion queue, so this may be called while frames sampling it are
+   * still in flight.
    *
    * @param width Width of the texture
    * @param height Height of the texture
@@ -65,18 +66,34 @@ public:
    */
   bool createFractalTexture(uint32_t width, uint32_t height, VkFormat format);
 
+  /**
+   * @brief Replace the texture image with one of a new size
+   *
+   * Keeps the format and sampler; the old image and view go to the deletion
+   * queue. Callers must rebind the new image view.
+   *
+   * @param width New width of the texture
+   * @param height New height of the texture
+   * @return true if successful; on failure the texture is not ready
+   */
+  bool resizeFractalTexture(uint32_t width, uint32_t height);
+
   /**
    * @brief Copy data from compute buffer to texture
    *
    * Performs a buffer-to-image copy operation to transfer computed
-   * fractal data from the compute buffer to the texture.
+   * fractal data from the compute buffer to the texture. The buffer holds
+   * a tightly packed width x height image that lands in the top-left corner
+   * of the texture, which must already be in TRANSFER_DST_OPTIMAL layout
+   * (the frame graph's copy pass transitions it).
    *
    * @param commandBuffer Command buffer to record copy commands
    * @param sourceBuffer Source buffer containing fractal data
-   * @param bufferSize Size of the source buffer in bytes
+   * @param width Width of the packed image, clamped to the texture
+   * @param height Height of the packed image, clamped to the texture
    */
   void copyBufferToTexture(VkCommandBuffer commandBuffer, VkBuffer sourceBuffer,
-                           VkDeviceSize bufferSize);
+                           uint32_t width, uint32_t height);
 
   /**
    * @brief Get the texture image view for binding
@@ -121,11 +138,30 @@ private:
    */
   bool createTextureSampler();
 
+  /**
+   * @brief Create the texture image and view at the given size
+   *
+   * @return true if successful, false otherwise (nothing is left behind)
+   */
+  bool createTextureImage(uint32_t width, uint32_t height);
+
   /**
    * @brief Cleanup texture resources
    */
   void cleanupTexture();
 
+  /**
+   * @brief Queue the current texture for destruction once in-flight frames
+   *        retire, and forget it
+   */
+  void retireTexture();
+
+  /**
+   * @brief Queue the current image and view (not the sampler) for deferred
+   *        destruction, and forget them
+   */
+  void retireTextureImage();
+
   // Vulkan objects
   VkDevice m_device;
   VkPhysicalDevice m_physicalDevice;
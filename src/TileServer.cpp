@@ -0,0 +1,250 @@
+/**
+ * @file TileServer.cpp
+ * @brief Implementation of the loopback HTTP tile server
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#include "TileServer.h"
+#include "TileStore.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+constexpr int ACCEPT_POLL_MS = 250;
+constexpr int CLIENT_TIMEOUT_SEC = 5;
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+} // namespace
+
+TileServer::TileServer(std::shared_ptr<TileStore> tileStore, uint16_t port,
+                       uint32_t workerCount)
+    : m_tileStore(tileStore), m_port(port),
+      m_workerCount(workerCount > 0 ? workerCount : 1), m_listenFd(-1),
+      m_running(false) {}
+
+TileServer::~TileServer() { stop(); }
+
+bool TileServer::start() {
+  if (m_running) {
+    return true;
+  }
+
+  m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (m_listenFd < 0) {
+    std::cerr << "[TileServer] Failed to create socket: "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  int reuse = 1;
+  setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(m_port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (bind(m_listenFd, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address)) != 0 ||
+      listen(m_listenFd, static_cast<int>(m_workerCount) * 4) != 0) {
+    std::cerr << "[TileServer] Failed to listen on 127.0.0.1:" << m_port
+              << ": " << std::strerror(errno) << std::endl;
+    close(m_listenFd);
+    m_listenFd = -1;
+    return false;
+  }
+
+  // Non-blocking so a worker that loses the accept race doesn't block
+  fcntl(m_listenFd, F_SETFL, fcntl(m_listenFd, F_GETFL, 0) | O_NONBLOCK);
+
+  m_running = true;
+  for (uint32_t i = 0; i < m_workerCount; i++) {
+    m_workers.emplace_back(&TileServer::workerLoop, this);
+  }
+
+  std::cout << "[TileServer] Serving tiles on http://127.0.0.1:" << m_port
+            << "/tiles/{level}/{x}/{y}.rgba with " << m_workerCount
+            << " workers" << std::endl;
+  return true;
+}
+
+void TileServer::stop() {
+  if (!m_running.exchange(false)) {
+    return;
+  }
+
+  // Workers poll with a timeout, so they notice m_running within one tick
+  for (auto &worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  m_workers.clear();
+
+  if (m_listenFd >= 0) {
+    close(m_listenFd);
+    m_listenFd = -1;
+  }
+
+  std::cout << "[TileServer] Stopped" << std::endl;
+}
+
+void TileServer::workerLoop() {
+  while (m_running) {
+    pollfd pfd{};
+    pfd.fd = m_listenFd;
+    pfd.events = POLLIN;
+
+    int ready = poll(&pfd, 1, ACCEPT_POLL_MS);
+    if (ready <= 0) {
+      continue;
+    }
+
+    // Several workers may wake for one connection; losers just poll again
+    int clientFd = accept(m_listenFd, nullptr, nullptr);
+    if (clientFd < 0) {
+      continue;
+    }
+
+    // BSD sockets inherit O_NONBLOCK from the listener; we want blocking I/O
+    fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL, 0) & ~O_NONBLOCK);
+
+    timeval timeout{};
+    timeout.tv_sec = CLIENT_TIMEOUT_SEC;
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe,
+               sizeof(noSigPipe));
+#endif
+
+    handleConnection(clientFd);
+    close(clientFd);
+  }
+}
+
+void TileServer::handleConnection(int clientFd) {
+  // Read until the end of the request headers (we never expect a body)
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < MAX_REQUEST_BYTES) {
+    ssize_t received = recv(clientFd, buffer, sizeof(buffer), 0);
+    if (received <= 0) {
+      return;
+    }
+    request.append(buffer, static_cast<size_t>(received));
+  }
+
+  std::istringstream requestLine(request.substr(0, request.find("\r\n")));
+  std::string method, path;
+  requestLine >> method >> path;
+
+  if (method != "GET") {
+    const char message[] = "Only GET is supported\n";
+    sendResponse(clientFd, "405 Method Not Allowed", "text/plain", message,
+                 sizeof(message) - 1);
+    return;
+  }
+
+  if (path == "/info") {
+    std::ostringstream info;
+    info << "{\"tileSize\":" << m_tileStore->getTileSize()
+         << ",\"maxLevel\":" << TileStore::MAX_LEVEL
+         << ",\"format\":\"rgba8\",\"tiles\":" << m_tileStore->getTileCount()
+         << ",\"capacity\":" << m_tileStore->getCapacity() << "}\n";
+    std::string body = info.str();
+    sendResponse(clientFd, "200 OK", "application/json", body.data(),
+                 body.size());
+    return;
+  }
+
+  TileKey key{};
+  if (!parseTilePath(path, key) || !TileStore::isValidKey(key)) {
+    const char message[] = "Not found\n";
+    sendResponse(clientFd, "404 Not Found", "text/plain", message,
+                 sizeof(message) - 1);
+    return;
+  }
+
+  try {
+    TileView tile = m_tileStore->getTile(key);
+    std::string extra = "X-Tile-Size: " +
+                        std::to_string(m_tileStore->getTileSize()) + "\r\n" +
+                        "Cache-Control: public, max-age=31536000\r\n";
+    sendResponse(clientFd, "200 OK", "application/octet-stream", tile.data,
+                 tile.size, extra);
+  } catch (const std::exception &e) {
+    std::cerr << "[TileServer] Failed to render tile " << key.level << "/"
+              << key.x << "/" << key.y << ": " << e.what() << std::endl;
+    const char message[] = "Render failed\n";
+    sendResponse(clientFd, "500 Internal Server Error", "text/plain", message,
+                 sizeof(message) - 1);
+  }
+}
+
+bool TileServer::parseTilePath(const std::string &path, TileKey &key) {
+  unsigned int level = 0, x = 0, y = 0;
+  int consumed = 0;
+  if (std::sscanf(path.c_str(), "/tiles/%u/%u/%u.rgba%n", &level, &x, &y,
+                  &consumed) != 3 ||
+      static_cast<size_t>(consumed) != path.size()) {
+    return false;
+  }
+  key.level = level;
+  key.x = x;
+  key.y = y;
+  return true;
+}
+
+bool TileServer::sendResponse(int clientFd, const std::string &status,
+                              const std::string &contentType,
+                              const void *body, size_t bodySize,
+                              const std::string &extraHeaders) {
+  std::string headers = "HTTP/1.0 " + status + "\r\n" +
+                        "Content-Type: " + contentType + "\r\n" +
+                        "Content-Length: " + std::to_string(bodySize) +
+                        "\r\n" + extraHeaders + "Connection: close\r\n\r\n";
+  if (!sendAll(clientFd, headers.data(), headers.size())) {
+    return false;
+  }
+  return bodySize == 0 || sendAll(clientFd, body, bodySize);
+}
+
+bool TileServer::sendAll(int fd, const void *data, size_t size) {
+  const char *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t sent = send(fd, bytes, size, SEND_FLAGS);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += sent;
+    size -= static_cast<size_t>(sent);
+  }
+  return true;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file TileServer.h
+ * @brief Minimal local HTTP front end for the tile pyramid
+ *
+ * This class exposes a TileStore over HTTP/1.0 on the loopback interface so
+ * that a deep-zoom map client can fetch tiles by level and coordinate.
+ *
+ * Routes:
+ * - GET /tiles/{level}/{x}/{y}.rgba  Raw tile pixels (RGBA8, row-major)
+ * - GET /info                        Pyramid description as JSON
+ *
+ * Phase 5 Focus:
+ * - Loopback-only tile serving for the deep-zoom explorer
+ * - Fixed worker count (bounded threads and connections)
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Forward declarations
+class TileStore;
+struct TileKey;
+
+/**
+ * @class TileServer
+ * @brief Serves tiles from a TileStore over a loopback HTTP socket
+ *
+ * A fixed pool of worker threads shares one listening socket; each worker
+ * accepts, handles and closes a single connection at a time. Lazy renders
+ * therefore never block more than one worker, and the number of concurrent
+ * connections is bounded by the worker count.
+ */
+class TileServer {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param tileStore Store that tiles are served from
+   * @param port TCP port to listen on (loopback only)
+   * @param workerCount Number of connection worker threads
+   */
+  TileServer(std::shared_ptr<TileStore> tileStore, uint16_t port,
+             uint32_t workerCount = 4);
+
+  /**
+   * @brief Destructor - stops the server if it is running
+   */
+  ~TileServer();
+
+  // Disable copy and move for simplicity
+  TileServer(const TileServer &) = delete;
+  TileServer &operator=(const TileServer &) = delete;
+  TileServer(TileServer &&) = delete;
+  TileServer &operator=(TileServer &&) = delete;
+
+  /**
+   * @brief Bind the socket and start the worker threads
+   *
+   * @return true if the server is listening, false otherwise
+   */
+  bool start();
+
+  /**
+   * @brief Stop accepting connections and join the workers
+   */
+  void stop();
+
+  /**
+   * @brief Check if the server is running
+   * @return true if workers are accepting connections
+   */
+  bool isRunning() const { return m_running.load(); }
+
+  /**
+   * @brief Get the port the server listens on
+   * @return TCP port number
+   */
+  uint16_t getPort() const { return m_port; }
+
+private:
+  /**
+   * @brief Accept and handle connections until stop() is called
+   */
+  void workerLoop();
+
+  /**
+   * @brief Handle a single HTTP request and close the connection
+   *
+   * @param clientFd Connected client socket
+   */
+  void handleConnection(int clientFd);
+
+  /**
+   * @brief Parse "/tiles/{level}/{x}/{y}.rgba"
+   *
+   * @param path Request path
+   * @param key Output tile key
+   * @return true if the path is a well-formed tile request
+   */
+  static bool parseTilePath(const std::string &path, TileKey &key);
+
+  /**
+   * @brief Send a complete response header and optional body
+   *
+   * @param clientFd Connected client socket
+   * @param status Status line suffix, e.g. "200 OK"
+   * @param contentType Content-Type header value
+   * @param body Response body
+   * @param bodySize Size of the body in bytes
+   * @param extraHeaders Additional header lines, each ending in "\r\n"
+   * @return true if everything was written
+   */
+  static bool sendResponse(int clientFd, const std::string &status,
+                           const std::string &contentType, const void *body,
+                           size_t bodySize,
+                           const std::string &extraHeaders = "");
+
+  /**
+   * @brief Write an entire buffer to a socket
+   *
+   * @param fd Socket descriptor
+   * @param data Data to send
+   * @param size Number of bytes to send
+   * @return true if all bytes were written
+   */
+  static bool sendAll(int fd, const void *data, size_t size);
+
+  std::shared_ptr<TileStore> m_tileStore;
+  uint16_t m_port;
+  uint32_t m_workerCount;
+
+  int m_listenFd;
+  std::vector<std::thread> m_workers;
+  std::atomic<bool> m_running;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Security:
+ *    - Binds to 127.0.0.1 only; this is a local front end, not a public
+ *      server, and it performs no authentication
+ *
+ * 2. Zero-Copy:
+ *    - Cached tiles are written to the socket straight from the pack file
+ *      mapping, so serving a hot tile copies nothing in user space
+ *
+ * 3. Robustness:
+ *    - Receive timeouts keep a stalled client from pinning a worker
+ *    - SIGPIPE is suppressed per socket so a closed client can't kill us
+ */
@@ -0,0 +1,337 @@
+/**
+ * @file TileStore.cpp
+ * @brief Implementation of the memory-mapped tile pyramid store
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#include "TileStore.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint64_t PACK_MAGIC = 0x31534C4954474646ULL; // "FFGTILS1"
+constexpr uint32_t PACK_VERSION = 1;
+constexpr size_t HEADER_BYTES = 64;
+constexpr size_t PAGE_ALIGNMENT = 4096;
+constexpr uint32_t COORD_BITS = 28;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint32_t nextPowerOfTwo(uint32_t value) {
+  uint32_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+/**
+ * @brief 64-bit finalizer (splitmix64) used to spread packed keys
+ */
+uint64_t hashKey(uint64_t key) {
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9ULL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBULL;
+  key ^= key >> 31;
+  return key;
+}
+
+} // namespace
+
+TileStore::TileStore(const std::string &path, uint32_t tileSize,
+                     uint32_t capacity, uint64_t contentTag,
+                     RenderCallback renderCallback)
+    : m_path(path), m_fd(-1), m_mapping(nullptr), m_mappingSize(0),
+      m_dataOffset(0), m_tileSize(tileSize), m_capacity(capacity),
+      m_indexSize(0), m_tileBytes(static_cast<size_t>(tileSize) * tileSize * 4),
+      m_renderCallback(std::move(renderCallback)), m_fullWarningShown(false) {
+  if (tileSize == 0 || capacity == 0) {
+    throw std::invalid_argument("Tile size and capacity must be non-zero");
+  }
+
+  // Keep the index at most half full so probe sequences stay short
+  m_indexSize = nextPowerOfTwo(capacity * 2);
+  m_dataOffset = alignUp(HEADER_BYTES + m_indexSize * sizeof(IndexEntry),
+                         PAGE_ALIGNMENT);
+  m_mappingSize = m_dataOffset + static_cast<size_t>(capacity) * m_tileBytes;
+
+  try {
+    openPackFile(m_mappingSize, contentTag);
+  } catch (...) {
+    // The destructor does not run for a constructor that throws
+    closePackFile();
+    throw;
+  }
+
+  std::cout << "[TileStore] Opened " << m_path << " (" << getTileCount()
+            << "/" << m_capacity << " tiles, " << m_tileSize << "px, "
+            << (m_mappingSize / (1024 * 1024)) << " MB mapped)" << std::endl;
+}
+
+TileStore::~TileStore() {
+  if (m_mapping != nullptr) {
+    msync(m_mapping, m_mappingSize, MS_SYNC);
+  }
+  closePackFile();
+}
+
+void TileStore::closePackFile() {
+  if (m_mapping != nullptr) {
+    munmap(m_mapping, m_mappingSize);
+    m_mapping = nullptr;
+  }
+  if (m_fd >= 0) {
+    close(m_fd);
+    m_fd = -1;
+  }
+}
+
+void TileStore::openPackFile(size_t fileSize, uint64_t contentTag) {
+  m_fd = open(m_path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (m_fd < 0) {
+    throw std::runtime_error("Failed to open tile pack " + m_path + ": " +
+                             std::strerror(errno));
+  }
+
+  struct stat fileStat;
+  if (fstat(m_fd, &fileStat) != 0) {
+    throw std::runtime_error("Failed to stat tile pack " + m_path + ": " +
+                             std::strerror(errno));
+  }
+
+  bool fresh = static_cast<size_t>(fileStat.st_size) != fileSize;
+  if (fresh && ftruncate(m_fd, static_cast<off_t>(fileSize)) != 0) {
+    throw std::runtime_error("Failed to size tile pack " + m_path + ": " +
+                             std::strerror(errno));
+  }
+
+  m_mapping =
+      mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (m_mapping == MAP_FAILED) {
+    m_mapping = nullptr;
+    throw std::runtime_error("Failed to map tile pack " + m_path + ": " +
+                             std::strerror(errno));
+  }
+
+  // Tile requests from a zooming client are scattered across the file
+  madvise(m_mapping, fileSize, MADV_RANDOM);
+
+  PackHeader *hdr = header();
+  if (!fresh &&
+      (hdr->magic != PACK_MAGIC || hdr->version != PACK_VERSION ||
+       hdr->tileSize != m_tileSize || hdr->capacity != m_capacity ||
+       hdr->indexSize != m_indexSize || hdr->contentTag != contentTag)) {
+    std::cout << "[TileStore] Pack " << m_path
+              << " was built with different parameters, reinitializing"
+              << std::endl;
+    fresh = true;
+  }
+
+  if (fresh) {
+    // Only the header and index need clearing; slots are written before use
+    std::memset(m_mapping, 0, m_dataOffset);
+    hdr->magic = PACK_MAGIC;
+    hdr->version = PACK_VERSION;
+    hdr->tileSize = m_tileSize;
+    hdr->capacity = m_capacity;
+    hdr->indexSize = m_indexSize;
+    hdr->contentTag = contentTag;
+    hdr->slotsUsed = 0;
+    hdr->tileCount = 0;
+    msync(m_mapping, m_dataOffset, MS_SYNC);
+  }
+}
+
+TileView TileStore::getTile(const TileKey &key) {
+  if (!isValidKey(key)) {
+    throw std::invalid_argument("Tile key outside of pyramid");
+  }
+
+  uint64_t packedKey = packKey(key);
+
+  // Fast path: tile already published
+  {
+    std::shared_lock<std::shared_mutex> lock(m_indexMutex);
+    int64_t slot = findSlot(packedKey);
+    if (slot >= 0) {
+      return viewForSlot(static_cast<uint32_t>(slot));
+    }
+  }
+
+  // Slow path: join an in-flight render or become the renderer
+  std::shared_future<TileView> pending;
+  std::promise<TileView> promise;
+  {
+    std::lock_guard<std::mutex> lock(m_inflightMutex);
+    auto it = m_inflight.find(packedKey);
+    if (it != m_inflight.end()) {
+      pending = it->second;
+    } else {
+      // Re-check under the in-flight lock: the tile may have been published
+      // between the fast-path lookup and here
+      std::shared_lock<std::shared_mutex> indexLock(m_indexMutex);
+      int64_t slot = findSlot(packedKey);
+      if (slot >= 0) {
+        return viewForSlot(static_cast<uint32_t>(slot));
+      }
+      m_inflight.emplace(packedKey, promise.get_future().share());
+    }
+  }
+
+  if (pending.valid()) {
+    return pending.get();
+  }
+
+  TileView view;
+  try {
+    view = renderAndStore(key, packedKey);
+    promise.set_value(view);
+  } catch (...) {
+    promise.set_exception(std::current_exception());
+    std::lock_guard<std::mutex> lock(m_inflightMutex);
+    m_inflight.erase(packedKey);
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(m_inflightMutex);
+  m_inflight.erase(packedKey);
+  return view;
+}
+
+bool TileStore::hasTile(const TileKey &key) const {
+  if (!isValidKey(key)) {
+    return false;
+  }
+  std::shared_lock<std::shared_mutex> lock(m_indexMutex);
+  return findSlot(packKey(key)) >= 0;
+}
+
+bool TileStore::isValidKey(const TileKey &key) {
+  if (key.level > MAX_LEVEL) {
+    return false;
+  }
+  uint32_t tilesPerSide = 1u << key.level;
+  return key.x < tilesPerSide && key.y < tilesPerSide;
+}
+
+uint32_t TileStore::getTileCount() const {
+  std::shared_lock<std::shared_mutex> lock(m_indexMutex);
+  return header()->tileCount;
+}
+
+uint64_t TileStore::packKey(const TileKey &key) {
+  // Bit 63 marks an occupied bucket so that 0 can mean "empty"
+  return (1ULL << 63) | (static_cast<uint64_t>(key.level) << (2 * COORD_BITS)) |
+         (static_cast<uint64_t>(key.x) << COORD_BITS) |
+         static_cast<uint64_t>(key.y);
+}
+
+int64_t TileStore::findSlot(uint64_t packedKey) const {
+  const IndexEntry *entries = index();
+  uint32_t mask = m_indexSize - 1;
+  uint32_t bucket = static_cast<uint32_t>(hashKey(packedKey)) & mask;
+
+  for (uint32_t probe = 0; probe < m_indexSize; probe++) {
+    const IndexEntry &entry = entries[(bucket + probe) & mask];
+    if (entry.key == 0) {
+      return -1;
+    }
+    if (entry.key == packedKey) {
+      return entry.slot;
+    }
+  }
+  return -1;
+}
+
+TileView TileStore::renderAndStore(const TileKey &key, uint64_t packedKey) {
+  // Reserve a slot, reusing one a failed render gave back
+  int64_t slot = -1;
+  {
+    std::unique_lock<std::shared_mutex> lock(m_indexMutex);
+    if (!m_freeSlots.empty()) {
+      slot = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    } else if (header()->slotsUsed < m_capacity) {
+      slot = header()->slotsUsed++;
+    }
+  }
+
+  if (slot < 0) {
+    // Store is full: still serve the tile, just don't persist it
+    if (!m_fullWarningShown.exchange(true)) {
+      std::cout << "[TileStore] Pack " << m_path << " is full (" << m_capacity
+                << " tiles), serving new tiles without caching" << std::endl;
+    }
+    TileView view;
+    view.transient = std::make_shared<std::vector<uint32_t>>(
+        static_cast<size_t>(m_tileSize) * m_tileSize);
+    m_renderCallback(key, view.transient->data());
+    view.data = reinterpret_cast<const uint8_t *>(view.transient->data());
+    view.size = m_tileBytes;
+    view.persistent = false;
+    return view;
+  }
+
+  // Render straight into the mapping; nobody can see this slot yet
+  uint32_t slotIndex = static_cast<uint32_t>(slot);
+  try {
+    m_renderCallback(key, reinterpret_cast<uint32_t *>(slotData(slotIndex)));
+  } catch (...) {
+    // Never published, so the slot can be handed back
+    std::unique_lock<std::shared_mutex> lock(m_indexMutex);
+    if (slotIndex + 1 == header()->slotsUsed) {
+      header()->slotsUsed--;
+    } else {
+      m_freeSlots.push_back(slotIndex);
+    }
+    throw;
+  }
+
+  // Publish
+  {
+    std::unique_lock<std::shared_mutex> lock(m_indexMutex);
+    IndexEntry *entries = index();
+    uint32_t mask = m_indexSize - 1;
+    uint32_t bucket = static_cast<uint32_t>(hashKey(packedKey)) & mask;
+    while (entries[bucket].key != 0) {
+      bucket = (bucket + 1) & mask;
+    }
+    entries[bucket].slot = slotIndex;
+    entries[bucket].key = packedKey;
+    header()->tileCount++;
+  }
+
+  return viewForSlot(slotIndex);
+}
+
+TileView TileStore::viewForSlot(uint32_t slot) const {
+  TileView view;
+  view.data = slotData(slot);
+  view.size = m_tileBytes;
+  view.persistent = true;
+  return view;
+}
+
+TileStore::IndexEntry *TileStore::index() const {
+  return reinterpret_cast<IndexEntry *>(static_cast<uint8_t *>(m_mapping) +
+                                        HEADER_BYTES);
+}
+
+uint8_t *TileStore::slotData(uint32_t slot) const {
+  return static_cast<uint8_t *>(m_mapping) + m_dataOffset +
+         static_cast<size_t>(slot) * m_tileBytes;
+}
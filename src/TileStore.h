@@ -0,0 +1,280 @@
+/**
+ * @file TileStore.h
+ * @brief Persistent memory-mapped tile pyramid for deep-zoom serving
+ *
+ * This class stores fractal tiles for every zoom level of a quadtree pyramid
+ * in a single pack file. The pack file is memory-mapped: a fixed header, an
+ * open-addressing index and a fixed number of tile slots. Tiles are rendered
+ * lazily the first time they are requested and served straight out of the
+ * mapping afterwards.
+ *
+ * Phase 5 Focus:
+ * - On-disk tile cache that survives restarts
+ * - Bounded memory footprint (fixed slot capacity)
+ * - Concurrent readers with a single publishing writer
+ *
+ * @author Fractal Generator Project
+ * @date July 4, 2025
+ * @version Phase 5 - Tile Serving
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct TileKey
+ * @brief Address of a tile in the pyramid
+ *
+ * Level 0 is a single tile covering the whole fractal; level N has
+ * 2^N x 2^N tiles. x grows along the real axis, y along the imaginary axis.
+ */
+struct TileKey {
+  uint32_t level; ///< Zoom level (0 = whole fractal)
+  uint32_t x;     ///< Column within the level
+  uint32_t y;     ///< Row within the level
+};
+
+/**
+ * @struct TileView
+ * @brief Read-only view of a tile's RGBA pixels
+ *
+ * Cached tiles point directly into the pack file mapping and stay valid for
+ * the lifetime of the TileStore. When the store is full, tiles are rendered
+ * into a transient buffer that the view keeps alive itself.
+ */
+struct TileView {
+  const uint8_t *data = nullptr; ///< Packed RGBA pixels (0xAABBGGRR)
+  size_t size = 0;               ///< Size of the pixel data in bytes
+  bool persistent = false;       ///< True if served from the pack file
+  std::shared_ptr<std::vector<uint32_t>> transient; ///< Owner when !persistent
+};
+
+/**
+ * @class TileStore
+ * @brief Memory-mapped, lazily populated tile pyramid
+ *
+ * Pack file layout:
+ * - Header (magic, version, tile size, capacity, content tag, slot count)
+ * - Index: power-of-two table of {key, slot} pairs, linear probing
+ * - Slots: capacity * tileSize * tileSize * 4 bytes, page aligned
+ *
+ * Concurrency:
+ * - Lookups take a shared lock on the index only
+ * - Concurrent requests for the same missing tile are coalesced so each tile
+ *   is rendered exactly once
+ * - Renders run without any store lock held; only slot reservation and
+ *   index publication are serialized
+ * - Slots are never overwritten, so returned views never change under readers
+ */
+class TileStore {
+public:
+  /**
+   * @brief Callback that renders one tile into a tileSize x tileSize buffer
+   */
+  using RenderCallback = std::function<void(const TileKey &, uint32_t *)>;
+
+  /// Deepest supported level (keys pack x and y into 28 bits each)
+  static constexpr uint32_t MAX_LEVEL = 28;
+
+  /**
+   * @brief Constructor - open or create the pack file
+   *
+   * An existing pack file is reused only if its tile size, capacity and
+   * content tag match; otherwise it is reinitialized, since its tiles were
+   * rendered with different parameters.
+   *
+   * @param path Path of the pack file
+   * @param tileSize Edge length of a tile in pixels
+   * @param capacity Maximum number of tiles kept on disk
+   * @param contentTag Hash of the render parameters the tiles depend on
+   * @param renderCallback Headless renderer used to populate missing tiles
+   *
+   * @throws std::runtime_error If the file cannot be opened, sized or mapped
+   */
+  TileStore(const std::string &path, uint32_t tileSize, uint32_t capacity,
+            uint64_t contentTag, RenderCallback renderCallback);
+
+  /**
+   * @brief Destructor - flush and unmap the pack file
+   */
+  ~TileStore();
+
+  // Disable copy and move for simplicity
+  TileStore(const TileStore &) = delete;
+  TileStore &operator=(const TileStore &) = delete;
+  TileStore(TileStore &&) = delete;
+  TileStore &operator=(TileStore &&) = delete;
+
+  /**
+   * @brief Get a tile, rendering it first if it is not cached yet
+   *
+   * @param key Tile address
+   * @return View of the tile pixels
+   *
+   * @throws std::invalid_argument If the key is outside the pyramid
+   */
+  TileView getTile(const TileKey &key);
+
+  /**
+   * @brief Check whether a tile is already stored in the pack file
+   *
+   * @param key Tile address
+   * @return true if the tile is cached, false otherwise
+   */
+  bool hasTile(const TileKey &key) const;
+
+  /**
+   * @brief Check whether a key addresses a tile inside the pyramid
+   *
+   * @param key Tile address
+   * @return true if level and coordinates are in range
+   */
+  static bool isValidKey(const TileKey &key);
+
+  /**
+   * @brief Get the number of tiles stored in the pack file
+   * @return Number of occupied slots
+   */
+  uint32_t getTileCount() const;
+
+  /**
+   * @brief Get the maximum number of stored tiles
+   * @return Slot capacity of the pack file
+   */
+  uint32_t getCapacity() const { return m_capacity; }
+
+  /**
+   * @brief Get the tile edge length
+   * @return Tile size in pixels
+   */
+  uint32_t getTileSize() const { return m_tileSize; }
+
+  /**
+   * @brief Get the size of one tile in bytes
+   * @return tileSize * tileSize * 4
+   */
+  size_t getTileBytes() const { return m_tileBytes; }
+
+private:
+  /**
+   * @struct PackHeader
+   * @brief On-disk header at offset 0 of the pack file
+   */
+  struct PackHeader {
+    uint64_t magic;      ///< PACK_MAGIC
+    uint32_t version;    ///< PACK_VERSION
+    uint32_t tileSize;   ///< Tile edge length in pixels
+    uint32_t capacity;   ///< Number of tile slots
+    uint32_t indexSize;  ///< Number of index entries (power of two)
+    uint64_t contentTag; ///< Render parameter hash
+    uint32_t slotsUsed;  ///< Slots reserved so far
+    uint32_t tileCount;  ///< Tiles published in the index
+  };
+
+  /**
+   * @struct IndexEntry
+   * @brief One bucket of the open-addressing index
+   */
+  struct IndexEntry {
+    uint64_t key;  ///< Packed tile key, 0 = empty bucket
+    uint32_t slot; ///< Slot holding the tile pixels
+    uint32_t reserved;
+  };
+
+  /**
+   * @brief Pack a key into a non-zero 64-bit index key
+   */
+  static uint64_t packKey(const TileKey &key);
+
+  /**
+   * @brief Initialize or validate the mapped file
+   *
+   * @param fileSize Expected size of the pack file
+   * @param contentTag Render parameter hash
+   */
+  void openPackFile(size_t fileSize, uint64_t contentTag);
+
+  /**
+   * @brief Unmap and close the pack file (safe on a partial open)
+   */
+  void closePackFile();
+
+  /**
+   * @brief Find the slot of a stored tile (caller holds m_indexMutex)
+   *
+   * @param packedKey Packed tile key
+   * @return Slot index, or -1 if not stored
+   */
+  int64_t findSlot(uint64_t packedKey) const;
+
+  /**
+   * @brief Render a missing tile and publish it to the index
+   *
+   * @param key Tile address
+   * @param packedKey Packed tile key
+   * @return View of the rendered tile
+   */
+  TileView renderAndStore(const TileKey &key, uint64_t packedKey);
+
+  /**
+   * @brief Build a view of a stored slot
+   */
+  TileView viewForSlot(uint32_t slot) const;
+
+  PackHeader *header() const { return static_cast<PackHeader *>(m_mapping); }
+  IndexEntry *index() const;
+  uint8_t *slotData(uint32_t slot) const;
+
+  // Pack file
+  std::string m_path;
+  int m_fd;
+  void *m_mapping;
+  size_t m_mappingSize;
+  size_t m_dataOffset;
+
+  // Layout
+  uint32_t m_tileSize;
+  uint32_t m_capacity;
+  uint32_t m_indexSize;
+  size_t m_tileBytes;
+
+  RenderCallback m_renderCallback;
+
+  // Synchronization
+  mutable std::shared_mutex m_indexMutex; ///< Guards index and header counts
+  std::mutex m_inflightMutex;             ///< Guards m_inflight
+  std::unordered_map<uint64_t, std::shared_future<TileView>> m_inflight;
+  std::vector<uint32_t> m_freeSlots; ///< Given back by failed renders (index lock)
+  std::atomic<bool> m_fullWarningShown;
+};
+
+/**
+ * Implementation Notes:
+ *
+ * 1. Memory Bounds:
+ *    - The mapping is sized once from the slot capacity and never grows
+ *    - Resident memory is left to the page cache; cold tiles are evicted by
+ *      the kernel, not by us
+ *    - When all slots are used, tiles are still rendered but not persisted
+ *
+ * 2. Zero-Copy Serving:
+ *    - Cached tile views point into the mapping, so the server writes the
+ *      socket directly from the page cache with no intermediate buffer
+ *
+ * 3. Crash Behaviour:
+ *    - Pixels are written before the index entry is published, so a process
+ *      crash mid-render can only lose a tile, never expose a half-written one
+ *    - A render that throws hands its slot back: the last slot is returned
+ *      to slotsUsed, others are reused by the next reservation
+ */
@@ -18,18 +18,74 @@
 
 #include "VulkanApplication.h"
 #include "ComputePipeline.h"
+#include "FrameGraph.h"
+#include "GpuTimer.h"
 #include "GraphicsPipeline.h"
 #include "GuiManager.h"
 #include "MemoryManager.h"
+#include "PipelineCache.h"
+#include "ResolutionGovernor.h"
 #include "ShaderManager.h"
 #include "SwapchainManager.h"
 #include "TextureManager.h"
 #include "VulkanSetup.h"
 #include "WindowManager.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 
+namespace {
+
+// How often heap budgets are checked for memory pressure
+constexpr double MEMORY_CHECK_INTERVAL = 0.5; // seconds
+
+// Smallest resolution the budget fallback shrinks to
+constexpr uint32_t MIN_FRACTAL_DIMENSION = 64;
+
+// Graphics submissions tracked for deferred deletion
+constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+
+// Texture copies used in turn, so landing an image rarely waits for the
+// previous copy
+constexpr uint32_t COPY_COMMAND_BUFFERS = 2;
+
+/**
+ * @brief Write packed 0xAABBGGRR pixels as a binary PPM
+ */
+bool writeImagePPM(const std::string &path, const uint32_t *pixels,
+                   uint32_t width, uint32_t height) {
+  std::ofstream file(path, std::ios::binary);
+  file << "P6\n" << width << " " << height << "\n255\n";
+
+  std::vector<char> row(static_cast<size_t>(width) * 3);
+  for (uint32_t y = 0; y < height; y++) {
+    const uint32_t *source = pixels + static_cast<size_t>(y) * width;
+    for (uint32_t x = 0; x < width; x++) {
+      row[x * 3 + 0] = static_cast<char>(source[x] & 0xFF);
+      row[x * 3 + 1] = static_cast<char>((source[x] >> 8) & 0xFF);
+      row[x * 3 + 2] = static_cast<char>((source[x] >> 16) & 0xFF);
+    }
+    file.write(row.data(), static_cast<std::streamsize>(row.size()));
+  }
+
+  if (!file) {
+    std::cerr << "VulkanApplication: Failed to write " << path << std::endl;
+    return false;
+  }
+  return true;
+}
+
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
 /**
  * @brief Constructor - Initialize the Vulkan application
  *
@@ -83,6 +139,29 @@ VulkanApplication::~VulkanApplication() {
     // Stop the main loop if it's running
     m_isRunning = false;
 
+    // Deferred deletions are flushed by their owners below, which is only
+    // safe once the GPU has finished every frame
+    if (m_vulkanSetup) {
+      vkDeviceWaitIdle(m_vulkanSetup->getDevice());
+      for (const FrameSync &sync : m_frameSync) {
+        vkDestroyFence(m_vulkanSetup->getDevice(), sync.fence, nullptr);
+        vkDestroySemaphore(m_vulkanSetup->getDevice(), sync.imageAvailable,
+                           nullptr);
+      }
+      m_frameSync.clear();
+      for (VkSemaphore semaphore : m_renderFinishedSemaphores) {
+        vkDestroySemaphore(m_vulkanSetup->getDevice(), semaphore, nullptr);
+      }
+      m_renderFinishedSemaphores.clear();
+      m_frameGraph.reset();
+      m_gpuTimer.reset();
+    }
+
+    // Persist what the driver compiled this run for the next startup
+    if (m_pipelineCache) {
+      m_pipelineCache->save();
+    }
+
     // Clean up Phase 2 resources first
     if (m_computeCommandPool != VK_NULL_HANDLE && m_vulkanSetup) {
       std::cout << "VulkanApplication: Cleaning up compute command pool..."
@@ -133,6 +212,10 @@ VulkanApplication::~VulkanApplication() {
       m_memoryManager.reset();
     }
 
+    if (m_pipelineCache) {
+      m_pipelineCache.reset();
+    }
+
     // Clean up shader manager
     if (m_shaderManager) {
       std::cout << "VulkanApplication: Cleaning up shader manager..."
@@ -172,6 +255,8 @@ VulkanApplication::~VulkanApplication() {
  * function ensures they're created in the correct order and are compatible.
  */
 void VulkanApplication::initializeSubsystems() {
+  auto startupTime = std::chrono::steady_clock::now();
+
   std::cout << "VulkanApplication: Initializing window management..."
             << std::endl;
 
@@ -197,28 +282,43 @@ void VulkanApplication::initializeSubsystems() {
   // Initialize memory manager
   m_memoryManager = std::make_shared<MemoryManager>(
       m_vulkanSetup->getDevice(), m_vulkanSetup->getPhysicalDevice());
+  if (m_vulkanSetup->isMemoryBudgetSupported()) {
+    m_memoryManager->enableMemoryBudgetExtension(
+        m_vulkanSetup->getInstance());
+  }
+
+  // A dedicated compute family writes the output buffer the graphics queue
+  // copies from, so that buffer is shared by both
+  const QueueFamilyIndices &queueFamilies = m_vulkanSetup->getQueueFamilies();
+  m_memoryManager->setSharedQueueFamilies(
+      {queueFamilies.computeFamily.value(),
+       queueFamilies.graphicsFamily.value()});
+
+  // One driver cache for every pipeline, warm from the previous run
+  m_pipelineCache = std::make_shared<PipelineCache>(
+      m_vulkanSetup->getDevice(), m_vulkanSetup->getPhysicalDevice());
 
   // Initialize compute pipeline
   m_computePipeline = std::make_shared<ComputePipeline>(
-      m_vulkanSetup->getDevice(), m_shaderManager, m_memoryManager);
+      m_vulkanSetup->getDevice(), m_shaderManager, m_memoryManager,
+      m_pipelineCache);
 
   // Create command pool for compute operations
   m_computeCommandPool = m_vulkanSetup->createComputeCommandPool();
 
-  // Allocate command buffer
-  VkCommandBufferAllocateInfo allocInfo{};
-  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  allocInfo.commandPool = m_computeCommandPool;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  allocInfo.commandBufferCount = 1;
+  // Full renders and the kept accumulation pass
+  std::vector<VkCommandBuffer> computeBuffers = allocateCommandBuffers(
+      m_computeCommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 2);
+  m_computeCommandBuffer = computeBuffers[0];
+  m_accumulateCommands.commandBuffer = computeBuffers[1];
 
-  VkResult result = vkAllocateCommandBuffers(
-      m_vulkanSetup->getDevice(), &allocInfo, &m_computeCommandBuffer);
-  if (result != VK_SUCCESS) {
-    throw std::runtime_error(
-        "Failed to allocate compute command buffer! Vulkan error: " +
-        std::to_string(result));
-  }
+  // Dynamic resolution: time the dispatch on the queue it runs on
+  m_gpuTimer = std::make_unique<GpuTimer>(
+      m_vulkanSetup->getDevice(), m_vulkanSetup->getPhysicalDevice(),
+      m_vulkanSetup->getQueueFamilies().computeFamily.value());
+  m_resolutionGovernor = std::make_unique<ResolutionGovernor>();
+  m_resolutionGovernor->setEnabled(m_guiParams.dynamicResolution);
+  m_resolutionGovernor->setTargetFrameTime(m_guiParams.targetFrameTime);
 
   // Create fractal compute pipeline
   bool fractalPipelineResult =
@@ -227,6 +327,11 @@ void VulkanApplication::initializeSubsystems() {
     throw std::runtime_error("Failed to create fractal compute pipeline!");
   }
 
+#ifdef VK_ENABLE_VALIDATION_LAYERS
+  // Development builds pick up compute shader edits while running
+  m_computePipeline->setShaderHotReloadEnabled(true);
+#endif
+
   std::cout << "VulkanApplication: Initializing Phase 3 graphics pipeline "
                "subsystems..."
             << std::endl;
@@ -244,7 +349,8 @@ void VulkanApplication::initializeSubsystems() {
 
   // Initialize graphics pipeline
   m_graphicsPipeline = std::make_shared<GraphicsPipeline>(
-      m_vulkanSetup->getDevice(), m_shaderManager, m_swapchainManager);
+      m_vulkanSetup->getDevice(), m_shaderManager, m_swapchainManager,
+      m_memoryManager, FRAMES_IN_FLIGHT, m_pipelineCache);
 
   // Create graphics pipeline
   bool graphicsPipelineResult =
@@ -281,24 +387,94 @@ void VulkanApplication::initializeSubsystems() {
   // Create graphics command pool and command buffers
   m_graphicsCommandPool = m_vulkanSetup->createGraphicsCommandPool();
 
-  // Allocate command buffers (one per swapchain image)
+  // Allocate command buffers (one per swapchain image); the copies run on
+  // the graphics queue, so they come from this pool too
   uint32_t imageCount = m_swapchainManager->getImageCount();
+  std::vector<VkCommandBuffer> primaries = allocateCommandBuffers(
+      m_graphicsCommandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+      imageCount + COPY_COMMAND_BUFFERS);
+  std::vector<VkCommandBuffer> secondaries = allocateCommandBuffers(
+      m_graphicsCommandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      2 * imageCount);
   m_graphicsCommandBuffers.resize(imageCount);
+  m_fractalDrawCommands.resize(imageCount);
+  m_guiCommandBuffers.resize(imageCount);
+  for (uint32_t i = 0; i < imageCount; i++) {
+    m_graphicsCommandBuffers[i] = primaries[i];
+    m_fractalDrawCommands[i].commandBuffer = secondaries[2 * i];
+    m_guiCommandBuffers[i] = secondaries[2 * i + 1];
+  }
+  m_copyCommands.resize(COPY_COMMAND_BUFFERS);
+  m_copyValues.resize(COPY_COMMAND_BUFFERS);
+  for (uint32_t i = 0; i < COPY_COMMAND_BUFFERS; i++) {
+    m_copyCommands[i].commandBuffer = primaries[imageCount + i];
+  }
+  m_imageFrames.assign(imageCount, 0);
+
+  // Frame fences gate command buffer reuse and drive the deletion queue;
+  // semaphores order each frame between acquire, draw and present
+  VkDevice device = m_vulkanSetup->getDevice();
+  VkFenceCreateInfo fenceInfo{};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+  VkSemaphoreCreateInfo semaphoreInfo{};
+  semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  m_frameSync.resize(FRAMES_IN_FLIGHT);
+  for (FrameSync &sync : m_frameSync) {
+    VkResult fenceResult =
+        vkCreateFence(device, &fenceInfo, nullptr, &sync.fence);
+    if (fenceResult != VK_SUCCESS) {
+      throw std::runtime_error(
+          "Failed to create frame fence! Vulkan error: " +
+          std::to_string(fenceResult));
+    }
 
-  VkCommandBufferAllocateInfo graphicsAllocInfo{};
-  graphicsAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-  graphicsAllocInfo.commandPool = m_graphicsCommandPool;
-  graphicsAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  graphicsAllocInfo.commandBufferCount =
-      static_cast<uint32_t>(m_graphicsCommandBuffers.size());
-
-  VkResult graphicsResult =
-      vkAllocateCommandBuffers(m_vulkanSetup->getDevice(), &graphicsAllocInfo,
-                               m_graphicsCommandBuffers.data());
-  if (graphicsResult != VK_SUCCESS) {
-    throw std::runtime_error(
-        "Failed to allocate graphics command buffers! Vulkan error: " +
-        std::to_string(graphicsResult));
+    VkResult semaphoreResult = vkCreateSemaphore(device, &semaphoreInfo,
+                                                 nullptr, &sync.imageAvailable);
+    if (semaphoreResult != VK_SUCCESS) {
+      throw std::runtime_error(
+          "Failed to create image available semaphore! Vulkan error: " +
+          std::to_string(semaphoreResult));
+    }
+  }
+
+  m_renderFinishedSemaphores.resize(imageCount, VK_NULL_HANDLE);
+  for (VkSemaphore &semaphore : m_renderFinishedSemaphores) {
+    VkResult semaphoreResult =
+        vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore);
+    if (semaphoreResult != VK_SUCCESS) {
+      throw std::runtime_error(
+          "Failed to create render finished semaphore! Vulkan error: " +
+          std::to_string(semaphoreResult));
+    }
+  }
+
+  // Passes declare what they touch; the graph derives barriers, layout
+  // transitions and the compute-to-graphics timeline waits from it
+  m_frameGraph = std::make_unique<FrameGraph>(
+      m_vulkanSetup->getDevice(), m_vulkanSetup->getComputeQueue(),
+      m_vulkanSetup->getGraphicsQueue(),
+      m_vulkanSetup->isTimelineSemaphoreSupported());
+  m_outputResource = m_frameGraph->addBuffer("fractal_output");
+  m_textureResource = m_frameGraph->addImage("fractal_texture");
+  m_fractalPass = m_frameGraph->addPass(
+      "fractal", QueueType::COMPUTE,
+      {{m_outputResource, ResourceAccess::COMPUTE_WRITE}});
+  m_accumulatePass = m_frameGraph->addPass(
+      "fractal_accumulate", QueueType::COMPUTE,
+      {{m_outputResource, ResourceAccess::COMPUTE_WRITE}});
+  m_copyPass = m_frameGraph->addPass(
+      "texture_copy", QueueType::GRAPHICS,
+      {{m_outputResource, ResourceAccess::TRANSFER_READ},
+       {m_textureResource, ResourceAccess::TRANSFER_WRITE, true}});
+  m_drawPass = m_frameGraph->addPass(
+      "fractal_draw", QueueType::GRAPHICS,
+      {{m_textureResource, ResourceAccess::FRAGMENT_SAMPLED}});
+  if (m_frameGraph->hasTimelineSemaphores()) {
+    std::cout << "VulkanApplication: Async compute enabled"
+              << (m_vulkanSetup->hasDedicatedComputeQueue()
+                      ? " (dedicated compute queue)"
+                      : "")
+              << std::endl;
   }
 
   std::cout
@@ -315,6 +491,7 @@ void VulkanApplication::initializeSubsystems() {
   if (!guiResult) {
     throw std::runtime_error("Failed to initialize GUI manager!");
   }
+  m_guiManager->setMemoryManager(m_memoryManager);
 
   // Synchronization objects implemented - proper Vulkan synchronization working
   // Details: Create semaphores for swapchain synchronization
@@ -323,6 +500,12 @@ void VulkanApplication::initializeSubsystems() {
 
   std::cout << "VulkanApplication: All subsystems initialized successfully."
             << std::endl;
+
+  // Compare cold and warm starts to see what the pipeline cache saves
+  std::cout << "VulkanApplication: Startup took "
+            << elapsedMilliseconds(startupTime) << " ms (pipeline cache "
+            << (m_pipelineCache->wasLoaded() ? "warm" : "cold") << ")"
+            << std::endl;
 }
 
 /**
@@ -440,6 +623,30 @@ void VulkanApplication::renderFrame() {
     return; // Phase 2 compute pipeline not ready yet
   }
 
+  // Retire finished staging transfers and run their readback callbacks
+  if (m_memoryManager) {
+    m_memoryManager->processCompletedTransfers();
+    retireCompletedFrames();
+  }
+  processPendingExports();
+
+  // Show the fractal the compute queue finished since the last frame
+  pollComputeImage();
+
+  // Swap in pipelines rebuilt in the background; the image they replace
+  // was made by the old shader
+  m_computePipeline->reloadChangedShaders();
+  if (!m_computePipeline->collectCompiledPipelines().empty()) {
+    m_guiParams.needsRecompute = true;
+  }
+
+  // Feed finished dispatch timings to the resolution governor
+  if (m_gpuTimer->collect()) {
+    m_lastComputeTime = m_gpuTimer->getLastMilliseconds();
+    m_resolutionGovernor->reportComputeTime(m_lastComputeTime,
+                                            m_timedRenderScale);
+  }
+
   // Phase 5: Begin GUI frame
   if (m_guiManager) {
     m_guiManager->beginFrame();
@@ -455,11 +662,30 @@ void VulkanApplication::renderFrame() {
         .fractalType = static_cast<int>(m_guiParams.fractalType),
         .resolutionWidth = static_cast<int>(m_fractalWidth),
         .resolutionHeight = static_cast<int>(m_fractalHeight),
+        .antiAliasingSamples =
+            static_cast<int>(m_guiParams.antiAliasingSamples),
+        .temporalAccumulation = m_guiParams.temporalAccumulation,
+        .accumulatedSamples = static_cast<int>(
+            m_computePipeline->getAccumulatedFrameCount()),
+        .dynamicResolution = m_guiParams.dynamicResolution,
+        .targetFrameTime = m_guiParams.targetFrameTime,
+        .renderScale = m_resolutionGovernor->getScale(),
+        .computeTime = static_cast<float>(m_lastComputeTime),
         .parametersChanged = m_guiParams.parametersChanged,
         .needsRecompute = m_guiParams.needsRecompute};
 
     bool paramsChanged = m_guiManager->renderControls(guiParams);
 
+    if (guiParams.exportRequested) {
+      requestImageExport();
+    }
+
+    // Governor settings only affect how the next renders are sized
+    m_guiParams.dynamicResolution = guiParams.dynamicResolution;
+    m_guiParams.targetFrameTime = guiParams.targetFrameTime;
+    m_resolutionGovernor->setEnabled(guiParams.dynamicResolution);
+    m_resolutionGovernor->setTargetFrameTime(guiParams.targetFrameTime);
+
     // Copy GUI parameters back and mark if changes occurred
     if (paramsChanged) {
       m_guiParams.centerX = guiParams.centerX;
@@ -469,18 +695,29 @@ void VulkanApplication::renderFrame() {
           static_cast<uint32_t>(guiParams.maxIterations);
       m_guiParams.colorScale = guiParams.colorScale;
       m_guiParams.fractalType = static_cast<uint32_t>(guiParams.fractalType);
+      m_guiParams.antiAliasingSamples =
+          static_cast<uint32_t>(guiParams.antiAliasingSamples);
+      if (guiParams.temporalAccumulation != m_guiParams.temporalAccumulation) {
+        m_guiParams.temporalAccumulation = guiParams.temporalAccumulation;
+        m_computePipeline->setTemporalAccumulationEnabled(
+            guiParams.temporalAccumulation);
+      }
       m_guiParams.parametersChanged = true;
       m_guiParams.needsRecompute = true;
+      m_resolutionGovernor->onViewChanged();
 
-      // Handle resolution changes
-      bool resolutionChanged = false;
+      // Handle resolution changes; on failure the old size stays and the
+      // GUI shows it again next frame
       if (static_cast<uint32_t>(guiParams.resolutionWidth) != m_fractalWidth ||
           static_cast<uint32_t>(guiParams.resolutionHeight) !=
               m_fractalHeight) {
-        m_fractalWidth = static_cast<uint32_t>(guiParams.resolutionWidth);
-        m_fractalHeight = static_cast<uint32_t>(guiParams.resolutionHeight);
-        resolutionChanged = true;
-        // Texture recreation implemented - handled by compute pipeline
+        uint32_t width = static_cast<uint32_t>(guiParams.resolutionWidth);
+        uint32_t height = static_cast<uint32_t>(guiParams.resolutionHeight);
+        fitResolutionToBudget(width, height);
+        if (resizeFractalImage(width, height)) {
+          m_fractalWidth = width;
+          m_fractalHeight = height;
+        }
       }
 
       // Update actual fractal parameters only when GUI changes occur
@@ -492,129 +729,36 @@ void VulkanApplication::renderFrame() {
       m_fractalParams.colorScale = guiParams.colorScale;
       m_fractalParams.fractalType =
           static_cast<uint32_t>(guiParams.fractalType);
+      m_fractalParams.antiAliasingSamples =
+          static_cast<uint32_t>(guiParams.antiAliasingSamples);
     }
   }
 
-  // Only recompute fractal if parameters changed (render-on-change
-  // optimization)
-  if (!m_guiParams.needsRecompute && m_guiParams.parametersChanged == false) {
-    // For now, we'll still render everything. Later we can optimize this.
-    // Render-on-change optimization partially implemented
-    // Currently always renders for responsiveness; future optimization possible
-  }
-
-  // Update fractal parameters
-  FractalParameters params{};
-  params.centerX = m_fractalParams.centerX;
-  params.centerY = m_fractalParams.centerY;
-  params.zoom = m_fractalParams.zoom;
-  params.maxIterations = m_fractalParams.maxIterations;
-  params.imageWidth = m_fractalWidth;
-  params.imageHeight = m_fractalHeight;
-  params.colorScale = m_fractalParams.colorScale;
-  params.fractalType = m_fractalParams.fractalType;
-
-  m_computePipeline->updateFractalParameters(params);
-
-  // Record compute commands
-  VkCommandBufferBeginInfo beginInfo{};
-  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  vkBeginCommandBuffer(m_computeCommandBuffer, &beginInfo);
-
-  // Dispatch fractal computation
-  m_computePipeline->dispatchFractalCompute(m_computeCommandBuffer);
-
-  vkEndCommandBuffer(m_computeCommandBuffer);
-
-  // Submit compute work
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &m_computeCommandBuffer;
-
-  VkResult result = vkQueueSubmit(m_vulkanSetup->getComputeQueue(), 1,
-                                  &submitInfo, VK_NULL_HANDLE);
-  if (result != VK_SUCCESS) {
-    std::cerr << "VulkanApplication: Failed to submit compute commands! Error: "
-              << result << std::endl;
-    return;
-  }
-
-  // Wait for completion (for now - will optimize later)
-  vkQueueWaitIdle(m_vulkanSetup->getComputeQueue());
-
-  // Phase 4: Copy compute buffer to texture for graphics rendering
-  if (!m_textureManager || !m_textureManager->isTextureReady()) {
-    std::cerr
-        << "VulkanApplication: Texture manager not ready, skipping frame..."
-        << std::endl;
-    return;
-  }
-
-  // Get the fractal output buffer from compute pipeline
-  std::shared_ptr<BufferInfo> fractalBuffer =
-      m_computePipeline->getFractalOutputBuffer();
-  if (!fractalBuffer || fractalBuffer->buffer == VK_NULL_HANDLE) {
-    std::cerr << "VulkanApplication: No fractal output buffer available!"
-              << std::endl;
-    return;
+  // Dynamic resolution: a new render scale invalidates the shown image
+  uint32_t renderWidth = m_fractalWidth;
+  uint32_t renderHeight = m_fractalHeight;
+  ResolutionGovernor::scaleExtent(m_fractalWidth, m_fractalHeight,
+                                  m_resolutionGovernor->getScale(),
+                                  renderWidth, renderHeight);
+  if (m_computePipeline->setRenderExtent(renderWidth, renderHeight)) {
+    m_guiParams.needsRecompute = true;
   }
 
-  // Record buffer-to-texture copy commands
-  VkCommandBufferBeginInfo copyBeginInfo{};
-  copyBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  copyBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-  vkBeginCommandBuffer(m_computeCommandBuffer, &copyBeginInfo);
-
-  // Transition texture to transfer destination layout using MemoryManager
-  // utility
-  m_memoryManager->transitionImageLayout(
-      m_textureManager->getTextureImage(), m_textureManager->getTextureFormat(),
-      VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-      m_computeCommandBuffer);
-
-  // Copy buffer to texture
-  m_textureManager->copyBufferToTexture(
-      m_computeCommandBuffer, fractalBuffer->buffer, fractalBuffer->size);
-
-  // Transition texture to shader read layout using MemoryManager utility
-  m_memoryManager->transitionImageLayout(
-      m_textureManager->getTextureImage(), m_textureManager->getTextureFormat(),
-      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_computeCommandBuffer);
-
-  vkEndCommandBuffer(m_computeCommandBuffer);
-
-  // Submit copy commands
-  VkSubmitInfo copySubmitInfo{};
-  copySubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  copySubmitInfo.commandBufferCount = 1;
-  copySubmitInfo.pCommandBuffers = &m_computeCommandBuffer;
-
-  VkResult copyResult = vkQueueSubmit(m_vulkanSetup->getGraphicsQueue(), 1,
-                                      &copySubmitInfo, VK_NULL_HANDLE);
-  if (copyResult != VK_SUCCESS) {
-    std::cerr << "VulkanApplication: Failed to submit copy commands! Error: "
-              << copyResult << std::endl;
-    return;
-  }
-
-  // Wait for copy completion
-  vkQueueWaitIdle(m_vulkanSetup->getGraphicsQueue());
-
   // Phase 3: Graphics rendering implementation
   if (!m_graphicsPipeline || !m_graphicsPipeline->isPipelineReady() ||
       !m_swapchainManager) {
+    dispatchFractalWork();
     return; // Graphics pipeline not ready yet
   }
 
+  // The slot's fence also frees its acquire semaphore, which the frame
+  // submitted FRAMES_IN_FLIGHT frames ago waited for
+  FrameSync &frameSync = acquireFrameSync();
+
   // Acquire next swapchain image
   uint32_t imageIndex;
-  VkResult acquireResult =
-      m_swapchainManager->acquireNextImage(VK_NULL_HANDLE, imageIndex);
+  VkResult acquireResult = m_swapchainManager->acquireNextImage(
+      frameSync.imageAvailable, imageIndex);
   if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
     // TODO(Future): Handle swapchain recreation for window resize robustness
     // Currently gracefully handles out-of-date swapchain by skipping frame
@@ -628,53 +772,100 @@ void VulkanApplication::renderFrame() {
     return;
   }
 
-  // Record graphics command buffer
-  VkCommandBuffer graphicsCmd = m_graphicsCommandBuffers[imageIndex];
+  // The image's command buffers (GUI included) may still be pending from
+  // the last frame that drew to it
+  waitForFrame(m_imageFrames[imageIndex]);
+
+  // The fractal draw only changes with the texture binding, display region
+  // or framebuffers, so it is recorded once per swapchain image. It goes
+  // into a secondary so it can be kept while the primary around it carries
+  // this frame's barriers. Recorded before the draw pass begins, since a
+  // pass the graph has begun has to be ended and submitted.
+  VkCommandBufferInheritanceInfo inheritance{};
+  inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  inheritance.renderPass = m_graphicsPipeline->getRenderPass();
+  inheritance.subpass = 0;
+  inheritance.framebuffer = m_graphicsPipeline->getFramebuffer(imageIndex);
+
+  VkCommandBuffer guiCmd = VK_NULL_HANDLE;
+  if (m_guiManager) {
+    // Phase 5: the GUI overlay is new every frame and goes next to the kept
+    // fractal draw; its frame is ended even if the draw fails below
+    guiCmd = m_guiCommandBuffers[imageIndex];
+    VkCommandBufferBeginInfo guiBeginInfo{};
+    guiBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    guiBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                         VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    guiBeginInfo.pInheritanceInfo = &inheritance;
+
+    vkBeginCommandBuffer(guiCmd, &guiBeginInfo);
+    m_guiManager->endFrame(guiCmd);
+    vkEndCommandBuffer(guiCmd);
+  }
+
+  RecordedCommands &drawCommands = m_fractalDrawCommands[imageIndex];
+  if (!recordCommands(
+          drawCommands, {m_graphicsPipeline->getRecordingVersion()},
+          [this](VkCommandBuffer commandBuffer) {
+            m_graphicsPipeline->renderFractal(commandBuffer, VK_NULL_HANDLE);
+          },
+          &inheritance)) {
+    skipAcquiredFrame(frameSync);
+    dispatchFractalWork();
+    return;
+  }
+
+  std::vector<VkCommandBuffer> secondaries = {drawCommands.commandBuffer};
+  if (guiCmd != VK_NULL_HANDLE) {
+    secondaries.push_back(guiCmd);
+  }
+
+  // Barriers cannot go inside the render pass, so the primary records the
+  // texture's move to SHADER_READ_ONLY before beginning it
+  m_frameGraph->setImage(m_textureResource,
+                         m_textureManager->getTextureImage());
+  const FrameGraph::PassBarriers &drawBarriers =
+      m_frameGraph->beginPass(m_drawPass);
 
+  VkCommandBuffer graphicsCmd = m_graphicsCommandBuffers[imageIndex];
   VkCommandBufferBeginInfo graphicsBeginInfo{};
   graphicsBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
   graphicsBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   vkBeginCommandBuffer(graphicsCmd, &graphicsBeginInfo);
-
-  // Begin render pass
-  m_graphicsPipeline->beginRenderPass(graphicsCmd, imageIndex);
-
-  // Render fractal (now using the actual fractal texture)
-  m_graphicsPipeline->renderFractal(graphicsCmd, VK_NULL_HANDLE);
-
-  // Phase 5: Render GUI overlay
-  if (m_guiManager) {
-    m_guiManager->endFrame(graphicsCmd);
-  }
-
-  // End render pass
+  drawBarriers.record(graphicsCmd);
+  m_graphicsPipeline->beginRenderPass(
+      graphicsCmd, imageIndex, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+  vkCmdExecuteCommands(graphicsCmd,
+                       static_cast<uint32_t>(secondaries.size()),
+                       secondaries.data());
   m_graphicsPipeline->endRenderPass(graphicsCmd);
+  vkEndCommandBuffer(graphicsCmd);
+  m_frameGraph->endPass(m_drawPass, graphicsCmd);
 
   // Mark parameters as processed
-  m_guiParams.needsRecompute = false;
   m_guiParams.parametersChanged = false;
 
-  vkEndCommandBuffer(graphicsCmd);
-
-  // Submit graphics commands
-  VkSubmitInfo graphicsSubmitInfo{};
-  graphicsSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  graphicsSubmitInfo.commandBufferCount = 1;
-  graphicsSubmitInfo.pCommandBuffers = &graphicsCmd;
-
-  VkResult submitResult = vkQueueSubmit(m_vulkanSetup->getGraphicsQueue(), 1,
-                                        &graphicsSubmitInfo, VK_NULL_HANDLE);
-  if (submitResult != VK_SUCCESS) {
-    std::cerr
-        << "VulkanApplication: Failed to submit graphics commands! Error: "
-        << submitResult << std::endl;
+  // Submit graphics commands: the texture copy of a landed image and the
+  // draw go out in one batch. Nothing that writes the copy's source has
+  // been scheduled yet, so the graph has no reason to split them.
+  VkSemaphore renderFinished = m_renderFinishedSemaphores[imageIndex];
+  if (!m_frameGraph->submit(QueueType::GRAPHICS, frameSync.fence,
+                            frameSync.imageAvailable,
+                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                            renderFinished)) {
     return;
   }
+  frameSync.frame = m_frameNumber;
+  m_imageFrames[imageIndex] = m_frameNumber;
+
+  // The next dispatch overwrites the copy's source, so it waits on the
+  // batch just submitted
+  dispatchFractalWork();
 
   // Present the frame
   VkResult presentResult = m_swapchainManager->presentImage(
-      m_vulkanSetup->getPresentQueue(), imageIndex, VK_NULL_HANDLE);
+      m_vulkanSetup->getPresentQueue(), imageIndex, renderFinished);
   if (presentResult == VK_ERROR_OUT_OF_DATE_KHR ||
       presentResult == VK_SUBOPTIMAL_KHR) {
     // TODO(Future): Handle swapchain recreation for optimal presentation
@@ -688,22 +879,17 @@ void VulkanApplication::renderFrame() {
     return;
   }
 
-  // Wait for graphics operations to complete (temporary - will use proper sync
-  // later)
-  vkQueueWaitIdle(m_vulkanSetup->getGraphicsQueue());
-
-  // Synchronization implemented - frame synchronization working correctly
-  // Details: Use semaphores and fences instead of queue wait idle
-  // Priority: High
-  // Dependencies: Basic rendering working
+  // No queue wait: frame fences gate command buffer reuse, so the CPU
+  // records the next frame while the GPU draws this one
 
   // Phase 2: Basic compute dispatch working, log progress occasionally
   static int frameCount = 0;
   if ((frameCount % 60) == 0) { // Log every 60 frames (~1 second at 60 FPS)
     std::cout << "VulkanApplication: Computed fractal frame " << frameCount
               << " (zoom: " << m_fractalParams.zoom
-              << ", iterations: " << m_fractalParams.maxIterations << ")"
-              << std::endl;
+              << ", iterations: " << m_fractalParams.maxIterations
+              << ", kept command buffers recorded: " << m_commandRecordings
+              << ")" << std::endl;
 
     // Save first computed frame to verify it's working
     if (frameCount == 0) {
@@ -717,6 +903,553 @@ void VulkanApplication::renderFrame() {
   frameCount++;
 }
 
+/**
+ * @brief Start a full render or a temporal refinement
+ *
+ * Render-on-change: the texture keeps the last image, so static frames
+ * only refine it with temporal samples until it has converged. While a
+ * dispatch is in flight the graphics queue keeps presenting the previous
+ * image and the GUI; the newest parameters go out once it has landed.
+ */
+void VulkanApplication::dispatchFractalWork() {
+  if (m_inFlightCompute) {
+    return;
+  }
+
+  if (m_guiParams.needsRecompute) {
+    // On failure the render is retried next frame
+    if (computeFractalImage()) {
+      m_guiParams.needsRecompute = false;
+    }
+  } else if (m_computePipeline->prepareAccumulationFrame()) {
+    // A failed refinement leaves the previous image on screen
+    computeFractalImage(true);
+  }
+}
+
+/**
+ * @brief Compute the fractal and copy it into the display texture
+ *
+ * Called with new parameters when they changed; when maxIterations is the
+ * only thing that grew, the compute pipeline resumes the stored orbits
+ * instead of starting every pixel from scratch. On still frames it is
+ * called with accumulateOnly after prepareAccumulationFrame(). Only called
+ * while no earlier dispatch is in flight.
+ *
+ * @return true if the dispatch was submitted (and, without timeline
+ *         semaphores, the texture now holds the current image)
+ */
+bool VulkanApplication::computeFractalImage(bool accumulateOnly) {
+  uint32_t renderWidth = 0;
+  uint32_t renderHeight = 0;
+  m_computePipeline->getRenderExtent(renderWidth, renderHeight);
+
+  // Update fractal parameters
+  if (!accumulateOnly) {
+    FractalParameters params{};
+    params.centerX = m_fractalParams.centerX;
+    params.centerY = m_fractalParams.centerY;
+    params.zoom = m_fractalParams.zoom;
+    params.maxIterations = m_fractalParams.maxIterations;
+    params.imageWidth = renderWidth;
+    params.imageHeight = renderHeight;
+    params.colorScale = m_fractalParams.colorScale;
+    params.fractalType = m_fractalParams.fractalType;
+    params.aaMaxSamples = m_fractalParams.antiAliasingSamples;
+
+    m_computePipeline->updateFractalParameters(params);
+  }
+
+  // An image landed early on a shared queue leaves its dispatch pending
+  m_frameGraph->wait(QueueType::COMPUTE,
+                     m_frameGraph->getSubmittedValue(QueueType::COMPUTE));
+
+  std::shared_ptr<BufferInfo> fractalBuffer =
+      m_computePipeline->getFractalOutputBuffer();
+  if (!fractalBuffer || fractalBuffer->buffer == VK_NULL_HANDLE) {
+    std::cerr << "VulkanApplication: No fractal output buffer available!"
+              << std::endl;
+    return false;
+  }
+  m_frameGraph->setBuffer(m_outputResource, fractalBuffer->buffer);
+
+  // The graph orders the dispatch after the previous copy's reads
+  uint32_t pass = accumulateOnly ? m_accumulatePass : m_fractalPass;
+  const FrameGraph::PassBarriers &barriers = m_frameGraph->beginPass(pass);
+
+  VkCommandBuffer computeCmd = m_computeCommandBuffer;
+  if (accumulateOnly) {
+    // Still frames resubmit the same pass until something it reads changes
+    computeCmd = m_accumulateCommands.commandBuffer;
+    std::vector<uint64_t> accumulateKey = {
+        m_computePipeline->getRecordingVersion()};
+    barriers.appendKey(accumulateKey);
+    if (!recordCommands(m_accumulateCommands, std::move(accumulateKey),
+                        [&](VkCommandBuffer commandBuffer) {
+                          barriers.record(commandBuffer);
+                          m_computePipeline->recordAccumulationPass(
+                              commandBuffer);
+                        })) {
+      return false;
+    }
+  } else {
+    // New parameters are pushed inline, so full renders are recorded anew
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(computeCmd, &beginInfo);
+    barriers.record(computeCmd);
+
+    // Dispatch fractal computation; only full renders are timed, refinement
+    // frames would skew the governor's cost estimate
+    bool timed = m_gpuTimer->isSupported();
+    if (timed) {
+      m_timedRenderScale =
+          static_cast<float>(renderWidth) / static_cast<float>(m_fractalWidth);
+      m_gpuTimer->begin(computeCmd);
+    }
+    m_computePipeline->dispatchFractalCompute(computeCmd);
+    if (timed) {
+      m_gpuTimer->end(computeCmd);
+    }
+
+    vkEndCommandBuffer(computeCmd);
+  }
+  m_frameGraph->endPass(pass, computeCmd);
+
+  InFlightCompute inFlight{.frame = m_frameNumber,
+                           .width = renderWidth,
+                           .height = renderHeight,
+                           .accumulateOnly = accumulateOnly,
+                           .submitTime = std::chrono::steady_clock::now()};
+
+  // Submit compute work
+  if (!m_frameGraph->submit(QueueType::COMPUTE)) {
+    return false;
+  }
+  inFlight.timelineValue = m_frameGraph->getSubmittedValue(QueueType::COMPUTE);
+  m_inFlightCompute = inFlight;
+
+  // Landed by pollComputeImage() on a later frame; without timeline
+  // semaphores nothing would ever report it finished, so wait here
+  if (!m_frameGraph->hasTimelineSemaphores()) {
+    return waitForComputeImage();
+  }
+  return true;
+}
+
+bool VulkanApplication::landComputeImage(bool finished) {
+  InFlightCompute inFlight = *m_inFlightCompute;
+  m_inFlightCompute.reset();
+
+  // Without timestamp support the wall time until landing is the
+  // measurement; with async compute it may include up to a frame of polling
+  if (finished && !inFlight.accumulateOnly && !m_gpuTimer->isSupported()) {
+    m_lastComputeTime = elapsedMilliseconds(inFlight.submitTime);
+    m_resolutionGovernor->reportComputeTime(
+        m_lastComputeTime, static_cast<float>(inFlight.width) /
+                               static_cast<float>(m_fractalWidth));
+  }
+
+  // Phase 4: Copy compute buffer to texture for graphics rendering
+  if (!m_textureManager || !m_textureManager->isTextureReady()) {
+    std::cerr
+        << "VulkanApplication: Texture manager not ready, skipping frame..."
+        << std::endl;
+    return false;
+  }
+
+  // Get the fractal output buffer from compute pipeline
+  std::shared_ptr<BufferInfo> fractalBuffer =
+      m_computePipeline->getFractalOutputBuffer();
+  if (!fractalBuffer || fractalBuffer->buffer == VK_NULL_HANDLE) {
+    std::cerr << "VulkanApplication: No fractal output buffer available!"
+              << std::endl;
+    return false;
+  }
+  m_frameGraph->setBuffer(m_outputResource, fractalBuffer->buffer);
+  m_frameGraph->setImage(m_textureResource,
+                         m_textureManager->getTextureImage());
+
+  // The graph waits for the compute submission and moves the texture into
+  // TRANSFER_DST; the draw pass moves it on to SHADER_READ_ONLY
+  const FrameGraph::PassBarriers &barriers =
+      m_frameGraph->beginPass(m_copyPass);
+
+  // Take the next copy command buffer once its last batch has finished
+  m_copyIndex = (m_copyIndex + 1) % m_copyCommands.size();
+  RecordedCommands &copyCommands = m_copyCommands[m_copyIndex];
+  m_frameGraph->wait(QueueType::GRAPHICS, m_copyValues[m_copyIndex]);
+
+  // Record buffer-to-texture copy commands; kept while the output buffer,
+  // texture, extent of the landed image and barriers stay the same
+  std::vector<uint64_t> copyKey = {
+      reinterpret_cast<uint64_t>(fractalBuffer->buffer),
+      reinterpret_cast<uint64_t>(m_textureManager->getTextureImage()),
+      inFlight.width, inFlight.height};
+  barriers.appendKey(copyKey);
+  bool copyRecorded = recordCommands(
+      copyCommands, std::move(copyKey), [&](VkCommandBuffer commandBuffer) {
+        barriers.record(commandBuffer);
+        m_textureManager->copyBufferToTexture(commandBuffer,
+                                              fractalBuffer->buffer,
+                                              inFlight.width, inFlight.height);
+      });
+  if (!copyRecorded) {
+    return false;
+  }
+
+  // Submitted with the next draw; only scheduled once the dispatch is
+  // known to be done, so the graphics queue never stalls behind compute
+  m_frameGraph->endPass(m_copyPass, copyCommands.commandBuffer);
+  m_copyValues[m_copyIndex] =
+      m_frameGraph->getSubmittedValue(QueueType::GRAPHICS) + 1;
+  m_displayedWidth = inFlight.width;
+  m_displayedHeight = inFlight.height;
+
+  // Stretch the rendered region over the window
+  if (m_graphicsPipeline) {
+    m_graphicsPipeline->setDisplayRegion(inFlight.width, inFlight.height,
+                                         m_fractalWidth, m_fractalHeight);
+  }
+
+  return true;
+}
+
+void VulkanApplication::pollComputeImage() {
+  if (!m_inFlightCompute) {
+    return;
+  }
+
+  // On one shared queue the copy runs after the dispatch in submission
+  // order, so waiting for it to finish would only add a frame of latency
+  bool finished = m_frameGraph->isComplete(QueueType::COMPUTE,
+                                           m_inFlightCompute->timelineValue);
+  if (finished || m_vulkanSetup->getComputeQueue() ==
+                      m_vulkanSetup->getGraphicsQueue()) {
+    landComputeImage(finished);
+  }
+}
+
+bool VulkanApplication::waitForComputeImage() {
+  // Covers an image that landed unfinished on a shared queue as well
+  m_frameGraph->wait(QueueType::COMPUTE,
+                     m_frameGraph->getSubmittedValue(QueueType::COMPUTE));
+  if (!m_inFlightCompute) {
+    return true;
+  }
+
+  return landComputeImage();
+}
+
+bool VulkanApplication::fitResolutionToBudget(uint32_t &width,
+                                              uint32_t &height) {
+  if (!m_memoryManager || !m_computePipeline) {
+    return true;
+  }
+
+  // Compute buffers plus the RGBA8 display texture
+  auto requiredBytes = [this](uint32_t w, uint32_t h) {
+    return m_computePipeline->estimateMemoryUsage(w, h) +
+           static_cast<VkDeviceSize>(w) * h * 4;
+  };
+
+  // The current resolution's resources are released when it is replaced
+  VkDeviceSize current = requiredBytes(m_fractalWidth, m_fractalHeight);
+  VkDeviceSize required = requiredBytes(width, height);
+  VkDeviceSize available =
+      m_memoryManager->getAvailableMemory(MemoryLocation::GPU_ONLY) + current;
+  if (required <= available) {
+    return true;
+  }
+
+  m_memoryManager->trimCaches();
+  available =
+      m_memoryManager->getAvailableMemory(MemoryLocation::GPU_ONLY) + current;
+  if (required <= available) {
+    return true;
+  }
+
+  // Memory grows with the pixel count, so scale both sides by the root
+  double scale = std::sqrt(static_cast<double>(available) / required);
+  uint32_t fittedWidth = std::max(
+      MIN_FRACTAL_DIMENSION, static_cast<uint32_t>(width * scale) & ~7u);
+  uint32_t fittedHeight = std::max(
+      MIN_FRACTAL_DIMENSION, static_cast<uint32_t>(height * scale) & ~7u);
+
+  std::cerr << "VulkanApplication: " << width << "x" << height
+            << " exceeds the memory budget ("
+            << (required / (1024 * 1024)) << " MB needed, "
+            << (available / (1024 * 1024)) << " MB available), using "
+            << fittedWidth << "x" << fittedHeight << std::endl;
+
+  width = fittedWidth;
+  height = fittedHeight;
+  return false;
+}
+
+bool VulkanApplication::resizeFractalImage(uint32_t width, uint32_t height) {
+  auto start = std::chrono::steady_clock::now();
+
+  // Land a dispatch still in flight into the old texture. The frame graph
+  // makes that copy wait for it on the GPU, so the frame covering the copy
+  // also covers the compute's use of the buffers replaced below.
+  if (m_inFlightCompute) {
+    landComputeImage(false);
+  }
+
+  if (!m_computePipeline->resizeFractalImage(width, height)) {
+    return false;
+  }
+
+  // The display gets a fresh descriptor set, frames in flight keep theirs
+  if (!m_textureManager->resizeFractalTexture(width, height) ||
+      !m_graphicsPipeline->updateFractalTexture(
+          m_textureManager->getTextureImageView(),
+          m_textureManager->getTextureSampler())) {
+    std::cerr << "VulkanApplication: Failed to resize fractal texture to "
+              << width << "x" << height << std::endl;
+
+    // Keep compute and display sizes consistent
+    m_computePipeline->resizeFractalImage(m_fractalWidth, m_fractalHeight);
+    if (m_textureManager->resizeFractalTexture(m_fractalWidth,
+                                               m_fractalHeight)) {
+      m_graphicsPipeline->updateFractalTexture(
+          m_textureManager->getTextureImageView(),
+          m_textureManager->getTextureSampler());
+    }
+    return false;
+  }
+
+  std::cout << "VulkanApplication: Resized fractal image to " << width << "x"
+            << height << " in " << elapsedMilliseconds(start) << " ms"
+            << std::endl;
+  return true;
+}
+
+void VulkanApplication::checkMemoryPressure() {
+  if (!m_memoryManager || !m_memoryManager->isNearBudget()) {
+    return;
+  }
+
+  m_memoryManager->trimCaches();
+  if (!m_memoryManager->isNearBudget() || !m_computePipeline) {
+    return;
+  }
+
+  // Still tight: trade refinement features for memory
+  waitForComputeImage();
+  if (m_computePipeline->reduceMemoryFootprint()) {
+    m_guiParams.temporalAccumulation = false;
+    std::cerr << "VulkanApplication: Near the memory budget, disabled orbit "
+              << "resume and temporal accumulation" << std::endl;
+  }
+}
+
+void VulkanApplication::requestImageExport() {
+  std::string path =
+      "fractal_export_" + std::to_string(++m_exportCounter) + ".ppm";
+  auto requestTime = std::chrono::steady_clock::now();
+
+  // Unified memory: once the in-flight dispatch has landed, the mapped
+  // output holds the finished image and needs no copy at all
+  waitForComputeImage();
+
+  // The image on screen may be a dynamic-resolution render
+  uint32_t width = m_displayedWidth;
+  uint32_t height = m_displayedHeight;
+  if (width == 0 || height == 0) {
+    std::cerr << "VulkanApplication: No fractal image to export yet"
+              << std::endl;
+    return;
+  }
+
+  if (const uint32_t *pixels = m_computePipeline->getMappedFractalData()) {
+    if (writeImagePPM(path, pixels, width, height)) {
+      std::cout << "VulkanApplication: Exported " << path
+                << " in place (zero-copy, "
+                << elapsedMilliseconds(requestTime) << " ms)" << std::endl;
+    }
+    return;
+  }
+
+  // The readback runs behind the frame; the file is written once it lands
+  PendingExport pending{
+      .pixels = m_computePipeline->readFractalDataAsync(
+          m_computeCommandPool, m_vulkanSetup->getComputeQueue()),
+      .width = width,
+      .height = height,
+      .path = path,
+      .requestTime = requestTime};
+  m_pendingExports.push_back(std::move(pending));
+
+  std::cout << "VulkanApplication: Exporting image to " << path << "..."
+            << std::endl;
+}
+
+void VulkanApplication::processPendingExports() {
+  for (auto it = m_pendingExports.begin(); it != m_pendingExports.end();) {
+    if (it->pixels.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
+    try {
+      std::vector<uint32_t> pixels = it->pixels.get();
+      double readbackMs = elapsedMilliseconds(it->requestTime);
+      if (writeImagePPM(it->path, pixels.data(), it->width, it->height)) {
+        std::cout << "VulkanApplication: Exported " << it->path
+                  << " (staged readback " << readbackMs << " ms)"
+                  << std::endl;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "VulkanApplication: Image export failed: " << e.what()
+                << std::endl;
+    }
+
+    it = m_pendingExports.erase(it);
+  }
+}
+
+/**
+ * @brief Retire deferred deletions of every frame the GPU has finished
+ *
+ * Submissions on the graphics queue complete in order, so the newest
+ * signalled fence covers every earlier frame. A dispatch on the compute
+ * queue is only known to be done once it has landed, so while one is in
+ * flight nothing from its frame onwards is retired.
+ */
+void VulkanApplication::retireCompletedFrames() {
+  for (const FrameSync &sync : m_frameSync) {
+    if (sync.frame > m_completedFrame &&
+        vkGetFenceStatus(m_vulkanSetup->getDevice(), sync.fence) ==
+            VK_SUCCESS) {
+      m_completedFrame = sync.frame;
+    }
+  }
+
+  uint64_t retiredFrame = m_completedFrame;
+  if (m_inFlightCompute) {
+    retiredFrame = std::min(retiredFrame, m_inFlightCompute->frame - 1);
+  }
+
+  DeletionQueue &deletionQueue = m_memoryManager->getDeletionQueue();
+  deletionQueue.retire(retiredFrame);
+  deletionQueue.beginFrame(++m_frameNumber);
+}
+
+/**
+ * @brief Get the frame fence slot for the next graphics submission
+ */
+VulkanApplication::FrameSync &VulkanApplication::acquireFrameSync() {
+  FrameSync &sync = m_frameSync[m_frameNumber % m_frameSync.size()];
+  if (sync.frame != 0) {
+    VkDevice device = m_vulkanSetup->getDevice();
+    vkWaitForFences(device, 1, &sync.fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(device, 1, &sync.fence);
+    m_completedFrame = std::max(m_completedFrame, sync.frame);
+    sync.frame = 0;
+  }
+  return sync;
+}
+
+/**
+ * @brief Wait for the fence of one earlier frame
+ */
+void VulkanApplication::waitForFrame(uint64_t frame) {
+  if (frame <= m_completedFrame) {
+    return;
+  }
+
+  // Slots are only reused after their fence was waited for, so an unfinished
+  // frame still has its slot
+  for (const FrameSync &sync : m_frameSync) {
+    if (sync.frame == frame) {
+      vkWaitForFences(m_vulkanSetup->getDevice(), 1, &sync.fence, VK_TRUE,
+                      UINT64_MAX);
+      m_completedFrame = frame;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Consume the acquire semaphore of a frame that will not be drawn
+ */
+void VulkanApplication::skipAcquiredFrame(FrameSync &sync) {
+  if (m_frameGraph->submit(QueueType::GRAPHICS, sync.fence,
+                           sync.imageAvailable,
+                           VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT)) {
+    sync.frame = m_frameNumber;
+  }
+}
+
+/**
+ * @brief Record a kept command buffer if what it depends on changed
+ *
+ * Kept command buffers are begun without ONE_TIME_SUBMIT and resubmitted
+ * as long as the key matches; the versions in the key change whenever a
+ * pipeline, descriptor set, parameter block or extent the commands
+ * reference is replaced.
+ */
+bool VulkanApplication::recordCommands(
+    RecordedCommands &commands, std::vector<uint64_t> key,
+    const std::function<void(VkCommandBuffer)> &record,
+    const VkCommandBufferInheritanceInfo *inheritance) {
+  if (!commands.key.empty() && commands.key == key) {
+    return true;
+  }
+  commands.key.clear();
+
+  VkCommandBufferBeginInfo beginInfo{};
+  beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  if (inheritance) {
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = inheritance;
+  }
+
+  VkResult result = vkBeginCommandBuffer(commands.commandBuffer, &beginInfo);
+  if (result == VK_SUCCESS) {
+    record(commands.commandBuffer);
+    result = vkEndCommandBuffer(commands.commandBuffer);
+  }
+  if (result != VK_SUCCESS) {
+    std::cerr << "VulkanApplication: Failed to record command buffer! Error: "
+              << result << std::endl;
+    return false;
+  }
+
+  commands.key = std::move(key);
+  m_commandRecordings++;
+  return true;
+}
+
+/**
+ * @brief Allocate primary or secondary command buffers
+ */
+std::vector<VkCommandBuffer>
+VulkanApplication::allocateCommandBuffers(VkCommandPool commandPool,
+                                          VkCommandBufferLevel level,
+                                          uint32_t count) {
+  VkCommandBufferAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocInfo.commandPool = commandPool;
+  allocInfo.level = level;
+  allocInfo.commandBufferCount = count;
+
+  std::vector<VkCommandBuffer> commandBuffers(count);
+  VkResult result = vkAllocateCommandBuffers(
+      m_vulkanSetup->getDevice(), &allocInfo, commandBuffers.data());
+  if (result != VK_SUCCESS) {
+    throw std::runtime_error(
+        "Failed to allocate command buffers! Vulkan error: " +
+        std::to_string(result));
+  }
+  return commandBuffers;
+}
+
 /**
  * @brief Update application state for the current frame
  *
@@ -729,8 +1462,15 @@ void VulkanApplication::renderFrame() {
  * @param deltaTime Time elapsed since the last frame (in seconds)
  */
 void VulkanApplication::updateApplication(double deltaTime) {
-  // Silence unused parameter warning for Phase 1
-  (void)deltaTime;
+  // Return to full resolution once the view has settled
+  m_resolutionGovernor->advance(deltaTime);
+
+  // Budgets change as other applications allocate, so poll them
+  m_memoryCheckTimer += deltaTime;
+  if (m_memoryCheckTimer >= MEMORY_CHECK_INTERVAL) {
+    m_memoryCheckTimer = 0.0;
+    checkMemoryPressure();
+  }
 
   // Fractal parameter updates implemented - real-time GUI controls
   // Parameters are synchronized between GUI and compute pipeline
@@ -34,7 +34,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
@@ -50,6 +54,10 @@ class SwapchainManager;
 class GraphicsPipeline;
 class TextureManager;
 class GuiManager;
+class GpuTimer;
+class PipelineCache;
+class ResolutionGovernor;
+class FrameGraph;
 
 /**
  * @class VulkanApplication
@@ -185,6 +193,181 @@ private:
    */
   void renderFrame();
 
+  /**
+   * @brief Start this frame's compute work, if any
+   *
+   * A full render when parameters changed, otherwise a temporal refinement
+   * until the image has converged. Nothing is started while a dispatch is
+   * in flight. Called after the graphics submission, so a copy landed this
+   * frame goes out with the draw and the dispatch waits for that batch.
+   */
+  void dispatchFractalWork();
+
+  /**
+   * @brief Dispatch the fractal compute shader and update the display texture
+   *
+   * With timeline semaphores the dispatch is only submitted; the texture is
+   * updated by landComputeImage() once the compute queue has finished, and
+   * until then the previous image stays on screen.
+   *
+   * @param accumulateOnly Add a temporal sample to the current image instead
+   *                       of uploading new parameters
+   * @return true on success, false if the frame should be skipped
+   */
+  bool computeFractalImage(bool accumulateOnly = false);
+
+  /**
+   * @brief Copy a finished compute image into the display texture
+   *
+   * Adds the copy to the graphics batch, which the frame graph makes wait
+   * for the compute submission, and clears the in-flight compute.
+   *
+   * @param finished Whether the dispatch is known to be done; only then is
+   *                 the time since submission a measurement of it
+   * @return true if the texture now holds the computed image
+   */
+  bool landComputeImage(bool finished = true);
+
+  /**
+   * @brief Land the in-flight compute image if the compute queue finished
+   *
+   * When compute and graphics share one queue the copy is queued behind the
+   * dispatch anyway, so the image lands on the next frame regardless.
+   */
+  void pollComputeImage();
+
+  /**
+   * @brief Block until the in-flight compute image has landed
+   *
+   * Needed before anything replaces or reads the compute buffers outside
+   * the deletion queue (memory trimming, zero-copy export). Also
+   * waits for a dispatch whose image already landed on a shared queue.
+   *
+   * @return true if nothing was in flight or the image landed
+   */
+  bool waitForComputeImage();
+
+  /**
+   * @brief Shrink a requested fractal resolution until it fits in memory
+   *
+   * Keeps the aspect ratio. Caches are trimmed before giving up on the
+   * requested size.
+   *
+   * @param width Requested width, replaced by the width that fits
+   * @param height Requested height, replaced by the height that fits
+   * @return true if the requested resolution fit unchanged
+   */
+  bool fitResolutionToBudget(uint32_t &width, uint32_t &height);
+
+  /**
+   * @brief Resize the compute buffers and display texture in place
+   *
+   * Pipelines are kept; replaced resources are freed through the deletion
+   * queue once in-flight frames retire.
+   *
+   * @param width New fractal width
+   * @param height New fractal height
+   * @return true if both the compute pipeline and texture were resized
+   */
+  bool resizeFractalImage(uint32_t width, uint32_t height);
+
+  /**
+   * @brief Release memory when a heap is close to its budget
+   *
+   * Trims caches first, then drops optional per-pixel buffers.
+   */
+  void checkMemoryPressure();
+
+  /**
+   * @brief Start reading back the displayed image for export
+   */
+  void requestImageExport();
+
+  /**
+   * @brief Write every export whose readback has completed to disk
+   */
+  void processPendingExports();
+
+  /**
+   * @struct RecordedCommands
+   * @brief Command buffer kept across frames and the state it was recorded for
+   */
+  struct RecordedCommands {
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    std::vector<uint64_t> key; ///< State at recording time, empty = stale
+  };
+
+  /**
+   * @brief Record a kept command buffer again if its state changed
+   *
+   * @param commands Command buffer and the key of its current recording
+   * @param key Versions and handles the commands depend on (non-empty)
+   * @param record Records the commands between begin and end
+   * @param inheritance Render pass state for secondary command buffers
+   * @return true if the command buffer can be submitted (or executed)
+   */
+  bool recordCommands(RecordedCommands &commands, std::vector<uint64_t> key,
+                      const std::function<void(VkCommandBuffer)> &record,
+                      const VkCommandBufferInheritanceInfo *inheritance =
+                          nullptr);
+
+  /**
+   * @brief Allocate command buffers from one of the application's pools
+   *
+   * @param commandPool Pool to allocate from
+   * @param level Primary or secondary
+   * @param count Number of command buffers
+   * @return Allocated command buffers
+   *
+   * @throws std::runtime_error If allocation fails
+   */
+  std::vector<VkCommandBuffer> allocateCommandBuffers(VkCommandPool commandPool,
+                                                      VkCommandBufferLevel level,
+                                                      uint32_t count);
+
+  /**
+   * @struct FrameSync
+   * @brief Fence of one recent graphics submission
+   */
+  struct FrameSync {
+    VkFence fence = VK_NULL_HANDLE;
+    VkSemaphore imageAvailable = VK_NULL_HANDLE; ///< Swapchain acquire
+    uint64_t frame = 0; ///< Frame the fence was submitted with, 0 = idle
+  };
+
+  /**
+   * @brief Poll frame fences, run deletions of finished frames and start
+   *        the next frame
+   */
+  void retireCompletedFrames();
+
+  /**
+   * @brief Get the fence slot for this frame's graphics submission
+   *
+   * Waits only if the GPU is more than FRAMES_IN_FLIGHT frames behind.
+   *
+   * @return Slot with an unsignalled fence; set its frame once submitted
+   */
+  FrameSync &acquireFrameSync();
+
+  /**
+   * @brief Block until the graphics submission of a frame has finished
+   *
+   * @param frame Frame number; frames already known finished return at once
+   */
+  void waitForFrame(uint64_t frame);
+
+  /**
+   * @brief Give up on a frame after its swapchain image was acquired
+   *
+   * Submits whatever the graph collected together with a wait on the
+   * slot's acquire semaphore, so the semaphore is unsignalled again by the
+   * time the slot's fence lets it be reused.
+   *
+   * @param sync Slot from acquireFrameSync() used for the acquire
+   */
+  void skipAcquiredFrame(FrameSync &sync);
+
   /**
    * @brief Update application state
    *
@@ -275,6 +458,43 @@ private:
    */
   std::shared_ptr<GuiManager> m_guiManager;
 
+  /**
+   * @brief Driver pipeline cache shared by every pipeline
+   *
+   * Loaded from disk at startup and saved at shutdown, so warm starts skip
+   * driver shader compilation.
+   */
+  std::shared_ptr<PipelineCache> m_pipelineCache;
+
+  /**
+   * @brief GPU timestamps around the fractal dispatch
+   *
+   * Feeds measured compute times to the resolution governor.
+   */
+  std::unique_ptr<GpuTimer> m_gpuTimer;
+
+  /**
+   * @brief Dynamic resolution controller
+   *
+   * Lowers the render scale while the view changes so that each render
+   * stays within the target frame time.
+   */
+  std::unique_ptr<ResolutionGovernor> m_resolutionGovernor;
+
+  /**
+   * @brief Orders the compute, copy and draw passes
+   *
+   * Derives their barriers and layout transitions, links the compute and
+   * graphics queues and batches each queue's passes into one submission.
+   */
+  std::unique_ptr<FrameGraph> m_frameGraph;
+  uint32_t m_outputResource = 0;  ///< Fractal output buffer
+  uint32_t m_textureResource = 0; ///< Display texture
+  uint32_t m_fractalPass = 0;     ///< Full render (compute)
+  uint32_t m_accumulatePass = 0;  ///< Temporal sample (compute)
+  uint32_t m_copyPass = 0;        ///< Output buffer to texture (graphics)
+  uint32_t m_drawPass = 0;        ///< Fractal draw and GUI (graphics)
+
   // Application state
 
   /**
@@ -305,10 +525,18 @@ private:
   /**
    * @brief Command buffer for compute operations
    *
-   * Pre-allocated command buffer for fractal computation.
+   * Pre-allocated command buffer for fractal computation. Full renders are
+   * recorded into it once per parameter change.
    */
   VkCommandBuffer m_computeCommandBuffer;
 
+  /**
+   * @brief Temporal accumulation pass, resubmitted on every still frame
+   *
+   * Keyed by the compute pipeline's recording version.
+   */
+  RecordedCommands m_accumulateCommands;
+
   // Phase 3: Graphics pipeline resources
 
   /**
@@ -319,12 +547,77 @@ private:
   VkCommandPool m_graphicsCommandPool;
 
   /**
-   * @brief Command buffers for graphics operations (one per frame)
+   * @brief Command buffers for graphics operations (one per swapchain image)
    *
-   * Pre-allocated command buffers for graphics rendering.
+   * Re-recorded every frame around the kept fractal draw, since they carry
+   * the barriers the frame graph derives for the draw pass.
    */
   std::vector<VkCommandBuffer> m_graphicsCommandBuffers;
 
+  /**
+   * @brief Secondary command buffers drawing the fractal, one per image
+   *
+   * Executed inside the render pass next to the GUI overlay, if any.
+   */
+  std::vector<RecordedCommands> m_fractalDrawCommands;
+
+  /**
+   * @brief Secondary command buffers for the GUI overlay, one per image
+   */
+  std::vector<VkCommandBuffer> m_guiCommandBuffers;
+
+  /**
+   * @brief Frame whose graphics submission last used each image's command
+   *        buffers; they are only recorded again once its fence signalled
+   */
+  std::vector<uint64_t> m_imageFrames;
+
+  /**
+   * @brief Signalled by each image's graphics submission, waited for by its
+   *        presentation
+   */
+  std::vector<VkSemaphore> m_renderFinishedSemaphores;
+
+  /**
+   * @brief Buffer-to-texture copies, used in turn and each resubmitted while
+   *        buffer, texture and render extent stay the same
+   *
+   * A copy may leave in any graphics batch, not only a fenced frame, so
+   * reuse waits for the graphics timeline value it was submitted with.
+   */
+  std::vector<RecordedCommands> m_copyCommands;
+  std::vector<uint64_t> m_copyValues; ///< Graphics batch of each copy
+  size_t m_copyIndex = 0;             ///< Copy command buffer used last
+  uint64_t m_commandRecordings = 0; ///< Kept command buffers recorded so far
+
+  /**
+   * @brief Compute work submitted but not yet copied to the texture
+   *
+   * Captures what the copy and the display region need, since the render
+   * extent may change while the compute queue is still busy.
+   */
+  struct InFlightCompute {
+    uint64_t timelineValue = 0; ///< Compute submission of the dispatch
+    uint64_t frame = 0;         ///< Frame the dispatch was submitted in
+    uint32_t width = 0;         ///< Render extent of the dispatch
+    uint32_t height = 0;
+    bool accumulateOnly = false;
+    std::chrono::steady_clock::time_point submitTime;
+  };
+
+  std::optional<InFlightCompute> m_inFlightCompute;
+  uint32_t m_displayedWidth = 0;  ///< Render extent of the landed image
+  uint32_t m_displayedHeight = 0;
+
+  /**
+   * @brief Fences of recent graphics submissions
+   *
+   * Tell the deletion queue which frames the GPU has finished.
+   */
+  std::vector<FrameSync> m_frameSync;
+  uint64_t m_frameNumber = 0;    ///< Frame being recorded
+  uint64_t m_completedFrame = 0; ///< Newest frame finished on the GPU
+
   /**
    * @brief Current fractal parameters
    *
@@ -337,6 +630,7 @@ private:
     uint32_t maxIterations = 100; ///< Maximum iterations
     float colorScale = 1.0f;      ///< Color scaling factor
     uint32_t fractalType = 0; ///< Fractal type (0=Mandelbrot, 1=Julia, etc.)
+    uint32_t antiAliasingSamples = 0; ///< Adaptive AA sample cap (0 = off)
   } m_fractalParams;
 
   /**
@@ -353,6 +647,10 @@ private:
     uint32_t maxIterations = 100;
     float colorScale = 1.0f;
     uint32_t fractalType = 0;
+    uint32_t antiAliasingSamples = 0;
+    bool temporalAccumulation = true;
+    bool dynamicResolution = true;
+    float targetFrameTime = 33.0f; ///< Compute time target in milliseconds
     bool parametersChanged = true;
     bool needsRecompute = true;
   } m_guiParams;
@@ -363,6 +661,25 @@ private:
   uint32_t m_fractalWidth = 800;
   uint32_t m_fractalHeight = 600;
 
+  /**
+   * @brief Image export waiting for its GPU readback
+   */
+  struct PendingExport {
+    std::future<std::vector<uint32_t>> pixels;
+    uint32_t width;
+    uint32_t height;
+    std::string path;
+    std::chrono::steady_clock::time_point requestTime; ///< For timing logs
+  };
+
+  double m_memoryCheckTimer = 0.0; ///< Seconds since the last budget check
+
+  float m_timedRenderScale = 1.0f; ///< Render scale of the timed dispatch
+  double m_lastComputeTime = 0.0;  ///< Newest measured compute time (ms)
+
+  std::vector<PendingExport> m_pendingExports; ///< Readbacks in flight
+  uint32_t m_exportCounter = 0;                ///< Numbers export files
+
   //  Fractal computation state implemented
   // Parameters, zoom, center position, iteration count all working via GUI
 
@@ -168,6 +168,18 @@ void VulkanSetup::createInstance() {
 
   // Get required extensions (GLFW + debug)
   auto extensions = getRequiredExtensions();
+
+  // Optional: needed on Vulkan 1.0 to query VK_EXT_memory_budget
+  for (const auto &availableExt : availableExtensions) {
+    if (strcmp(availableExt.extensionName,
+               VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) {
+      extensions.push_back(
+          VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+      m_properties2Enabled = true;
+      break;
+    }
+  }
+
   createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
   createInfo.ppEnabledExtensionNames = extensions.data();
 
@@ -398,10 +410,49 @@ void VulkanSetup::createLogicalDevice() {
   createInfo.pQueueCreateInfos = queueCreateInfos.data();
   createInfo.pEnabledFeatures = &deviceFeatures;
 
-  // Enable device extensions
+  // Enable device extensions, plus the optional ones the device offers
+  std::vector<const char *> enabledExtensions = m_deviceExtensions;
+  m_memoryBudgetEnabled =
+      m_properties2Enabled &&
+      isDeviceExtensionAvailable(m_physicalDevice,
+                                 VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  if (m_memoryBudgetEnabled) {
+    enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  }
+  std::cout << "VulkanSetup: VK_EXT_memory_budget "
+            << (m_memoryBudgetEnabled ? "enabled" : "not available")
+            << std::endl;
+
+  // Timeline semaphores let compute hand its image to graphics without a
+  // CPU wait; the extension alone is not enough, the feature must be on
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures{};
+  timelineFeatures.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+  if (m_properties2Enabled &&
+      isDeviceExtensionAvailable(m_physicalDevice,
+                                 VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+    auto getFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+        vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceFeatures2KHR"));
+    if (getFeatures2) {
+      VkPhysicalDeviceFeatures2KHR features2{};
+      features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+      features2.pNext = &timelineFeatures;
+      getFeatures2(m_physicalDevice, &features2);
+    }
+  }
+  m_timelineSemaphoreEnabled = timelineFeatures.timelineSemaphore == VK_TRUE;
+  if (m_timelineSemaphoreEnabled) {
+    enabledExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    timelineFeatures.pNext = nullptr;
+    createInfo.pNext = &timelineFeatures;
+  }
+  std::cout << "VulkanSetup: VK_KHR_timeline_semaphore "
+            << (m_timelineSemaphoreEnabled ? "enabled" : "not available")
+            << std::endl;
+
   createInfo.enabledExtensionCount =
-      static_cast<uint32_t>(m_deviceExtensions.size());
-  createInfo.ppEnabledExtensionNames = m_deviceExtensions.data();
+      static_cast<uint32_t>(enabledExtensions.size());
+  createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
   // Validation layers (for compatibility with older Vulkan implementations)
   if (m_enableValidationLayers) {
@@ -436,6 +487,10 @@ void VulkanSetup::createLogicalDevice() {
             << m_queueFamilies.computeFamily.value() << std::endl;
   std::cout << "  Present queue family: "
             << m_queueFamilies.presentFamily.value() << std::endl;
+  if (hasDedicatedComputeQueue()) {
+    std::cout << "VulkanSetup: Compute runs on its own queue family"
+              << std::endl;
+  }
 }
 
 /**
@@ -620,6 +675,11 @@ QueueFamilyIndices VulkanSetup::findQueueFamilies(VkPhysicalDevice device) {
   std::cout << "VulkanSetup: Found " << queueFamilyCount << " queue families"
             << std::endl;
 
+  // Compute prefers a family without graphics so the fractal can run next
+  // to rendering; otherwise it shares the graphics family
+  std::optional<uint32_t> dedicatedComputeFamily;
+  std::optional<uint32_t> anyComputeFamily;
+
   int i = 0;
   for (const auto &queueFamily : queueFamilies) {
     std::cout << "VulkanSetup: Queue family " << i << ": ";
@@ -632,7 +692,11 @@ QueueFamilyIndices VulkanSetup::findQueueFamilies(VkPhysicalDevice device) {
 
     // Check for compute support
     if (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) {
-      indices.computeFamily = i;
+      anyComputeFamily = i;
+      if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+          !dedicatedComputeFamily.has_value()) {
+        dedicatedComputeFamily = i;
+      }
       std::cout << "COMPUTE ";
     }
 
@@ -655,6 +719,16 @@ QueueFamilyIndices VulkanSetup::findQueueFamilies(VkPhysicalDevice device) {
     i++;
   }
 
+  if (dedicatedComputeFamily.has_value()) {
+    indices.computeFamily = dedicatedComputeFamily;
+  } else if (indices.graphicsFamily.has_value() &&
+             (queueFamilies[indices.graphicsFamily.value()].queueFlags &
+              VK_QUEUE_COMPUTE_BIT)) {
+    indices.computeFamily = indices.graphicsFamily;
+  } else {
+    indices.computeFamily = anyComputeFamily;
+  }
+
   return indices;
 }
 
@@ -691,6 +765,24 @@ bool VulkanSetup::checkDeviceExtensionSupport(VkPhysicalDevice device) {
   return true;
 }
 
+bool VulkanSetup::isDeviceExtensionAvailable(VkPhysicalDevice device,
+                                             const char *extensionName) {
+  uint32_t extensionCount;
+  vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount,
+                                       nullptr);
+
+  std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+  vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount,
+                                       availableExtensions.data());
+
+  for (const auto &extension : availableExtensions) {
+    if (strcmp(extensionName, extension.extensionName) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::vector<const char *> VulkanSetup::getRequiredExtensions() {
   // Get required extensions from GLFW
   uint32_t glfwExtensionCount = 0;
@@ -186,6 +186,28 @@ public:
    */
   VkQueue getPresentQueue() const { return m_presentQueue; }
 
+  /**
+   * @brief Check whether VK_EXT_memory_budget is enabled on the device
+   * @return true if heap budgets can be queried from the driver
+   */
+  bool isMemoryBudgetSupported() const { return m_memoryBudgetEnabled; }
+
+  /**
+   * @brief Check whether VK_KHR_timeline_semaphore is enabled on the device
+   * @return true if queues can be linked by timeline semaphores
+   */
+  bool isTimelineSemaphoreSupported() const {
+    return m_timelineSemaphoreEnabled;
+  }
+
+  /**
+   * @brief Check whether compute uses a different family than graphics
+   * @return true if resources shared by both need concurrent sharing
+   */
+  bool hasDedicatedComputeQueue() const {
+    return m_queueFamilies.computeFamily != m_queueFamilies.graphicsFamily;
+  }
+
   /**
    * @brief Create command pool for compute operations
    *
@@ -317,6 +339,16 @@ private:
    */
   bool checkDeviceExtensionSupport(VkPhysicalDevice device);
 
+  /**
+   * @brief Check if a device supports one optional extension
+   *
+   * @param device Physical device to check
+   * @param extensionName Extension to look for
+   * @return true if the extension is available
+   */
+  bool isDeviceExtensionAvailable(VkPhysicalDevice device,
+                                  const char *extensionName);
+
   /**
    * @brief Get required instance extensions
    *
@@ -371,6 +403,11 @@ private:
   // Queue family information
   QueueFamilyIndices m_queueFamilies; ///< Queue family indices
 
+  // Optional extensions, enabled when available
+  bool m_properties2Enabled = false;  ///< VK_KHR_get_physical_device_properties2
+  bool m_memoryBudgetEnabled = false; ///< VK_EXT_memory_budget
+  bool m_timelineSemaphoreEnabled = false; ///< VK_KHR_timeline_semaphore
+
   // Configuration
   const std::vector<const char *> m_validationLayers = {
       "VK_LAYER_KHRONOS_validation"};
@@ -399,6 +436,8 @@ private:
  *
  * 2. Queue Family Management:
  *    - Separate queues for graphics, compute, and presentation
+ *    - Compute prefers a family without graphics (async compute), then the
+ *      graphics family, then any compute family
  *    - Fallback to unified queue if separate queues unavailable
  *    - Future optimization: transfer queue for memory operations
  *
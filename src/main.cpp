@@ -16,12 +16,159 @@
  * @version Phase 1
  */
 
+#include <algorithm>
+#include <chrono>
+#include <csignal>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 // Our application framework
+#include "CpuFractalRenderer.h"
+#include "TileServer.h"
+#include "TileStore.h"
 #include "VulkanApplication.h"
 
+namespace {
+
+/**
+ * @brief Set by SIGINT/SIGTERM to stop the tile server
+ */
+volatile std::sig_atomic_t g_stopRequested = 0;
+
+void handleStopSignal(int) { g_stopRequested = 1; }
+
+/**
+ * @struct TileServeOptions
+ * @brief Command line options for headless tile serving
+ */
+struct TileServeOptions {
+  std::string packPath;
+  uint16_t port = 8765;
+  uint32_t tileSize = 256;
+  uint32_t capacity = 16384;
+  uint32_t maxIterations = 512;
+  uint32_t fractalType = 0;
+  float colorScale = 1.0f;
+};
+
+/**
+ * @brief Hash the parameters that tile pixels depend on (FNV-1a)
+ *
+ * Stored in the pack header so a pack rendered with other settings is
+ * rebuilt instead of served.
+ */
+uint64_t computeContentTag(const TileServeOptions &options) {
+  const uint32_t rendererVersion = 1;
+  uint32_t colorBits = 0;
+  std::memcpy(&colorBits, &options.colorScale, sizeof(colorBits));
+  const uint32_t fields[] = {rendererVersion, options.tileSize,
+                             options.maxIterations, options.fractalType,
+                             colorBits};
+
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (uint32_t field : fields) {
+    for (int i = 0; i < 4; i++) {
+      hash ^= (field >> (i * 8)) & 0xFF;
+      hash *= 0x100000001B3ULL;
+    }
+  }
+  return hash;
+}
+
+/**
+ * @brief Run the headless tile pyramid server until interrupted
+ *
+ * The pyramid root (level 0) covers the viewer's default view: a 4x4 square
+ * centered on (-0.5, 0).
+ *
+ * @param options Parsed tile serving options
+ * @return EXIT_SUCCESS on clean shutdown, EXIT_FAILURE on error
+ */
+int runTileServer(const TileServeOptions &options) {
+  auto renderer = std::make_shared<CpuFractalRenderer>(
+      options.maxIterations, options.colorScale, options.fractalType);
+  const uint32_t tileSize = options.tileSize;
+
+  auto renderTile = [renderer, tileSize](const TileKey &key,
+                                         uint32_t *pixels) {
+    const double rootMinX = -2.5;
+    const double rootMinY = -2.0;
+    const double rootSpan = 4.0;
+    double span = rootSpan / static_cast<double>(1u << key.level);
+    renderer->renderRegion(rootMinX + key.x * span, rootMinY + key.y * span,
+                           span, span, tileSize, tileSize, pixels);
+  };
+
+  auto tileStore = std::make_shared<TileStore>(
+      options.packPath, options.tileSize, options.capacity,
+      computeContentTag(options), renderTile);
+
+  TileServer server(tileStore, options.port,
+                    std::max(2u, std::thread::hardware_concurrency()));
+  if (!server.start()) {
+    return EXIT_FAILURE;
+  }
+
+  std::signal(SIGINT, handleStopSignal);
+  std::signal(SIGTERM, handleStopSignal);
+  while (!g_stopRequested) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
+  server.stop();
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parse tile serving options
+ *
+ * Usage: --serve-tiles <pack> [--port N] [--tile-size N] [--capacity N]
+ *        [--max-iterations N] [--fractal-type N] [--color-scale F]
+ *
+ * @return true if --serve-tiles was given and all options parsed
+ */
+bool parseTileServeOptions(int argc, char *argv[], TileServeOptions &options) {
+  bool serveTiles = false;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      if (arg == "--serve-tiles") {
+        throw std::invalid_argument("--serve-tiles requires a pack file path");
+      }
+      break;
+    }
+
+    std::string value = argv[i + 1];
+    if (arg == "--serve-tiles") {
+      options.packPath = value;
+      serveTiles = true;
+    } else if (arg == "--port") {
+      options.port = static_cast<uint16_t>(std::stoul(value));
+    } else if (arg == "--tile-size") {
+      options.tileSize = static_cast<uint32_t>(std::stoul(value));
+    } else if (arg == "--capacity") {
+      options.capacity = static_cast<uint32_t>(std::stoul(value));
+    } else if (arg == "--max-iterations") {
+      options.maxIterations = static_cast<uint32_t>(std::stoul(value));
+    } else if (arg == "--fractal-type") {
+      options.fractalType = static_cast<uint32_t>(std::stoul(value));
+    } else if (arg == "--color-scale") {
+      options.colorScale = std::stof(value);
+    } else {
+      continue;
+    }
+    i++;
+  }
+  return serveTiles;
+}
+
+} // namespace
+
 /**
  * @brief Application entry point
  *
@@ -48,11 +195,14 @@ int main(int argc, char *argv[]) {
   // Potential args: --width, --height, --fullscreen, --validation,
   // --fractal-type
 
-  // Silence unused parameter warnings for Phase 1
-  (void)argc;
-  (void)argv;
-
   try {
+    // Headless deep-zoom tile serving doesn't need a window or a GPU
+    TileServeOptions tileOptions;
+    if (parseTileServeOptions(argc, argv, tileOptions)) {
+      std::cout << "=== Fractal Tile Server ===" << std::endl;
+      return runTileServer(tileOptions);
+    }
+
     std::cout << "=== Vulkan Hybrid CPU-GPU Fractal Generator ===" << std::endl;
     std::cout << "Phase 1: Foundation Setup" << std::endl;
     std::cout << "Initializing Vulkan application..." << std::endl;